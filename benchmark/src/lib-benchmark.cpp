@@ -43,6 +43,7 @@
 #include "scheme/bgvrns/gen-cryptocontext-bgvrns.h"
 #include "gen-cryptocontext.h"
 #include "cryptocontext.h"
+#include "utils/numa.h"
 
 #include <fstream>
 #include <iostream>
@@ -186,11 +187,79 @@ using namespace lbcrypto;
     state.SetComplexityN(state.range(0));
 }
 
+/*
+ * Native NTT benchmarks comparing the scalar loops with the SIMD kernels
+ */
+
+[[maybe_unused]] static void RingBackendArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"ringdm", "backend"});
+    for (uint32_t r : {1024, 4096, 8192, 65536}) {
+        for (int backend : {intnat::SCALAR_NTT, intnat::AVX2_NTT, intnat::AVX512_NTT})
+            b->Args({r, backend});
+    }
+}
+
+[[maybe_unused]] static void NativeNTTInPlaceBackend(benchmark::State& state) {
+    uint32_t n   = state.range(0);
+    uint32_t m   = n << 1;
+    auto backend = static_cast<intnat::NTTBackend>(state.range(1));
+    if (!intnat::IsNTTBackendSupported(backend)) {
+        state.SkipWithError("NTT backend is not supported on this machine");
+        return;
+    }
+
+    NativeInteger modulusQ(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+    NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector x = dug.GenerateVector(n, modulusQ);
+
+    ChineseRemainderTransformFTT<NativeVector> crtFTT;
+    crtFTT.PreCompute(rootOfUnity, m, modulusQ);
+
+    auto defaultBackend = intnat::GetNTTBackend();
+    intnat::SetNTTBackend(backend);
+    for (auto _ : state)
+        crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &x);
+    intnat::SetNTTBackend(defaultBackend);
+
+    state.SetComplexityN(state.range(0));
+}
+
+[[maybe_unused]] static void NativeINTTInPlaceBackend(benchmark::State& state) {
+    uint32_t n   = state.range(0);
+    uint32_t m   = n << 1;
+    auto backend = static_cast<intnat::NTTBackend>(state.range(1));
+    if (!intnat::IsNTTBackendSupported(backend)) {
+        state.SkipWithError("NTT backend is not supported on this machine");
+        return;
+    }
+
+    NativeInteger modulusQ(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+    NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector x = dug.GenerateVector(n, modulusQ);
+
+    ChineseRemainderTransformFTT<NativeVector> crtFTT;
+    crtFTT.PreCompute(rootOfUnity, m, modulusQ);
+
+    auto defaultBackend = intnat::GetNTTBackend();
+    intnat::SetNTTBackend(backend);
+    for (auto _ : state)
+        crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &x);
+    intnat::SetNTTBackend(defaultBackend);
+
+    state.SetComplexityN(state.range(0));
+}
+
 // BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->RangeMultiplier(2)->Range(1<<10, 1<<16)->Complexity(benchmark::oAuto);
 BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);          // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeINTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);         // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeNTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);   // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeINTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);  // ->Complexity(benchmark::oAuto);
+BENCHMARK(NativeNTTInPlaceBackend)->Unit(benchmark::kMicrosecond)->Apply(RingBackendArgs);
+BENCHMARK(NativeINTTInPlaceBackend)->Unit(benchmark::kMicrosecond)->Apply(RingBackendArgs);
 
 /*
  * BFVrns benchmarks
@@ -739,6 +808,83 @@ void CKKSrns_EvalAtIndex(benchmark::State& state) {
 
 BENCHMARK(CKKSrns_EvalAtIndex)->Unit(benchmark::kMicrosecond);
 
+/*
+ * Sum of 8 rotations of one ciphertext computed with independent rotations (mode = 0), with a shared
+ * ModUp (mode = 1, EvalRotateMany) and with a shared ModUp and a single ModDown (mode = 2, EvalRotateManyExt)
+ */
+void CKKSrns_EvalRotateSum(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(4);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+
+    std::vector<int32_t> indexList{1, 2, 3, 4, 5, 6, 7, 8};
+    cc->EvalAtIndexKeyGen(keyPair.secretKey, indexList);
+
+    usint slots = cc->GetEncodingParams()->GetBatchSize();
+    std::vector<std::complex<double>> vectorOfInts(slots);
+    for (usint i = 0; i < slots; i++) {
+        vectorOfInts[i] = 1.001 * i;
+    }
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(vectorOfInts));
+
+    while (state.KeepRunning()) {
+        Ciphertext<DCRTPoly> ciphertextSum;
+        if (state.range(0) == 0) {
+            ciphertextSum = cc->EvalAtIndex(ciphertext, indexList[0]);
+            for (size_t i = 1; i < indexList.size(); i++)
+                cc->EvalAddInPlace(ciphertextSum, cc->EvalAtIndex(ciphertext, indexList[i]));
+        }
+        else if (state.range(0) == 1) {
+            auto rotations = cc->EvalRotateMany(ciphertext, indexList);
+            ciphertextSum  = cc->EvalAddMany(rotations);
+        }
+        else {
+            auto rotations = cc->EvalRotateManyExt(ciphertext, indexList);
+            for (size_t i = 1; i < rotations.size(); i++)
+                cc->EvalAddExtInPlace(rotations[0], rotations[i]);
+            ciphertextSum = cc->KeySwitchDown(rotations[0]);
+        }
+    }
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+}
+
+BENCHMARK(CKKSrns_EvalRotateSum)->Unit(benchmark::kMicrosecond)->ArgName("mode")->DenseRange(0, 2);
+
+/*
+ * Rotation of a deep ciphertext with the rotation key first-touched by the thread running the key generation
+ * (numa = 0) or interleaved over the NUMA nodes with the threads bound to the nodes (numa = 1). On a multi-socket
+ * machine the difference is the cross-socket penalty of the key-switching memory traffic.
+ */
+[[maybe_unused]] static void NumaArgs(benchmark::internal::Benchmark* b) {
+    for (uint32_t numa : {0, 1})
+        b->ArgNames({"numa", "nodes"})->Args({numa, NumaTopology::GetInstance().GetNumNodes()});
+}
+
+void CKKSrns_EvalAtIndexNuma(benchmark::State& state) {
+    OpenFHEParallelControls.SetNumaMode(state.range(0) != 0);
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext(12);
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalAtIndexKeyGen(keyPair.secretKey, {1});
+
+    usint slots = cc->GetEncodingParams()->GetBatchSize();
+    std::vector<std::complex<double>> vectorOfInts(slots);
+    for (usint i = 0; i < slots; i++) {
+        vectorOfInts[i] = 1.001 * i;
+    }
+    auto ciphertext = cc->Encrypt(keyPair.publicKey, cc->MakeCKKSPackedPlaintext(vectorOfInts));
+
+    while (state.KeepRunning()) {
+        auto ciphertextRot = cc->EvalAtIndex(ciphertext, 1);
+    }
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+    OpenFHEParallelControls.SetNumaMode(false);
+}
+
+BENCHMARK(CKKSrns_EvalAtIndexNuma)->Unit(benchmark::kMicrosecond)->Apply(NumaArgs);
+
 /*
  * BGVrns benchmarks
  * */
@@ -60,6 +60,13 @@ static void DCRTArguments(benchmark::internal::Benchmark* b) {
     }
 }
 
+static void DCRTLayoutArguments(benchmark::internal::Benchmark* b) {
+    for (uint32_t t : tow_args) {
+        for (int64_t layout : {SEPARATE_TOWERS, CONTIGUOUS_TOWERS})
+            b->ArgNames({"towers", "layout"})->Args({t, layout});
+    }
+}
+
 static void GeneratePolys(uint32_t order, uint32_t bits, std::shared_ptr<std::vector<NativePoly>>& polyArrayEval,
                           std::shared_ptr<std::vector<NativePoly>>& polyArrayCoef) {
     auto p    = std::make_shared<ILNativeParams>(order, bits);
@@ -259,6 +266,68 @@ static void GenerateDCRTPolys(uint32_t order, uint32_t bits,
     }
 }
 
+// switches the format of two polynomials (e.g., the two elements of a ciphertext) in one fused call
+[[maybe_unused]] static void DCRT_ntt_batch(benchmark::State& state) {
+    std::shared_ptr<std::vector<DCRTPoly>> polys = DCRTpolysCoef[state.range(0)];
+    DCRTPoly p0, p1;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        p0 = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        p1 = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        DCRTPoly::SwitchFormat({&p0, &p1});
+    }
+}
+
+[[maybe_unused]] static void DCRT_intt_batch(benchmark::State& state) {
+    std::shared_ptr<std::vector<DCRTPoly>> polys = DCRTpolysEval[state.range(0)];
+    DCRTPoly p0, p1;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        p0 = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        p1 = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        DCRTPoly::SwitchFormat({&p0, &p1});
+    }
+}
+
+// fast base conversion into a basis of the same size; the conversion constants do not affect the cost
+[[maybe_unused]] static void DCRT_ApproxSwitchCRTBasis(benchmark::State& state) {
+    std::shared_ptr<std::vector<DCRTPoly>> polys = DCRTpolysCoef[state.range(0)];
+    const auto& paramsQ = (*polys)[0].GetParams();
+    const uint32_t sizeQ{static_cast<uint32_t>(paramsQ->GetParams().size())};
+    auto paramsP = std::make_shared<ILDCRTParams<BigInteger>>(paramsQ->GetCyclotomicOrder(), sizeQ,
+                                                              paramsQ->GetParams()[0]->GetModulus().GetMSB() - 1);
+    std::vector<NativeInteger> QHatInvModq(sizeQ), QHatInvModqPrecon(sizeQ);
+    std::vector<std::vector<NativeInteger>> QHatModp(sizeQ);
+    std::vector<DoubleNativeInt> modpBarrettMu(sizeQ);
+    const BigInteger barrettBase128Bit(BigInteger(1) << 128);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        const auto& qi       = paramsQ->GetParams()[i]->GetModulus();
+        const auto& pi       = paramsP->GetParams()[i]->GetModulus();
+        QHatInvModq[i]       = qi - NativeInteger(1);
+        QHatInvModqPrecon[i] = QHatInvModq[i].PrepModMulConst(qi);
+        QHatModp[i].assign(sizeQ, pi - NativeInteger(1));
+        modpBarrettMu[i] = (barrettBase128Bit / BigInteger(pi)).ConvertToInt<DoubleNativeInt>();
+    }
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        DCRTPoly ans((*polys)[(i = (i + 1) & POLY_NUM_M1)].ApproxSwitchCRTBasis(
+            paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu));
+        benchmark::DoNotOptimize(ans);
+    }
+}
+
+// copies a polynomial with the towers stored separately (0) or in one contiguous buffer (1)
+[[maybe_unused]] static void DCRT_Clone(benchmark::State& state) {
+    std::shared_ptr<std::vector<DCRTPoly>> polys = DCRTpolysEval[state.range(0)];
+    DCRTPoly::SetTowerLayout(static_cast<TowerLayout>(state.range(1)));
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        DCRTPoly copy((*polys)[(i = (i + 1) & POLY_NUM_M1)].Clone());
+        benchmark::DoNotOptimize(copy);
+    }
+    DCRTPoly::SetTowerLayout(SEPARATE_TOWERS);
+}
+
 [[maybe_unused]] static void Native_ntt_intt(benchmark::State& state) {
     std::shared_ptr<std::vector<NativePoly>> polys = NativepolysCoef;
     NativePoly* p;
@@ -386,6 +455,10 @@ BENCHMARK(Native_ntt)->Unit(benchmark::kMicrosecond);
 BENCHMARK(DCRT_ntt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 BENCHMARK(Native_intt)->Unit(benchmark::kMicrosecond);
 BENCHMARK(DCRT_intt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
+BENCHMARK(DCRT_ntt_batch)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
+BENCHMARK(DCRT_intt_batch)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
+BENCHMARK(DCRT_Clone)->Unit(benchmark::kMicrosecond)->Apply(DCRTLayoutArguments);
+BENCHMARK(DCRT_ApproxSwitchCRTBasis)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 // BENCHMARK(Native_ntt_intt)->Unit(benchmark::kMicrosecond);
 // BENCHMARK(DCRT_ntt_intt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 // BENCHMARK(Native_intt_ntt)->Unit(benchmark::kMicrosecond);
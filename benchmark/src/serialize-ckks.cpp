@@ -42,13 +42,17 @@
 #include <fstream>
 #include <limits>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <random>
+#include <sstream>
 
 #include "cryptocontext-ser.h"
 #include "ciphertext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 #include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
 #include "gen-cryptocontext.h"
+#include "wire-ser.h"
 
 using namespace lbcrypto;
 
@@ -121,4 +125,80 @@ void CKKS_serialize(benchmark::State& state) {
 
 BENCHMARK(CKKS_serialize)->Unit(benchmark::kMicrosecond)->MinTime(10.0);
 
+/*
+ * Ciphertext round trips through cereal and through the native wire format, the latter copying the towers out of
+ * the buffer or placing the ciphertext in it
+ */
+
+static Ciphertext<DCRTPoly> GenerateWireCiphertext(CryptoContext<DCRTPoly>& cc) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetRingDim(1 << 13);
+    parameters.SetMultiplicativeDepth(10);
+    parameters.SetScalingModSize(50);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+
+    KeyPair<DCRTPoly> kp                   = cc->KeyGen();
+    std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+    return cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vals));
+}
+
+void CKKS_CiphertextCereal(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc;
+    Ciphertext<DCRTPoly> ciphertext = GenerateWireCiphertext(cc);
+
+    Ciphertext<DCRTPoly> newC;
+    size_t bytes = 0;
+    while (state.KeepRunning()) {
+        std::stringstream s;
+        Serial::Serialize(ciphertext, s, SerType::BINARY);
+        bytes = s.str().size();
+        Serial::Deserialize(newC, s, SerType::BINARY);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(CKKS_CiphertextCereal)->Unit(benchmark::kMicrosecond);
+
+void CKKS_CiphertextWire(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc;
+    Ciphertext<DCRTPoly> ciphertext = GenerateWireCiphertext(cc);
+
+    Ciphertext<DCRTPoly> newC;
+    size_t bytes = 0;
+    while (state.KeepRunning()) {
+        std::stringstream s;
+        Wire::Serialize(ciphertext, s);
+        std::string buffer = s.str();
+        bytes              = buffer.size();
+        Wire::DeserializeFromBuffer(newC, Wire::ByteSpan{&buffer[0], buffer.size()}, cc);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(CKKS_CiphertextWire)->Unit(benchmark::kMicrosecond);
+
+void CKKS_CiphertextWireInPlace(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc;
+    Ciphertext<DCRTPoly> ciphertext = GenerateWireCiphertext(cc);
+
+    // an aligned buffer the ciphertext is serialized to and deserialized from in place
+    const size_t bytes = Wire::GetSerializedSize(ciphertext);
+    std::shared_ptr<char> storage(static_cast<char*>(::operator new(bytes, std::align_val_t{Wire::WIRE_ALIGNMENT})),
+                                  [](char* p) { ::operator delete(p, std::align_val_t{Wire::WIRE_ALIGNMENT}); });
+    const Wire::ByteSpan buffer{storage.get(), bytes};
+
+    Ciphertext<DCRTPoly> newC;
+    while (state.KeepRunning()) {
+        Wire::SerializeToBuffer(ciphertext, buffer);
+        Wire::DeserializeFromBuffer(newC, buffer, cc, storage);
+        newC.reset();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(CKKS_CiphertextWireInPlace)->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
@@ -42,15 +42,25 @@ namespace lbcrypto {
  * @brief Lists all modes for RLWE schemes, such as BGV and BFV, and for LWE schemes, such as DM and TFHE
  */
 enum SecretKeyDist {
-    GAUSSIAN        = 0,
-    UNIFORM_TERNARY = 1,  // Default value, all schemes support this key distribution
-    SPARSE_TERNARY  = 2,
-    // BINARY = 3, // Future implementation
+    GAUSSIAN            = 0,
+    UNIFORM_TERNARY     = 1,  // Default value, all schemes support this key distribution
+    SPARSE_TERNARY      = 2,
+    // uniform ternary secret key; CKKS bootstrapping switches to an ephemeral sparse secret for the modulus raising
+    SPARSE_ENCAPSULATED = 3,
+    // BINARY = 4, // Future implementation
 };
 SecretKeyDist convertToSecretKeyDist(const std::string& str);
 SecretKeyDist convertToSecretKeyDist(uint32_t num);
 std::ostream& operator<<(std::ostream& s, SecretKeyDist m);
 
+/**
+ * @brief Storage layouts of the towers of a DCRTPoly
+ */
+enum TowerLayout {
+    SEPARATE_TOWERS   = 0,  // Default value, every tower owns its own allocation
+    CONTIGUOUS_TOWERS = 1,  // all towers share one aligned, tower-major buffer
+};
+
 }  // namespace lbcrypto
 
 #endif  // _CONSTANTS_LATTICE_H_
@@ -48,6 +48,8 @@
 #include "utils/utilities-int.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <ostream>
 #include <memory>
 #include <string>
@@ -228,13 +230,106 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::CloneWithNoise(const DiscreteGaussi
 template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::CloneTowers(uint32_t startTower, uint32_t endTower) const {
     auto cycorder = m_params->GetCyclotomicOrder();
-    auto params   = std::make_shared<Params>(cycorder, m_params->GetParamPartition(startTower, endTower));
-    auto res      = DCRTPolyImpl(params, Format::EVALUATION, false);
-    for (uint32_t i = startTower; i <= endTower; i++)
-        res.SetElementAtIndex(i - startTower, this->GetElementAtIndex(i));
+    DCRTPolyImpl res;
+    res.m_params = std::make_shared<Params>(cycorder, m_params->GetParamPartition(startTower, endTower));
+    res.m_format = Format::EVALUATION;
+    if (GetTowerLayout() == CONTIGUOUS_TOWERS) {
+        res.CopyTowersContiguous(m_vectors, startTower, endTower - startTower + 1);
+    }
+    else {
+        res.m_vectors.assign(m_vectors.begin() + startTower, m_vectors.begin() + endTower + 1);
+    }
     return res;
 }
 
+template <typename VecType>
+std::atomic<TowerLayout>& TowerLayoutSetting() {
+    static std::atomic<TowerLayout> layout{SEPARATE_TOWERS};
+    return layout;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::SetTowerLayout(TowerLayout layout) {
+    TowerLayoutSetting<VecType>().store(layout, std::memory_order_relaxed);
+}
+
+template <typename VecType>
+TowerLayout DCRTPolyImpl<VecType>::GetTowerLayout() {
+    return TowerLayoutSetting<VecType>().load(std::memory_order_relaxed);
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::AllocateTowersContiguous(bool initializeElementToZero) {
+    const auto& params{m_params->GetParams()};
+    const size_t size{params.size()};
+    m_vectors.clear();
+    m_vectors.reserve(size);
+    if (size == 0)
+        return;
+    const usint n{m_params->GetRingDimension()};
+    auto buffer{intnat::TowerBuffer::Create(size, n * sizeof(NativeInteger), initializeElementToZero)};
+    for (size_t i = 0; i < size; ++i) {
+        NativeVector values(n, params[i]->GetModulus(), intnat::NativeVectorAllocator<NativeInteger>(buffer, i));
+        m_vectors.emplace_back(params[i], m_format, std::move(values));
+    }
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::CopyTowersContiguous(const std::vector<PolyType>& towers, size_t start, size_t count) {
+    m_vectors.clear();
+    m_vectors.reserve(count);
+    size_t towerBytes{0};
+    for (size_t i = start; i < start + count; ++i) {
+        if (!towers[i].IsEmpty())
+            towerBytes = std::max(towerBytes, towers[i].GetLength() * sizeof(NativeInteger));
+    }
+    if (towerBytes == 0) {
+        m_vectors.assign(towers.begin() + start, towers.begin() + start + count);
+        return;
+    }
+
+    // towers that fill consecutive slots of one TowerBuffer are copied with a single memcpy into the new buffer,
+    // whose vectors then take the copied values; other towers are copied one by one
+    const intnat::TowerBuffer* source{nullptr};
+    size_t sourceTower{0};
+    bool consecutive{true};
+    for (size_t i = 0; consecutive && i < count; ++i) {
+        const auto& tower{towers[start + i]};
+        const auto* slot{tower.IsEmpty() ? nullptr : tower.GetValues().GetAllocator().GetSlot()};
+        if (i == 0 && slot) {
+            source      = slot->buffer;
+            sourceTower = source->GetTower(slot);
+        }
+        consecutive = slot && slot->buffer == source && source->GetTower(slot) == sourceTower + i &&
+                      tower.GetLength() * sizeof(NativeInteger) == towerBytes &&
+                      source->GetTowerStride() == intnat::TowerBuffer::GetStride(towerBytes) &&
+                      source->IsPlacedInSlot(slot, &tower.GetValues()[0]);
+    }
+
+    auto buffer{intnat::TowerBuffer::Create(count, towerBytes, !consecutive)};
+    if (consecutive) {
+        const size_t bytes{(count - 1) * buffer->GetTowerStride() + towerBytes};
+        std::memcpy(buffer->GetData(), &towers[start].GetValues()[0], bytes);
+        for (size_t i = 0; i < count; ++i) {
+            const auto& tower{towers[start + i]};
+            OPENFHE_MEMSTATS_VECTOR_COPY(towerBytes);
+            NativeVector values(tower.GetLength(), tower.GetValues().GetModulus(),
+                                intnat::NativeVectorAllocator<NativeInteger>(buffer, i));
+            m_vectors.emplace_back(tower.GetParams(), tower.GetFormat(), std::move(values));
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const auto& tower{towers[start + i]};
+        if (tower.IsEmpty()) {
+            m_vectors.push_back(tower);
+            continue;
+        }
+        NativeVector values(tower.GetValues(), intnat::NativeVectorAllocator<NativeInteger>(buffer, i));
+        m_vectors.emplace_back(tower.GetParams(), tower.GetFormat(), std::move(values));
+    }
+}
+
 template <typename VecType>
 std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::BaseDecompose(usint baseBits, bool evalModeAnswer) const {
     auto bdV(CRTInterpolate().BaseDecompose(baseBits, false));
@@ -259,8 +354,7 @@ std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::CRTDecompose(uint32_t
     if (baseBits == 0) {
         std::vector<DCRTPolyType> result(size, *eval);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i) {
+        OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
             for (size_t k = 0; k < size; ++k) {
                 if (i != k) {
                     DCRTPolyImpl::PolyType tmp((*coef).m_vectors[i]);
@@ -269,7 +363,7 @@ std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::CRTDecompose(uint32_t
                     result[i].m_vectors[k] = std::move(tmp);
                 }
             }
-        }
+        });
         return result;
     }
 
@@ -287,8 +381,7 @@ std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::CRTDecompose(uint32_t
     }
     std::vector<DCRTPolyType> result(nWindows);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i) {
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         auto decomposed = (*coef).m_vectors[i].BaseDecompose(baseBits, false);
         for (size_t j = 0; j < decomposed.size(); ++j) {
             DCRTPolyImpl<VecType> currentDCRTPoly(*coef);
@@ -301,7 +394,7 @@ std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::CRTDecompose(uint32_t
             currentDCRTPoly.SwitchFormat();
             result[j + arrWindows[i]] = std::move(currentDCRTPoly);
         }
-    }
+    });
     return result;
 }
 
@@ -369,9 +462,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Negate() const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Negate();
+    });
     return tmp;
 }
 
@@ -384,20 +477,41 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const DCRTPolyImpl& rhs) const {
     if (m_vectors.size() != rhs.m_vectors.size())
         OPENFHE_THROW("tower size mismatch; cannot subtract");
-    DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        tmp.m_vectors[i] = m_vectors[i].Minus(rhs.m_vectors[i]);
+    if (!UseCoefficientBlocks()) {
+        DCRTPolyImpl<VecType> tmp(m_params, m_format);
+        OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+            tmp.m_vectors[i] = m_vectors[i].Minus(rhs.m_vectors[i]);
+        });
+        return tmp;
+    }
+    CheckBlockOperands(rhs, "Minus");
+    DCRTPolyImpl<VecType> tmp(m_params, m_format, true);
+    uint32_t ringDim{m_params->GetRingDimension()};
+    OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+        const auto& q{m_vectors[i].GetModulus()};
+        for (size_t k = first; k < last; ++k)
+            tmp.m_vectors[i][k] = m_vectors[i][k].ModSubFast(rhs.m_vectors[i][k], q);
+    });
     return tmp;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator+=(const DCRTPolyImpl& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] += rhs.m_vectors[i];
+    if (!UseCoefficientBlocks()) {
+        OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+            m_vectors[i] += rhs.m_vectors[i];
+        });
+        return *this;
+    }
+    CheckBlockOperands(rhs, "operator+=");
+    uint32_t ringDim{m_params->GetRingDimension()};
+    OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+        const auto& q{m_vectors[i].GetModulus()};
+        for (size_t k = first; k < last; ++k)
+            m_vectors[i][k].ModAddFastEq(rhs.m_vectors[i][k], q);
+    });
     return *this;
 }
 
@@ -405,46 +519,69 @@ template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator+=(const Integer& rhs) {
     NativeInteger val{rhs};
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i] += val;
+    });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator+=(const NativeInteger& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i] += rhs;
+    });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator-=(const DCRTPolyImpl& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i] -= rhs.m_vectors[i];
+    if (!UseCoefficientBlocks()) {
+        OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+            m_vectors[i] -= rhs.m_vectors[i];
+        });
+        return *this;
+    }
+    CheckBlockOperands(rhs, "operator-=");
+    uint32_t ringDim{m_params->GetRingDimension()};
+    OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+        const auto& q{m_vectors[i].GetModulus()};
+        for (size_t k = first; k < last; ++k)
+            m_vectors[i][k].ModSubFastEq(rhs.m_vectors[i][k], q);
+    });
     return *this;
 }
 
+template <typename VecType>
+void DCRTPolyImpl<VecType>::CheckBlockOperands(const DCRTPolyImpl& rhs, const char* op) const {
+    size_t size{m_vectors.size()};
+    if (size > rhs.m_vectors.size())
+        OPENFHE_THROW(std::string(op) + ": tower size mismatch");
+    uint32_t ringDim{m_params->GetRingDimension()};
+    for (size_t i = 0; i < size; ++i) {
+        if (m_vectors[i].GetLength() != ringDim || rhs.m_vectors[i].GetLength() != ringDim ||
+            m_vectors[i].GetModulus() != rhs.m_vectors[i].GetModulus())
+            OPENFHE_THROW(std::string(op) + " called on towers with different parameters.");
+    }
+}
+
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator-=(const Integer& rhs) {
     NativeInteger val{rhs};
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i] -= val;
+    });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator-=(const NativeInteger& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i] -= rhs;
+    });
     return *this;
 }
 
@@ -532,9 +669,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(const Integer& rhs) const {
     NativeInteger val{rhs};
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Plus(val);
+    });
     return tmp;
 }
 
@@ -542,9 +679,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(const std::vector<Integer>& crtElement) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Plus(NativeInteger(crtElement[i]));
+    });
     return tmp;
 }
 
@@ -553,9 +690,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const Integer& rhs) const {
     NativeInteger val{rhs};
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Minus(val);
+    });
     return tmp;
 }
 
@@ -563,9 +700,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const std::vector<Integer>& crtElement) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Minus(NativeInteger(crtElement[i]));
+    });
     return tmp;
 }
 
@@ -574,9 +711,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(const Integer& rhs) const {
     NativeInteger val{rhs};
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(val);
+    });
     return tmp;
 }
 
@@ -584,9 +721,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(NativeInteger::SignedNativeInt rhs) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(rhs);
+    });
     return tmp;
 }
 
@@ -594,9 +731,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(const std::vector<Integer>& crtElement) const {
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(NativeInteger(crtElement[i]));
+    });
     return tmp;
 }
 
@@ -606,9 +743,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(const std::vector<NativeInteg
         OPENFHE_THROW("tower size mismatch; cannot multiply");
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(rhs[i]);
+    });
     return tmp;
 }
 
@@ -616,9 +753,9 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::TimesNoCheck(const std::vector<NativeInteger>& rhs) const {
     size_t vecSize = m_vectors.size() < rhs.size() ? m_vectors.size() : rhs.size();
     DCRTPolyImpl<VecType> tmp(m_params, m_format);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(vecSize))
-    for (size_t i = 0; i < vecSize; ++i)
+    OpenFHEParallelControls.ParallelFor(0, vecSize, [&](size_t i) {
         tmp.m_vectors[i] = m_vectors[i].Times(rhs[i]);
+    });
     return tmp;
 }
 
@@ -626,18 +763,18 @@ template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator*=(const Integer& rhs) {
     NativeInteger val{rhs};
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i] *= val;
+    });
     return *this;
 }
 
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator*=(const NativeInteger& rhs) {
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i] *= rhs;
+    });
     return *this;
 }
 
@@ -673,9 +810,9 @@ void DCRTPolyImpl<VecType>::AddILElementOne() {
     if (m_format != Format::EVALUATION)
         OPENFHE_THROW(std::string(__func__) + ": only available in COEFFICIENT format.");
     size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         m_vectors[i].AddILElementOne();
+    });
 }
 
 template <typename VecType>
@@ -719,17 +856,62 @@ void DCRTPolyImpl<VecType>::DropLastElementAndScale(const std::vector<NativeInte
     this->DropLastElement();
     size_t size{m_vectors.size()};
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i) {
-        auto tmp = lastPoly;
-        tmp.SwitchModulus(m_vectors[i].GetModulus(), m_vectors[i].GetRootOfUnity(), 0, 0);
-        tmp *= QlQlInvModqlDivqlModq[i];
-        if (m_format == Format::EVALUATION)
-            tmp.SwitchFormat();
-        m_vectors[i] *= qlInvModq[i];
-        m_vectors[i] += tmp;
-        if (m_format == Format::COEFFICIENT)
-            m_vectors[i].SwitchFormat();
+    if (!UseCoefficientBlocks()) {
+        OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+            auto tmp = lastPoly;
+            tmp.SwitchModulus(m_vectors[i].GetModulus(), m_vectors[i].GetRootOfUnity(), 0, 0);
+            tmp *= QlQlInvModqlDivqlModq[i];
+            if (m_format == Format::EVALUATION)
+                tmp.SwitchFormat();
+            m_vectors[i] *= qlInvModq[i];
+            m_vectors[i] += tmp;
+            if (m_format == Format::COEFFICIENT)
+                m_vectors[i].SwitchFormat();
+        });
+        return;
+    }
+
+    // fewer towers than threads: the same steps as above, with the coefficient-wise ones run on blocks of
+    // coefficients and the NTTs batched over all towers (the batched transform tiles each tower itself)
+    uint32_t ringDim{m_params->GetRingDimension()};
+    const auto ql{lastPoly.GetModulus().ConvertToInt()};
+    const auto halfql{ql >> 1};
+    std::vector<PolyType> scaled(size);
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+        scaled[i] = PolyType(m_vectors[i].GetParams(), Format::COEFFICIENT, true);
+    });
+    OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+        // centered lift of the dropped tower from ql to qi (NativeVector::SwitchModulus), times QlQlInvModqlDivqlModq
+        const auto& qi{m_vectors[i].GetModulus()};
+        const auto q{qi.ConvertToInt()};
+        const auto mu{qi.ComputeMu()};
+        const auto diff{q > ql ? q - ql : q - (ql % q)};
+        for (size_t k = first; k < last; ++k) {
+            auto v{lastPoly[k].ConvertToInt()};
+            if (v > halfql)
+                v += diff;
+            if (v >= q)
+                v %= q;
+            scaled[i][k] = NativeInteger(v).ModMulFast(QlQlInvModqlDivqlModq[i], qi, mu);
+        }
+    });
+    std::vector<PolyType*> towers;
+    towers.reserve(size);
+    if (m_format == Format::EVALUATION) {
+        for (auto& v : scaled)
+            towers.push_back(&v);
+        PolyType::SwitchFormat(towers);
+    }
+    OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+        const auto& qi{m_vectors[i].GetModulus()};
+        const auto mu{qi.ComputeMu()};
+        for (size_t k = first; k < last; ++k)
+            m_vectors[i][k].ModMulFastEq(qlInvModq[i], qi, mu).ModAddFastEq(scaled[i][k], qi);
+    });
+    if (m_format == Format::COEFFICIENT) {
+        for (auto& v : m_vectors)
+            towers.push_back(&v);
+        PolyType::SwitchFormat(towers);
     }
 }
 
@@ -765,15 +947,14 @@ void DCRTPolyImpl<VecType>::ModReduce(const NativeInteger& t, const std::vector<
     this->DropLastElement();
     size_t size{m_vectors.size()};
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i) {
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         auto tmp{delta};
         tmp.SwitchModulus(m_vectors[i].GetModulus(), m_vectors[i].GetRootOfUnity(), 0, 0);
         if (m_format == Format::EVALUATION)
             tmp.SwitchFormat();
         m_vectors[i] += (tmp *= t);
         m_vectors[i] *= qlInvModq[i];
-    }
+    });
 }
 
 /*
@@ -894,8 +1075,7 @@ void DCRTPolyImpl<VecType>::TimesQovert(const std::shared_ptr<Params>& paramsQ,
         OPENFHE_THROW("Sizes of vectors do not match.");
     uint32_t size(m_vectors.size());
     uint32_t ringDim(m_params->GetRingDimension());
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i) {
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
         auto q{m_vectors[i].GetModulus()};
         auto mu{q.ComputeMu()};
         for (uint32_t ri = 0; ri < ringDim; ++ri) {
@@ -903,7 +1083,20 @@ void DCRTPolyImpl<VecType>::TimesQovert(const std::shared_ptr<Params>& paramsQ,
             xi.ModMulFastConstEq(NegQModt, t, NegQModtPrecon);
             xi.ModMulFastEq(tInvModq[i], q, mu);
         }
+    });
+}
+
+template <typename VecType>
+std::vector<uint64_t> DCRTPolyImpl<VecType>::TransposeCRTTable(
+    const std::vector<std::vector<NativeInteger>>& QHatModp) {
+    const size_t sizeQ{QHatModp.size()};
+    const size_t sizeP{sizeQ > 0 ? QHatModp[0].size() : 0};
+    std::vector<uint64_t> QHatModpT(sizeP * sizeQ);
+    for (size_t i = 0; i < sizeQ; ++i) {
+        for (size_t j = 0; j < sizeP; ++j)
+            QHatModpT[j * sizeQ + i] = QHatModp[i][j].ConvertToInt<uint64_t>();
     }
+    return QHatModpT;
 }
 
 template <typename VecType>
@@ -911,27 +1104,81 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
     const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
     const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    const auto QHatModpT{TransposeCRTTable(QHatModp)};
+#else
+    const std::vector<uint64_t> QHatModpT;
+#endif
+    return ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, QHatModpT, modpBarrettMu);
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
+    const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+    const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
+    const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<uint64_t>& QHatModpT,
+    const std::vector<DoubleNativeInt>& modpBarrettMu) const {
     DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
     uint32_t sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
     uint32_t sizeP = ans.m_vectors.size();
 #if defined(HAVE_INT128) && NATIVEINT == 64
-    uint32_t ringDim = m_params->GetRingDimension();
-    std::vector<DoubleNativeInt> sum(sizeP);
-    #pragma omp parallel for firstprivate(sum) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
-    for (uint32_t ri = 0; ri < ringDim; ++ri) {
-        std::fill(sum.begin(), sum.end(), 0);
-        for (uint32_t i = 0; i < sizeQ; ++i) {
-            const auto& qi        = m_vectors[i].GetModulus();
-            const auto& xi        = m_vectors[i][ri];
-            const auto& QHatModpi = QHatModp[i];
-            const auto xQHatInvModqi =
-                xi.ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]).template ConvertToInt<uint64_t>();
-            for (uint32_t j = 0; j < sizeP; ++j)
-                sum[j] += Mul128(xQHatInvModqi, QHatModpi[j].ConvertToInt<uint64_t>());
-        }
-        for (uint32_t j = 0; j < sizeP; ++j) {
-            const auto& pj       = ans.m_vectors[j].GetModulus();
-            ans.m_vectors[j][ri] = BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), modpBarrettMu[j]);
+    // The conversion is blocked over tiles of CRT_BASIS_TILE coefficients: the scaled source residues of a tile
+    // stay in L1 while every target modulus is produced from them, and each target coefficient is accumulated in
+    // a 128-bit register and reduced only once.
+    constexpr uint32_t CRT_BASIS_TILE{64};
+    const uint32_t ringDim{m_params->GetRingDimension()};
+    const uint32_t numTiles{(ringDim + CRT_BASIS_TILE - 1) / CRT_BASIS_TILE};
+
+    // QHatModp is read transposed so that the inner loop over the source moduli streams through a contiguous row
+    const size_t rowT{QHatModp.size()};
+    if (QHatModpT.size() < sizeP * rowT)
+        OPENFHE_THROW("The transposed table of [Q/q_i]_{p_j} does not match QHatModp");
+    std::vector<uint64_t> moduliP(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j)
+        moduliP[j] = ans.m_vectors[j].GetModulus().template ConvertToInt<uint64_t>();
+
+    #pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(numTiles))
+    {
+        std::vector<uint64_t> xQHatInvModq(sizeQ * CRT_BASIS_TILE);
+    #pragma omp for
+        for (uint32_t b = 0; b < numTiles; ++b) {
+            const uint32_t k0{b * CRT_BASIS_TILE};
+            const uint32_t len{std::min(CRT_BASIS_TILE, ringDim - k0)};
+            for (uint32_t i = 0; i < sizeQ; ++i) {
+                const auto& qi = m_vectors[i].GetModulus();
+                const auto& xi = m_vectors[i];
+                auto* yi       = &xQHatInvModq[i * CRT_BASIS_TILE];
+                for (uint32_t k = 0; k < len; ++k) {
+                    yi[k] = xi[k0 + k]
+                                .ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i])
+                                .template ConvertToInt<uint64_t>();
+                }
+            }
+            for (uint32_t j = 0; j < sizeP; ++j) {
+                const uint64_t* QHatModpj = &QHatModpT[j * rowT];
+                auto& ansj                = ans.m_vectors[j];
+                uint32_t k                = 0;
+                for (; k + 4 <= len; k += 4) {
+                    DoubleNativeInt sum0{0}, sum1{0}, sum2{0}, sum3{0};
+                    for (uint32_t i = 0; i < sizeQ; ++i) {
+                        const uint64_t* yi = &xQHatInvModq[i * CRT_BASIS_TILE + k];
+                        sum0 += Mul128(yi[0], QHatModpj[i]);
+                        sum1 += Mul128(yi[1], QHatModpj[i]);
+                        sum2 += Mul128(yi[2], QHatModpj[i]);
+                        sum3 += Mul128(yi[3], QHatModpj[i]);
+                    }
+                    ansj[k0 + k]     = BarrettUint128ModUint64(sum0, moduliP[j], modpBarrettMu[j]);
+                    ansj[k0 + k + 1] = BarrettUint128ModUint64(sum1, moduliP[j], modpBarrettMu[j]);
+                    ansj[k0 + k + 2] = BarrettUint128ModUint64(sum2, moduliP[j], modpBarrettMu[j]);
+                    ansj[k0 + k + 3] = BarrettUint128ModUint64(sum3, moduliP[j], modpBarrettMu[j]);
+                }
+                for (; k < len; ++k) {
+                    DoubleNativeInt sum{0};
+                    for (uint32_t i = 0; i < sizeQ; ++i)
+                        sum += Mul128(xQHatInvModq[i * CRT_BASIS_TILE + k], QHatModpj[i]);
+                    ansj[k0 + k] = BarrettUint128ModUint64(sum, moduliP[j], modpBarrettMu[j]);
+                }
+            }
         }
     }
 #else
@@ -971,9 +1218,9 @@ void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ,
     m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
                      std::make_move_iterator(partP.m_vectors.end()));
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
+    OpenFHEParallelControls.ParallelFor(0, sizeQP, [&](size_t i) {
         m_vectors[i].SetFormat(Format::EVALUATION);
+    });
     m_format = Format::EVALUATION;
     m_params = paramsQP;
 }
@@ -986,37 +1233,66 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
     const std::vector<std::vector<NativeInteger>>& PHatModq, const std::vector<DoubleNativeInt>& modqBarrettMu,
     const std::vector<NativeInteger>& tInvModp, const std::vector<NativeInteger>& tInvModpPrecon,
     const NativeInteger& t, const std::vector<NativeInteger>& tModqPrecon) const {
-    DCRTPolyImpl<VecType> partP(paramsP, m_format, true);
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    const auto PHatModqT{TransposeCRTTable(PHatModq)};
+#else
+    const std::vector<uint64_t> PHatModqT;
+#endif
+    return ApproxModDown(paramsQ, paramsP, PInvModq, PInvModqPrecon, PHatInvModp, PHatInvModpPrecon, PHatModq,
+                         PHatModqT, modqBarrettMu, tInvModp, tInvModpPrecon, t, tModqPrecon);
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
+    const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+    const std::vector<NativeInteger>& PInvModq, const std::vector<NativeInteger>& PInvModqPrecon,
+    const std::vector<NativeInteger>& PHatInvModp, const std::vector<NativeInteger>& PHatInvModpPrecon,
+    const std::vector<std::vector<NativeInteger>>& PHatModq, const std::vector<uint64_t>& PHatModqT,
+    const std::vector<DoubleNativeInt>& modqBarrettMu, const std::vector<NativeInteger>& tInvModp,
+    const std::vector<NativeInteger>& tInvModpPrecon, const NativeInteger& t,
+    const std::vector<NativeInteger>& tModqPrecon) const {
+    DCRTPolyImpl<VecType> partP(paramsP, m_format, false);
     size_t sizeP = paramsP->GetParams().size();
     size_t sizeQ = m_vectors.size() - sizeP;
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeP))
-    for (size_t j = 0; j < sizeP; ++j) {
+    OpenFHEParallelControls.ParallelFor(0, sizeP, [&](size_t j) {
         partP.m_vectors[j] = m_vectors[sizeQ + j];
         partP.m_vectors[j].SetFormat(Format::COEFFICIENT);
         // Multiply everything by -t^(-1) mod P (BGVrns only)
         if (t > 0)
             partP.m_vectors[j] *= tInvModp[j];
-    }
+    });
     partP.OverrideFormat(Format::COEFFICIENT);
 
-    auto partPSwitchedToQ =
-        partP.ApproxSwitchCRTBasis(paramsP, paramsQ, PHatInvModp, PHatInvModpPrecon, PHatModq, modqBarrettMu);
-
-    // Combine the switched DCRTPoly with the Q part of this to get the result
-    DCRTPolyImpl<VecType> ans(paramsQ, Format::EVALUATION, true);
+    // The switched polynomial becomes the result; its towers are overwritten in place below
+    auto ans = partP.ApproxSwitchCRTBasis(paramsP, paramsQ, PHatInvModp, PHatInvModpPrecon, PHatModq, PHatModqT,
+                                          modqBarrettMu);
     uint32_t diffQ = paramsQ->GetParams().size() - sizeQ;
     if (diffQ > 0)
         ans.DropLastElements(diffQ);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
-    for (size_t i = 0; i < sizeQ; ++i) {
-        // Multiply everything by t mod Q (BGVrns only)
-        if (t > 0)
-            partPSwitchedToQ.m_vectors[i] *= t;
-        partPSwitchedToQ.m_vectors[i].SetFormat(Format::EVALUATION);
-        ans.m_vectors[i] = (m_vectors[i] - partPSwitchedToQ.m_vectors[i]) * PInvModq[i];
-    }
+    OpenFHEParallelControls.ParallelFor(0, sizeQ, [&](size_t i) {
+        auto& ansi = ans.m_vectors[i];
+        ansi.SetFormat(Format::EVALUATION);
+        const auto& xi      = m_vectors[i];
+        const auto& qi      = xi.GetModulus();
+        const uint32_t size = xi.GetLength();
+        // Computes (x - t * switched) * P^(-1) mod qi in a single pass; the multiplication by t mod Q (BGVrns
+        // only) commutes with the NTT and is folded in here
+        if (t > 0) {
+            const NativeInteger tModqi{t.Mod(qi)};
+            for (uint32_t k = 0; k < size; ++k) {
+                ansi[k] = xi[k]
+                              .ModSubFast(ansi[k].ModMulFastConst(tModqi, qi, tModqPrecon[i]), qi)
+                              .ModMulFastConst(PInvModq[i], qi, PInvModqPrecon[i]);
+            }
+        }
+        else {
+            for (uint32_t k = 0; k < size; ++k)
+                ansi[k] = xi[k].ModSubFast(ansi[k], qi).ModMulFastConst(PInvModq[i], qi, PInvModqPrecon[i]);
+        }
+    });
+    ans.OverrideFormat(Format::EVALUATION);
     return ans;
 }
 
@@ -1123,9 +1399,9 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasis(
     m_vectors.insert(m_vectors.end(), std::make_move_iterator(partP.m_vectors.begin()),
                      std::make_move_iterator(partP.m_vectors.end()));
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
+    OpenFHEParallelControls.ParallelFor(0, sizeQP, [&](size_t i) {
         m_vectors[i].SetFormat(resultFormat);
+    });
     m_format = resultFormat;
     m_params = paramsQP;
 }
@@ -1154,9 +1430,9 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasisReverseOrder(
                            std::make_move_iterator(m_vectors.end()));
     m_vectors = std::move(partP.m_vectors);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQP))
-    for (size_t i = 0; i < sizeQP; ++i)
+    OpenFHEParallelControls.ParallelFor(0, sizeQP, [&](size_t i) {
         m_vectors[i].SetFormat(resultFormat);
+    });
     m_format = resultFormat;
     m_params = paramsQP;
 }
@@ -1220,14 +1496,13 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasisQlHat(const std::shared_ptr<Params>& p
                                                 const std::vector<NativeInteger>& QlHatModqPrecon, const usint sizeQ) {
     size_t sizeQl(m_vectors.size());
     uint32_t ringDim(m_params->GetRingDimension());
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQl))
-    for (size_t i = 0; i < sizeQl; ++i) {
+    OpenFHEParallelControls.ParallelFor(0, sizeQl, [&](size_t i) {
         const NativeInteger& qi               = m_vectors[i].GetModulus();
         const NativeInteger& QlHatModqi       = QlHatModq[i];
         const NativeInteger& QlHatModqiPrecon = QlHatModqPrecon[i];
         for (usint ri = 0; ri < ringDim; ri++)
             m_vectors[i][ri].ModMulFastConstEq(QlHatModqi, qi, QlHatModqiPrecon);
-    }
+    });
     m_vectors.resize(sizeQ);
     for (size_t i = sizeQl; i < sizeQ; ++i) {
         typename DCRTPolyImpl<VecType>::PolyType newvec(paramsQ->GetParams()[i], m_format, true);
@@ -1728,13 +2003,12 @@ void DCRTPolyImpl<VecType>::ScaleAndRoundPOverQ(const std::shared_ptr<Params>& p
     const auto& q          = m_params->GetParams();
     const uint32_t ringDim = m_params->GetRingDimension();
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
-    for (uint32_t i = 0; i < sizeQ; ++i) {
+    OpenFHEParallelControls.ParallelFor(0, sizeQ, [&](size_t i) {
         const auto& qi = q[i]->GetModulus();
         for (uint32_t ri = 0; ri < ringDim; ++ri)
             m_vectors[i][ri].ModSubEq(m_vectors[sizeQ][ri], qi);
         m_vectors[i] *= pInvModq[i];
-    }
+    });
     m_vectors.resize(sizeQ);
 }
 
@@ -1794,8 +2068,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
         result_mtilde[k] &= mtilde_minus_1;
     }
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numBsk))
-    for (uint32_t j = 0; j < numBsk; ++j) {
+    OpenFHEParallelControls.ParallelFor(0, numBsk, [&](size_t j) {
         const auto& moduliBskj             = moduliBsk[j];
         const auto& mtildeInvModbskj       = mtildeInvModbsk[j];
         const auto& mtildeInvModbskPreconj = mtildeInvModbskPrecon[j];
@@ -1821,7 +2094,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
             m_vectors[numQ + j][k] = r_m_tilde.ModMulFastConst(mtildeInvModbskj, moduliBskj, mtildeInvModbskPreconj);
         }
         m_vectors[numQ + j].SetFormat(Format::EVALUATION);
-    }
+    });
 
     m_format = Format::EVALUATION;
     if (polyInNTT.size() > 0) {
@@ -1829,9 +2102,9 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
         std::move(polyInNTT.begin(), polyInNTT.end(), m_vectors.begin());
     }
     else {
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numQ))
-        for (uint32_t i = 0; i < numQ; ++i)
+        OpenFHEParallelControls.ParallelFor(0, numQ, [&](size_t i) {
             m_vectors[i].SetFormat(Format::EVALUATION);
+        });
     }
 }
 
@@ -1863,8 +2136,7 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
     }
 
     std::vector<NativeInteger> txiqiDivqModqi(n * numBsk);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numBsk))
-    for (uint32_t j = 0; j < numBsk; ++j) {
+    OpenFHEParallelControls.ParallelFor(0, numBsk, [&](size_t j) {
         const auto& moduliBskj         = moduliBsk[j];
         const auto& tDivqModBskj       = tQInvModbsk[j];
         const auto& tDivqModBskjPrecon = tQInvModbskPrecon[j];
@@ -1886,7 +2158,7 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
             m_vectors[numQ + j][k].ModMulFastConstEq(tDivqModBskj, moduliBskj, tDivqModBskjPrecon);
             m_vectors[numQ + j][k].ModSubFastEq(txiqiDivqModqi[j * n + k], moduliBskj);
         }
-    }
+    });
 }
 
 // Input: poly in basis Bsk
@@ -1936,8 +2208,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
         alphaskxVector[k].ModMulFastConstEq(BInvModmsk, moduliBsk[sizeBskm1], BInvModmskPrecon);
     }
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
-    for (uint32_t j = 0; j < sizeQ; ++j) {
+    OpenFHEParallelControls.ParallelFor(0, sizeQ, [&](size_t j) {
         const auto& moduliQj     = moduliQ[j];
         const auto& bModqj       = BModq[j];
         const auto& bModqjPrecon = BModqPrecon[j];
@@ -1964,7 +2235,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
             alphaskBModqj.ModMulFastConstEq(bModqj, moduliQ[j], bModqjPrecon);
             m_vectors[j][k] = m_vectors[j][k].ModSubFast(alphaskBModqj, moduliQ[j]);
         }
-    }
+    });
 
     m_params = paramsQ;
 
@@ -1981,10 +2252,22 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
 template <typename VecType>
 void DCRTPolyImpl<VecType>::SwitchFormat() {
     m_format = (m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
-    size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i].SwitchFormat();
+    std::vector<PolyType*> towers;
+    towers.reserve(m_vectors.size());
+    for (auto& v : m_vectors)
+        towers.push_back(&v);
+    PolyType::SwitchFormat(towers);
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::SwitchFormat(const std::vector<DCRTPolyImpl*>& polys) {
+    std::vector<PolyType*> towers;
+    for (auto* poly : polys) {
+        poly->m_format = (poly->m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
+        for (auto& v : poly->m_vectors)
+            towers.push_back(&v);
+    }
+    PolyType::SwitchFormat(towers);
 }
 
 template <typename VecType>
@@ -36,6 +36,7 @@
 #ifndef LBCRYPTO_INC_LATTICE_HAL_DEFAULT_DCRTPOLY_H
 #define LBCRYPTO_INC_LATTICE_HAL_DEFAULT_DCRTPOLY_H
 
+#include "lattice/constants-lattice.h"
 #include "lattice/hal/default/ildcrtparams.h"
 #include "lattice/hal/default/poly.h"
 #include "lattice/hal/dcrtpoly-interface.h"
@@ -45,6 +46,7 @@
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/memory-stats.h"
 #include "utils/parallel.h"
 
 #include <functional>
@@ -73,8 +75,15 @@ public:
 
     DCRTPolyImpl() = default;
 
-    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format}, m_vectors{e.m_vectors} {}
+    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format} {
+        OPENFHE_MEMSTATS_POLY_COPY();
+        if (GetTowerLayout() == CONTIGUOUS_TOWERS)
+            CopyTowersContiguous(e.m_vectors, 0, e.m_vectors.size());
+        else
+            m_vectors = e.m_vectors;
+    }
     DCRTPolyType& operator=(const DCRTPolyType& rhs) noexcept override {
+        OPENFHE_MEMSTATS_POLY_COPY();
         m_params  = rhs.m_params;
         m_format  = rhs.m_format;
         m_vectors = rhs.m_vectors;
@@ -88,8 +97,11 @@ public:
     DCRTPolyType& operator=(const PolyType& rhs) noexcept;
 
     DCRTPolyImpl(DCRTPolyType&& e) noexcept
-        : m_params{std::move(e.m_params)}, m_format{e.m_format}, m_vectors{std::move(e.m_vectors)} {}
+        : m_params{std::move(e.m_params)}, m_format{e.m_format}, m_vectors{std::move(e.m_vectors)} {
+        OPENFHE_MEMSTATS_POLY_MOVE();
+    }
     DCRTPolyType& operator=(DCRTPolyType&& rhs) noexcept override {
+        OPENFHE_MEMSTATS_POLY_MOVE();
         m_params  = std::move(rhs.m_params);
         m_format  = std::move(rhs.m_format);
         m_vectors = std::move(rhs.m_vectors);
@@ -98,9 +110,22 @@ public:
 
     explicit DCRTPolyImpl(const std::vector<PolyType>& elements);
 
+    /**
+     * Takes over already built towers, keeping the storage they were placed in.
+     * @param params are the parameters matching the towers.
+     * @param format is the format of the towers.
+     * @param towers are the towers to take over.
+     */
+    DCRTPolyImpl(const std::shared_ptr<Params>& params, Format format, std::vector<PolyType>&& towers) noexcept
+        : m_params{params}, m_format{format}, m_vectors{std::move(towers)} {}
+
     DCRTPolyImpl(const std::shared_ptr<Params>& params, Format format = Format::EVALUATION,
                  bool initializeElementToZero = false) noexcept
         : m_params{params}, m_format{format} {
+        if (GetTowerLayout() == CONTIGUOUS_TOWERS) {
+            AllocateTowersContiguous(initializeElementToZero);
+            return;
+        }
         m_vectors.reserve(m_params->GetParams().size());
         for (const auto& p : m_params->GetParams())
             m_vectors.emplace_back(p, m_format, initializeElementToZero);
@@ -120,6 +145,26 @@ public:
     DCRTPolyType CloneWithNoise(const DiscreteGaussianGeneratorImpl<VecType>& dgg, Format format) const override;
     DCRTPolyType CloneTowers(uint32_t startTower, uint32_t endTower) const;
 
+    /**
+   * @brief Selects the storage layout of the towers of the polynomials created from now on. With
+   * CONTIGUOUS_TOWERS, the constructor from parameters, the copy constructor (hence Clone) and CloneTowers place
+   * all towers of the new polynomial in one 64-byte aligned, tower-major intnat::TowerBuffer: one allocation per
+   * polynomial instead of one per tower, and towers that are adjacent in memory. Copies of contiguous towers are
+   * made with a single memcpy, and towers the constructor is not asked to zero are left uninitialized. The towers
+   * still own their storage (they are not views into the polynomial they were copied from). The layout is a
+   * placement hint only: towers replaced later by other vectors (e.g., by move assignment) are stored wherever
+   * those vectors are, all operations give the same results in both layouts, and with BLOCK_VECTOR_ALLOCATION the
+   * towers always stay separate.
+   *
+   * @param layout the layout of the towers.
+   */
+    static void SetTowerLayout(TowerLayout layout);
+
+    /**
+   * @brief Returns the storage layout of the towers of new polynomials (SEPARATE_TOWERS by default).
+   */
+    static TowerLayout GetTowerLayout();
+
     bool operator==(const DCRTPolyType& rhs) const override;
 
     DCRTPolyType& operator+=(const DCRTPolyType& rhs) override;
@@ -129,10 +174,24 @@ public:
     DCRTPolyType& operator-=(const Integer& rhs) override;
     DCRTPolyType& operator-=(const NativeInteger& rhs) override;
     DCRTPolyType& operator*=(const DCRTPolyType& rhs) override {
+        // checked before the parallel loop, as an exception cannot leave a parallel region
+        if (m_format != Format::EVALUATION || rhs.m_format != Format::EVALUATION)
+            OPENFHE_THROW("operator* for DCRTPolyImpl supported only in Format::EVALUATION");
         size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i)
-            m_vectors[i] *= rhs.m_vectors[i];
+        if (!UseCoefficientBlocks()) {
+            OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+                m_vectors[i] *= rhs.m_vectors[i];
+            });
+            return *this;
+        }
+        CheckBlockOperands(rhs, "operator*=");
+        uint32_t ringDim{m_params->GetRingDimension()};
+        OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+            const auto& q{m_vectors[i].GetModulus()};
+            const auto mu{q.ComputeMu()};
+            for (size_t k = first; k < last; ++k)
+                m_vectors[i][k].ModMulFastEq(rhs.m_vectors[i][k], q, mu);
+        });
         return *this;
     }
     DCRTPolyType& operator*=(const Integer& rhs) override;
@@ -160,10 +219,20 @@ public:
             OPENFHE_THROW("tower size mismatch; cannot add");
         if (m_vectors[0].GetModulus() != rhs.m_vectors[0].GetModulus())
             OPENFHE_THROW("Modulus missmatch");
-        DCRTPolyType tmp(m_params, m_format);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i)
-            tmp.m_vectors[i] = m_vectors[i].PlusNoCheck(rhs.m_vectors[i]);
+        if (!UseCoefficientBlocks()) {
+            DCRTPolyType tmp(m_params, m_format);
+            OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+                tmp.m_vectors[i] = m_vectors[i].PlusNoCheck(rhs.m_vectors[i]);
+            });
+            return tmp;
+        }
+        DCRTPolyType tmp(m_params, m_format, true);
+        uint32_t ringDim{m_params->GetRingDimension()};
+        OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+            const auto& q{m_vectors[i].GetModulus()};
+            for (size_t k = first; k < last; ++k)
+                tmp.m_vectors[i][k] = m_vectors[i][k].ModAddFast(rhs.m_vectors[i][k], q);
+        });
         return tmp;
     }
 
@@ -181,10 +250,21 @@ public:
             OPENFHE_THROW("tower size mismatch; cannot multiply");
         if (m_vectors[0].GetModulus() != rhs.m_vectors[0].GetModulus())
             OPENFHE_THROW("Modulus missmatch");
-        DCRTPolyType tmp(m_params, m_format);
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-        for (size_t i = 0; i < size; ++i)
-            tmp.m_vectors[i] = m_vectors[i].TimesNoCheck(rhs.m_vectors[i]);
+        if (!UseCoefficientBlocks()) {
+            DCRTPolyType tmp(m_params, m_format);
+            OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+                tmp.m_vectors[i] = m_vectors[i].TimesNoCheck(rhs.m_vectors[i]);
+            });
+            return tmp;
+        }
+        DCRTPolyType tmp(m_params, m_format, true);
+        uint32_t ringDim{m_params->GetRingDimension()};
+        OpenFHEParallelControls.ParallelFor2D(size, ringDim, [&](size_t i, size_t first, size_t last) {
+            const auto& q{m_vectors[i].GetModulus()};
+            const auto mu{q.ComputeMu()};
+            for (size_t k = first; k < last; ++k)
+                tmp.m_vectors[i][k] = m_vectors[i][k].ModMulFast(rhs.m_vectors[i][k], q, mu);
+        });
         return tmp;
     }
     DCRTPolyType Times(const Integer& rhs) const override;
@@ -234,6 +314,23 @@ public:
                                       const std::vector<std::vector<NativeInteger>>& QHatModp,
                                       const std::vector<DoubleNativeInt>& modpBarrettMu) const override;
 
+    /**
+   * @brief ApproxSwitchCRTBasis with [Q/q_i]_{p_j} also given transposed, as returned by
+   * TransposeCRTTable(QHatModp), so that the conversion does not rebuild the transposed table on every call.
+   */
+    DCRTPolyType ApproxSwitchCRTBasis(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+                                      const std::vector<NativeInteger>& QHatInvModq,
+                                      const std::vector<NativeInteger>& QHatInvModqPrecon,
+                                      const std::vector<std::vector<NativeInteger>>& QHatModp,
+                                      const std::vector<uint64_t>& QHatModpT,
+                                      const std::vector<DoubleNativeInt>& modpBarrettMu) const;
+
+    /**
+   * @brief Transposes a table of [Q/q_i]_{p_j} indexed [i][j] into the layout read by the basis conversion: entry
+   * j * QHatModp.size() + i holds [Q/q_i]_{p_j}.
+   */
+    static std::vector<uint64_t> TransposeCRTTable(const std::vector<std::vector<NativeInteger>>& QHatModp);
+
     void ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                      const std::shared_ptr<Params>& paramsQP, const std::vector<NativeInteger>& QHatInvModq,
                      const std::vector<NativeInteger>& QHatInvModqPrecon,
@@ -248,6 +345,18 @@ public:
         const std::vector<NativeInteger>& tInvModp, const std::vector<NativeInteger>& tInvModpPrecon,
         const NativeInteger& t, const std::vector<NativeInteger>& tModqPrecon) const override;
 
+    /**
+   * @brief ApproxModDown with [P/p_j]_{q_i} also given transposed, as returned by TransposeCRTTable(PHatModq).
+   */
+    DCRTPolyType ApproxModDown(
+        const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
+        const std::vector<NativeInteger>& PInvModq, const std::vector<NativeInteger>& PInvModqPrecon,
+        const std::vector<NativeInteger>& PHatInvModp, const std::vector<NativeInteger>& PHatInvModpPrecon,
+        const std::vector<std::vector<NativeInteger>>& PHatModq, const std::vector<uint64_t>& PHatModqT,
+        const std::vector<DoubleNativeInt>& modqBarrettMu, const std::vector<NativeInteger>& tInvModp,
+        const std::vector<NativeInteger>& tInvModpPrecon, const NativeInteger& t,
+        const std::vector<NativeInteger>& tModqPrecon) const;
+
     DCRTPolyType SwitchCRTBasis(const std::shared_ptr<Params>& paramsP, const std::vector<NativeInteger>& QHatInvModq,
                                 const std::vector<NativeInteger>& QHatInvModqPrecon,
                                 const std::vector<std::vector<NativeInteger>>& QHatModp,
@@ -331,6 +440,15 @@ public:
 
     void SwitchFormat() override;
 
+    /**
+     * @brief Switches the format of several DCRTPolys in one call; each one switches to the opposite of
+     * its own format. The NTTs of all towers of all polynomials are scheduled together (cache-blocked and
+     * spread over the threads as one batch), which helps most when each polynomial has few towers.
+     *
+     * @param polys distinct polynomials to switch
+     */
+    static void SwitchFormat(const std::vector<DCRTPolyImpl*>& polys);
+
     void SwitchModulusAtIndex(size_t index, const Integer& modulus, const Integer& rootOfUnity) override;
 
     template <class Archive>
@@ -392,6 +510,19 @@ public:
     }
 
 protected:
+    // true when the elementwise operations split the towers into blocks of coefficients, i.e. there are fewer
+    // towers than threads (see ParallelControls::ParallelFor2D)
+    bool UseCoefficientBlocks() const {
+        return OpenFHEParallelControls.GetBlocksPerRow(m_vectors.size(), m_params->GetRingDimension()) > 1;
+    }
+    // the blocked operations index the towers of rhs directly, so they check what NativeVector would check
+    void CheckBlockOperands(const DCRTPolyType& rhs, const char* op) const;
+
+    // creates the towers for m_params in one TowerBuffer, zero or left uninitialized
+    void AllocateTowersContiguous(bool initializeElementToZero);
+    // replaces the towers by copies of towers[start, start + count) placed in one TowerBuffer
+    void CopyTowersContiguous(const std::vector<PolyType>& towers, size_t start, size_t count);
+
     std::shared_ptr<Params> m_params{std::make_shared<DCRTPolyImpl::Params>()};
     Format m_format{Format::EVALUATION};
     std::vector<PolyType> m_vectors;
@@ -46,6 +46,7 @@
 #include "utils/inttypes.h"
 
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace lbcrypto {
@@ -79,21 +80,27 @@ public:
         : ILParamsImpl<IntType>(order, LastPrime<IntType>(bits, order)) {}
 
     explicit ILParamsImpl(uint32_t order, const IntType& modulus)
-        : ElemParams<IntType>(order, modulus, RootOfUnity<IntType>(order, modulus)) {}
+        : ElemParams<IntType>(order, modulus, RootOfUnity<IntType>(order, modulus)) {
+        RegisterNTTTables();
+    }
 
     ILParamsImpl(uint32_t order, const IntType& modulus, const IntType& rootOfUnity)
-        : ElemParams<IntType>(order, modulus, rootOfUnity) {}
+        : ElemParams<IntType>(order, modulus, rootOfUnity) {
+        RegisterNTTTables();
+    }
 
     ILParamsImpl(uint32_t order, const IntType& modulus, const IntType& rootOfUnity, const IntType& bigModulus,
                  const IntType& bigRootOfUnity)
-        : ElemParams<IntType>(order, modulus, rootOfUnity, bigModulus, bigRootOfUnity) {}
+        : ElemParams<IntType>(order, modulus, rootOfUnity, bigModulus, bigRootOfUnity) {
+        RegisterNTTTables();
+    }
 
     /**
    * @brief Copy constructor.
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs) {}
+    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs), m_nttTables(rhs.m_nttTables) {}
 
     /**
    * @brief Copy Assignment Operator.
@@ -103,6 +110,7 @@ public:
    */
     ILParamsImpl& operator=(const ILParamsImpl& rhs) {
         ElemParams<IntType>::operator=(rhs);
+        m_nttTables = rhs.m_nttTables;
         return *this;
     }
 
@@ -111,10 +119,12 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(ILParamsImpl&& rhs) noexcept : ElemParams<IntType>(std::move(rhs)) {}
+    ILParamsImpl(ILParamsImpl&& rhs) noexcept
+        : ElemParams<IntType>(std::move(rhs)), m_nttTables(std::move(rhs.m_nttTables)) {}
 
     ILParamsImpl& operator=(ILParamsImpl&& rhs) noexcept {
         ElemParams<IntType>::operator=(std::move(rhs));
+        m_nttTables = std::move(rhs.m_nttTables);
         return *this;
     }
 
@@ -131,6 +141,18 @@ public:
         return ElemParams<IntType>::operator==(rhs);
     }
 
+    /**
+   * @brief Handle of the NTT tables of this parameter set in intnat::NTTTwiddleRegistry.
+   *
+   * The tables are registered when the parameters are created (native integers and power-of-two cyclotomic
+   * orders only), so transforms with these parameters do not look them up by modulus. The parameters hold a
+   * reference to the tables, so the handle stays valid while they exist.
+   * @return the handle, or intnat::NTT_INVALID_HANDLE if no tables are registered
+   */
+    uint32_t GetNTTHandle() const {
+        return m_nttTables.GetHandle();
+    }
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<ElemParams<IntType>>(this));
@@ -142,6 +164,7 @@ public:
             OPENFHE_THROW("serialized object version " + std::to_string(version) +
                           " is from a later version of the library");
         ar(::cereal::base_class<ElemParams<IntType>>(this));
+        RegisterNTTTables();
     }
 
     std::string SerializedObjectName() const override {
@@ -153,11 +176,35 @@ public:
     }
 
 private:
+    void RegisterNTTTables() {
+        if constexpr (std::is_same_v<IntType, NativeInteger>) {
+            const uint32_t order   = this->m_cyclotomicOrder;
+            const IntType& modulus = this->m_ciphertextModulus;
+            const IntType& root    = this->m_rootOfUnity;
+            m_nttTables            = {};
+            // only register proper 2n-th roots of unity (root^n = -1 mod q); other parameter sets keep the lookup
+            // by root of unity, which reports any error only if a transform is actually requested
+            if (order < 2 || !IsPowerOfTwo(order) || root <= IntType(1) || root >= modulus ||
+                modulus.Mod(IntType(order)) != IntType(1) ||
+                root.ModExp(IntType(order >> 1), modulus) != modulus - IntType(1))
+                return;
+            try {
+                m_nttTables = intnat::NTTTwiddleRegistry<NativeVector>::Register(root, order, modulus);
+            }
+            catch (const OpenFHEException&) {
+                // the registry is full: the transforms fall back to the lookup by root of unity
+            }
+        }
+    }
+
     std::ostream& doprint(std::ostream& out) const override {
         out << "ILParams ";
         ElemParams<IntType>::doprint(out);
         return out << std::endl;
     }
+
+    // keeps the NTT tables of the parameters alive
+    intnat::NTTTwiddleRegistry<NativeVector>::Reference m_nttTables;
 };
 
 }  // namespace lbcrypto
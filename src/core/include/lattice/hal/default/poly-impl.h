@@ -47,6 +47,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -420,6 +421,21 @@ void PolyImpl<VecType>::SwitchFormat() {
     if (!m_values)
         OPENFHE_THROW("Poly switch format to empty values");
 
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        // the tables registered with the parameters spare the lookup by modulus
+        const auto handle{m_params->GetNTTHandle()};
+        if (handle != intnat::NTT_INVALID_HANDLE && m_values->GetModulus() == m_params->GetModulus()) {
+            if (m_format != Format::COEFFICIENT) {
+                m_format = Format::COEFFICIENT;
+                ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(handle, &(*m_values));
+                return;
+            }
+            m_format = Format::EVALUATION;
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(handle, &(*m_values));
+            return;
+        }
+    }
+
     if (m_format != Format::COEFFICIENT) {
         m_format = Format::COEFFICIENT;
         ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
@@ -429,6 +445,46 @@ void PolyImpl<VecType>::SwitchFormat() {
     ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(ru, co, &(*m_values));
 }
 
+template <typename VecType>
+void PolyImpl<VecType>::SwitchFormat(const std::vector<PolyImpl*>& polys) {
+    if constexpr (!std::is_same_v<VecType, NativeVector>) {
+        // the fused multi-vector transforms are implemented by the native backend only
+        for (auto* poly : polys)
+            poly->SwitchFormat();
+    }
+    else {
+        std::vector<uint32_t> handlesForward, handlesInverse;
+        std::vector<VecType*> valuesForward, valuesInverse;
+        usint co{0};
+        for (auto* poly : polys) {
+            const auto& c{poly->m_params->GetCyclotomicOrder()};
+            const auto handle{poly->m_params->GetNTTHandle()};
+            // polys without registered tables take the single-vector path, which looks the tables up by modulus
+            if (handle == intnat::NTT_INVALID_HANDLE || (co != 0 && c != co) || !poly->m_values ||
+                poly->m_values->GetModulus() != poly->m_params->GetModulus()) {
+                poly->SwitchFormat();
+                continue;
+            }
+            co = c;
+            if (poly->m_format != Format::COEFFICIENT) {
+                poly->m_format = Format::COEFFICIENT;
+                handlesInverse.push_back(handle);
+                valuesInverse.push_back(&(*poly->m_values));
+            }
+            else {
+                poly->m_format = Format::EVALUATION;
+                handlesForward.push_back(handle);
+                valuesForward.push_back(&(*poly->m_values));
+            }
+        }
+        if (!valuesForward.empty())
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(handlesForward, valuesForward);
+        if (!valuesInverse.empty())
+            ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(handlesInverse,
+                                                                                          valuesInverse);
+    }
+}
+
 template <typename VecType>
 void PolyImpl<VecType>::ArbitrarySwitchFormat() {
     if (m_values == nullptr)
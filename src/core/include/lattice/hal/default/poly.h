@@ -91,6 +91,12 @@ public:
             this->SetValuesToZero();
     }
 
+    /**
+   * @brief Constructor taking over the values as they are, without checking them against the parameters.
+   */
+    PolyImpl(const std::shared_ptr<Params>& params, Format format, VecType&& values) noexcept
+        : m_format{format}, m_params{params}, m_values{std::make_unique<VecType>(std::move(values))} {}
+
     PolyImpl(bool initializeElementToMax, const std::shared_ptr<Params>& params, Format format = Format::EVALUATION)
         : m_format{format}, m_params{params} {
         if (initializeElementToMax)
@@ -318,6 +324,16 @@ public:
     void SwitchModulus(const Integer& modulus, const Integer& rootOfUnity, const Integer& modulusArb,
                        const Integer& rootOfUnityArb) override;
     void SwitchFormat() override;
+
+    /**
+     * @brief Switches the format of several polynomials in one call; each one switches to the opposite
+     * of its own format. Power-of-two cyclotomic polynomials with the same ring dimension are transformed
+     * together by the fused multi-vector NTT, the others one by one.
+     *
+     * @param polys distinct polynomials to switch
+     */
+    static void SwitchFormat(const std::vector<PolyImpl*>& polys);
+
     void MakeSparse(uint32_t wFactor) override;
     bool InverseExists() const override;
     double Norm() const override;
@@ -37,12 +37,14 @@
 #define LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT_H
 
 #include "math/hal/basicint.h"
+#include "math/hal/intnat/towerbuffer.h"
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/vector.h"
 
 #include "utils/blockAllocator/xvector.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/memory-stats.h"
 #include "utils/serializable.h"
 
 #include <algorithm>
@@ -124,7 +126,7 @@ private:
     IntegerType m_modulus{0};
 
 #if BLOCK_VECTOR_ALLOCATION != 1
-    std::vector<IntegerType> m_data{};
+    std::vector<IntegerType, NativeVectorAllocator<IntegerType>> m_data{};
 #else
     xvector<IntegerType> m_data{};
 #endif
@@ -173,12 +175,62 @@ public:
         //                              " bits larger than max modulus bits " + std::to_string(MAX_MODULUS_SIZE));
     }
 
+    /**
+   * Constructor placing the vector with a given allocator, e.g., in a slot of a TowerBuffer. With block
+   * allocations the vector cannot be placed in the slot and takes a copy of the values of an external slot.
+   *
+   * @param length is the length of the native vector, in terms of the number of entries.
+   * @param modulus is the modulus of the ring.
+   * @param alloc is the allocator of the entries.
+   */
+#if BLOCK_VECTOR_ALLOCATION != 1
+    NativeVectorT(usint length, const IntegerType& modulus, const NativeVectorAllocator<IntegerType>& alloc) noexcept
+        : m_modulus{modulus}, m_data(length, alloc) {}
+#else
+    NativeVectorT(usint length, const IntegerType& modulus, const NativeVectorAllocator<IntegerType>& alloc) noexcept
+        : m_modulus{modulus}, m_data(length) {
+        if (const IntegerType* values = alloc.GetExternalValues(length))
+            std::copy(values, values + length, m_data.begin());
+    }
+#endif
+
+    /**
+   * Copy constructor placing the copy with a given allocator.
+   *
+   * @param v is the native vector to be copied.
+   * @param alloc is the allocator of the entries of the copy.
+   */
+#if BLOCK_VECTOR_ALLOCATION != 1
+    NativeVectorT(const NativeVectorT& v, const NativeVectorAllocator<IntegerType>& alloc) noexcept
+        : m_modulus{v.m_modulus}, m_data(v.m_data, alloc) {
+        OPENFHE_MEMSTATS_VECTOR_COPY(m_data.size() * sizeof(IntegerType));
+    }
+#else
+    NativeVectorT(const NativeVectorT& v, const NativeVectorAllocator<IntegerType>&) noexcept
+        : m_modulus{v.m_modulus}, m_data(v.m_data) {
+        OPENFHE_MEMSTATS_VECTOR_COPY(m_data.size() * sizeof(IntegerType));
+    }
+#endif
+
+    /**
+   * Returns the allocator of the entries, which identifies the TowerBuffer slot holding them, if any.
+   */
+    NativeVectorAllocator<IntegerType> GetAllocator() const {
+#if BLOCK_VECTOR_ALLOCATION != 1
+        return m_data.get_allocator();
+#else
+        return NativeVectorAllocator<IntegerType>();
+#endif
+    }
+
     /**
    * Basic constructor for copying a vector
    *
    * @param bigVector is the native vector to be copied.
    */
-    constexpr NativeVectorT(const NativeVectorT& v) noexcept : m_modulus{v.m_modulus}, m_data{v.m_data} {}
+    constexpr NativeVectorT(const NativeVectorT& v) noexcept : m_modulus{v.m_modulus}, m_data{v.m_data} {
+        OPENFHE_MEMSTATS_VECTOR_COPY(m_data.size() * sizeof(IntegerType));
+    }
 
     /**
    * Basic move constructor for moving a vector
@@ -186,7 +238,9 @@ public:
    * @param &&bigVector is the native vector to be moved.
    */
     constexpr NativeVectorT(NativeVectorT&& v) noexcept
-        : m_modulus{std::move(v.m_modulus)}, m_data{std::move(v.m_data)} {}
+        : m_modulus{std::move(v.m_modulus)}, m_data{std::move(v.m_data)} {
+        OPENFHE_MEMSTATS_VECTOR_MOVE();
+    }
 
     /**
    * Basic constructor for specifying the length of the vector
@@ -218,6 +272,7 @@ public:
    * @return Assigned NativeVectorT.
    */
     NativeVectorT& operator=(const NativeVectorT& rhs) noexcept {
+        OPENFHE_MEMSTATS_VECTOR_COPY(rhs.m_data.size() * sizeof(IntegerType));
         m_modulus = rhs.m_modulus;
         if (m_data.size() >= rhs.m_data.size()) {
             std::copy(rhs.m_data.begin(), rhs.m_data.end(), m_data.begin());
@@ -236,6 +291,7 @@ public:
    * @return moved NativeVectorT object
    */
     NativeVectorT& operator=(NativeVectorT&& rhs) noexcept {
+        OPENFHE_MEMSTATS_VECTOR_MOVE();
         m_modulus = std::move(rhs.m_modulus);
         m_data    = std::move(rhs.m_data);
         return *this;
@@ -0,0 +1,521 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Contiguous storage for the towers of a double-CRT polynomial, the per-thread scratch arena and the allocator of
+  native vectors
+ */
+
+#ifndef LBCRYPTO_INC_MATH_HAL_INTNAT_TOWERBUFFER_H
+#define LBCRYPTO_INC_MATH_HAL_INTNAT_TOWERBUFFER_H
+
+#include "utils/memory-stats.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace intnat {
+
+/// Alignment of every tower in a TowerBuffer (one cache line)
+constexpr size_t TOWER_BUFFER_ALIGNMENT = 64;
+
+/**
+ * @brief Per-thread cache of the memory blocks backing native vectors and tower buffers.
+ *
+ * Evaluation routines create and destroy many polynomials of the same shape, so the blocks of a given size (a
+ * function of the ring dimension and the number of towers) are kept in a free list of the thread that releases
+ * them and handed out again to the next allocation of the same size on that thread, bypassing malloc. Blocks
+ * smaller than MIN_BLOCK_BYTES always go to the heap.
+ *
+ * The arena is disabled by default. SetLimit() bounds the number of bytes each thread may keep cached; blocks
+ * released while the cache of the thread is full are freed. A new limit trims the cache of the calling thread at
+ * once and the cache of every other thread lazily, the next time that thread allocates or releases a block. Trim()
+ * releases the cache of the calling thread, and the cache of a thread is released when the thread exits.
+ */
+class ScratchArena {
+public:
+    /// Smallest block handled by the arena (a tower of ring dimension 512)
+    static constexpr size_t MIN_BLOCK_BYTES = 4096;
+
+    ScratchArena(const ScratchArena&)            = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * Sets the maximum number of bytes each thread keeps cached. 0 disables the arena. The cache of the calling
+     * thread is trimmed to the new limit here; the other threads trim theirs on their next Allocate() or
+     * Deallocate().
+     * @param bytes is the new limit.
+     */
+    static void SetLimit(size_t bytes) noexcept {
+        LimitSetting().store(bytes, std::memory_order_relaxed);
+        Trim(bytes);
+    }
+
+    static size_t GetLimit() noexcept {
+        return LimitSetting().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Frees cached blocks of the calling thread until at most keepBytes remain.
+     * @param keepBytes is the number of bytes that may stay cached.
+     */
+    static void Trim(size_t keepBytes = 0) noexcept {
+        if (auto* arena = Local())
+            arena->Shrink(keepBytes);
+    }
+
+    /// @return the number of bytes cached by the calling thread
+    static size_t GetCachedBytes() noexcept {
+        auto* arena = Local();
+        return arena ? arena->m_bytes : 0;
+    }
+
+    /**
+     * Allocates a block aligned to TOWER_BUFFER_ALIGNMENT, reusing a cached block of the same size if possible.
+     * @param bytes is the size of the block.
+     * @return the block
+     */
+    static void* Allocate(size_t bytes) {
+        OPENFHE_MEMSTATS_ALLOC(bytes);
+        if (bytes < MIN_BLOCK_BYTES)
+            return ::operator new(bytes);
+        if (auto* arena = Local()) {
+            const size_t limit{GetLimit()};
+            arena->ApplyLimit(limit);
+            if (limit > 0) {
+                if (void* p = arena->Pop(bytes))
+                    return p;
+            }
+        }
+        return ::operator new(bytes, std::align_val_t{TOWER_BUFFER_ALIGNMENT});
+    }
+
+    /**
+     * Returns a block obtained from Allocate() with the same size.
+     * @param p is the block.
+     * @param bytes is the size of the block.
+     */
+    static void Deallocate(void* p, size_t bytes) noexcept {
+        OPENFHE_MEMSTATS_FREE(bytes);
+        if (bytes < MIN_BLOCK_BYTES) {
+            ::operator delete(p);
+            return;
+        }
+        if (auto* arena = Local()) {
+            const size_t limit{GetLimit()};
+            arena->ApplyLimit(limit);
+            if (limit > 0 && arena->Push(p, bytes, limit))
+                return;
+        }
+        ::operator delete(p, std::align_val_t{TOWER_BUFFER_ALIGNMENT});
+    }
+
+private:
+    explicit ScratchArena(bool& destroyed) noexcept : m_destroyed{destroyed} {}
+
+    ~ScratchArena() {
+        Shrink(0);
+        m_destroyed = true;
+    }
+
+    static std::atomic<size_t>& LimitSetting() noexcept {
+        static std::atomic<size_t> limit{0};
+        return limit;
+    }
+
+    // the arena of the calling thread, or nullptr once the thread-local storage has been torn down
+    static ScratchArena* Local() noexcept {
+        static thread_local bool destroyed{false};
+        if (destroyed)
+            return nullptr;
+        static thread_local ScratchArena arena(destroyed);
+        return &arena;
+    }
+
+    // trims a cache that holds more than a limit lowered since the last call
+    void ApplyLimit(size_t limit) noexcept {
+        if (m_bytes > limit)
+            Shrink(limit);
+    }
+
+    void* Pop(size_t bytes) noexcept {
+        for (auto& bin : m_bins) {
+            if (bin.first == bytes) {
+                if (bin.second.empty())
+                    return nullptr;
+                void* p = bin.second.back();
+                bin.second.pop_back();
+                m_bytes -= bytes;
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    bool Push(void* p, size_t bytes, size_t limit) noexcept {
+        if (m_bytes + bytes > limit)
+            return false;
+        try {
+            auto bin = m_bins.begin();
+            while (bin != m_bins.end() && bin->first != bytes)
+                ++bin;
+            if (bin == m_bins.end())
+                bin = m_bins.emplace(m_bins.end(), bytes, std::vector<void*>());
+            bin->second.push_back(p);
+        }
+        catch (...) {
+            return false;
+        }
+        m_bytes += bytes;
+        return true;
+    }
+
+    void Shrink(size_t keepBytes) noexcept {
+        for (auto& bin : m_bins) {
+            while (m_bytes > keepBytes && !bin.second.empty()) {
+                ::operator delete(bin.second.back(), std::align_val_t{TOWER_BUFFER_ALIGNMENT});
+                bin.second.pop_back();
+                m_bytes -= bin.first;
+            }
+        }
+    }
+
+    bool& m_destroyed;
+    size_t m_bytes{0};
+    std::vector<std::pair<size_t, std::vector<void*>>> m_bins;
+};
+
+/**
+ * @brief A single aligned allocation holding the coefficients of several towers back to back (tower-major).
+ *
+ * Each tower occupies a slot of GetTowerStride() bytes starting at a 64-byte boundary. A slot is handed out to
+ * at most one vector at a time (see NativeVectorAllocator). The buffer is reference counted by the handle
+ * returned by Create() or Wrap() and by the allocators bound to its slots, and is released when the last of them
+ * goes away.
+ *
+ * The first vector placed in a slot of a buffer created without initialization, or of a buffer wrapping external
+ * memory, takes the values found in the slot instead of being initialized: this is how deserialized towers are
+ * used in place and how towers that are overwritten right away skip the zero fill.
+ */
+class TowerBuffer {
+public:
+    /// The slot of one tower
+    struct Slot {
+        TowerBuffer* buffer{nullptr};
+        std::atomic<bool> inUse{false};
+        // true until the slot is released for the first time if its contents are to be kept
+        bool keepContents{false};
+    };
+
+    /**
+     * Creates a buffer for the given number of towers.
+     * @param towers is the number of towers.
+     * @param towerBytes is the size of a tower, rounded up to a multiple of 64 bytes to give the distance
+     * between towers.
+     * @param initialize is false if the vectors first placed in the slots are to keep the (unspecified) contents
+     * of the memory, e.g. because they are overwritten right away.
+     * @return the handle of the buffer
+     */
+    static std::shared_ptr<TowerBuffer> Create(size_t towers, size_t towerBytes, bool initialize = true) {
+        return Manage(new TowerBuffer(nullptr, towers, towerBytes, nullptr, !initialize));
+    }
+
+    /**
+     * Wraps external memory holding the towers. The memory must start at a 64-byte boundary, be writable and
+     * stay valid as long as the owner is alive; the buffer keeps the owner alive and never frees the memory.
+     * @param data is the start of the first tower.
+     * @param towers is the number of towers.
+     * @param towerBytes is the size of a tower, rounded up to a multiple of 64 bytes to give the distance
+     * between towers.
+     * @param owner is the object the memory belongs to.
+     * @return the handle of the buffer
+     */
+    static std::shared_ptr<TowerBuffer> Wrap(uint8_t* data, size_t towers, size_t towerBytes,
+                                             std::shared_ptr<void> owner) {
+        return Manage(new TowerBuffer(data, towers, towerBytes, std::move(owner), true));
+    }
+
+    TowerBuffer(const TowerBuffer&)            = delete;
+    TowerBuffer& operator=(const TowerBuffer&) = delete;
+
+    /// @return the distance between the towers of a buffer for towers of the given size
+    static constexpr size_t GetStride(size_t towerBytes) {
+        return (towerBytes + TOWER_BUFFER_ALIGNMENT - 1) & ~(TOWER_BUFFER_ALIGNMENT - 1);
+    }
+
+    /// @return the slot of a tower, or nullptr if there is no such tower
+    Slot* GetSlot(size_t tower) noexcept {
+        return tower < m_towers ? &m_slots[tower] : nullptr;
+    }
+
+    /// @return the index of a slot of this buffer
+    size_t GetTower(const Slot* slot) const noexcept {
+        return static_cast<size_t>(slot - m_slots.get());
+    }
+
+    /**
+     * Reserves a slot.
+     * @param slot is a slot of this buffer.
+     * @param bytes is the number of bytes needed.
+     * @return the start of the slot, or nullptr if the slot is taken or too small
+     */
+    void* Acquire(Slot* slot, size_t bytes) noexcept {
+        if (bytes > m_stride || slot->inUse.exchange(true, std::memory_order_acquire))
+            return nullptr;
+        return m_data + GetTower(slot) * m_stride;
+    }
+
+    /**
+     * Returns a slot to the buffer.
+     * @param ptr is the memory to release.
+     * @return false if ptr does not belong to this buffer
+     */
+    bool Release(const void* ptr) noexcept {
+        if (!Contains(ptr))
+            return false;
+        auto& slot        = m_slots[(static_cast<const uint8_t*>(ptr) - m_data) / m_stride];
+        slot.keepContents = false;
+        slot.inUse.store(false, std::memory_order_release);
+        return true;
+    }
+
+    /// @return true if ptr is the start of the given slot, i.e., the slot holds the vector whose entries start at ptr
+    bool IsPlacedInSlot(const Slot* slot, const void* ptr) const noexcept {
+        return static_cast<const uint8_t*>(ptr) == m_data + GetTower(slot) * m_stride;
+    }
+
+    /// @return true if the entry at ptr lies in the given slot, which still holds the values it is to keep
+    bool KeepsContents(const Slot* slot, const void* ptr) const noexcept {
+        if (!slot->keepContents || !Contains(ptr))
+            return false;
+        return static_cast<size_t>(static_cast<const uint8_t*>(ptr) - m_data) / m_stride == GetTower(slot);
+    }
+
+    size_t GetTowerCount() const {
+        return m_towers;
+    }
+
+    size_t GetTowerStride() const {
+        return m_stride;
+    }
+
+    uint8_t* GetData() {
+        return m_data;
+    }
+
+    const uint8_t* GetData() const {
+        return m_data;
+    }
+
+    /// @return true if the buffer wraps external memory whose contents are the values of the towers
+    bool IsExternal() const {
+        return m_external;
+    }
+
+    /// @return true if ptr lies in the buffer
+    bool Contains(const void* ptr) const noexcept {
+        auto p = static_cast<const uint8_t*>(ptr);
+        return p >= m_data && p < m_data + m_towers * m_stride;
+    }
+
+    void AddRef() noexcept {
+        m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void ReleaseRef() noexcept {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+private:
+    TowerBuffer(uint8_t* data, size_t towers, size_t towerBytes, std::shared_ptr<void> owner, bool keepContents)
+        : m_towers{towers},
+          m_stride{GetStride(towerBytes)},
+          m_data{data ? data : static_cast<uint8_t*>(ScratchArena::Allocate(m_towers * m_stride))},
+          m_slots{std::make_unique<Slot[]>(m_towers)},
+          m_owner{std::move(owner)},
+          m_external{data != nullptr} {
+        for (size_t i = 0; i < m_towers; ++i) {
+            m_slots[i].buffer       = this;
+            m_slots[i].keepContents = keepContents;
+        }
+    }
+
+    ~TowerBuffer() {
+        if (!m_external)
+            ScratchArena::Deallocate(m_data, m_towers * m_stride);
+    }
+
+    // the handle holds one reference, released when the last copy of the handle goes away
+    static std::shared_ptr<TowerBuffer> Manage(TowerBuffer* buffer) {
+        return std::shared_ptr<TowerBuffer>(buffer, [](TowerBuffer* b) {
+            b->ReleaseRef();
+        });
+    }
+
+    size_t m_towers;
+    size_t m_stride;
+    uint8_t* m_data;
+    std::unique_ptr<Slot[]> m_slots;
+    std::shared_ptr<void> m_owner;
+    bool m_external;
+    std::atomic<size_t> m_refs{1};
+};
+
+/**
+ * @brief Allocator of the native vectors.
+ *
+ * A default-constructed allocator uses the heap through the ScratchArena of the thread. An allocator bound to a
+ * slot of a TowerBuffer places the vector in that slot while it is free and large enough, and falls back to the
+ * heap otherwise. The allocator moves with the memory it allocated (move assignment and swap), whereas copies of a
+ * vector are placed on the heap, so vectors keep their value semantics whatever their storage.
+ *
+ * The state of the allocator is a single pointer to the slot, which is null for vectors on the heap, so it adds
+ * one word to every vector and no reference counting unless the vector is placed in a TowerBuffer.
+ */
+template <typename T>
+class NativeVectorAllocator {
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    NativeVectorAllocator() noexcept = default;
+
+    NativeVectorAllocator(const std::shared_ptr<TowerBuffer>& buffer, size_t tower) noexcept
+        : m_slot{buffer ? buffer->GetSlot(tower) : nullptr} {
+        AddRef();
+    }
+
+    // moving an allocator must leave the source unchanged, so the implicit move is deliberately not declared
+    NativeVectorAllocator(const NativeVectorAllocator& rhs) noexcept : m_slot{rhs.m_slot} {
+        AddRef();
+    }
+
+    template <typename U>
+    NativeVectorAllocator(const NativeVectorAllocator<U>& rhs) noexcept  // NOLINT
+        : m_slot{rhs.GetSlot()} {
+        AddRef();
+    }
+
+    NativeVectorAllocator& operator=(const NativeVectorAllocator& rhs) noexcept {
+        if (m_slot != rhs.m_slot) {
+            ReleaseRef();
+            m_slot = rhs.m_slot;
+            AddRef();
+        }
+        return *this;
+    }
+
+    ~NativeVectorAllocator() {
+        ReleaseRef();
+    }
+
+    T* allocate(size_t n) {
+        if (m_slot) {
+            if (void* p = m_slot->buffer->Acquire(m_slot, n * sizeof(T)))
+                return static_cast<T*>(p);
+        }
+        return static_cast<T*>(ScratchArena::Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (m_slot && m_slot->buffer->Release(p))
+            return;
+        ScratchArena::Deallocate(p, n * sizeof(T));
+    }
+
+    // default construction keeps the values a slot is to keep (see TowerBuffer)
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0 && std::is_trivially_destructible_v<U>) {
+            if (m_slot && m_slot->buffer->KeepsContents(m_slot, p))
+                return;
+        }
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    NativeVectorAllocator select_on_container_copy_construction() const noexcept {
+        return NativeVectorAllocator();
+    }
+
+    /// @return the slot the allocator is bound to, or nullptr
+    TowerBuffer::Slot* GetSlot() const {
+        return m_slot;
+    }
+
+    /**
+     * Gives the values held by an external slot, for vectors that cannot be placed in it.
+     * @param n is the number of entries.
+     * @return the entries of the slot, or nullptr if the allocator is not bound to a slot of external memory
+     */
+    const T* GetExternalValues(size_t n) const noexcept {
+        if (!m_slot || !m_slot->buffer->IsExternal() || n * sizeof(T) > m_slot->buffer->GetTowerStride())
+            return nullptr;
+        const auto* buffer = m_slot->buffer;
+        return reinterpret_cast<const T*>(buffer->GetData() + buffer->GetTower(m_slot) * buffer->GetTowerStride());
+    }
+
+    template <typename U>
+    bool operator==(const NativeVectorAllocator<U>& rhs) const noexcept {
+        return m_slot == rhs.GetSlot();
+    }
+
+    template <typename U>
+    bool operator!=(const NativeVectorAllocator<U>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    void AddRef() noexcept {
+        if (m_slot)
+            m_slot->buffer->AddRef();
+    }
+
+    void ReleaseRef() noexcept {
+        if (m_slot)
+            m_slot->buffer->ReleaseRef();
+    }
+
+    TowerBuffer::Slot* m_slot{nullptr};
+};
+
+}  // namespace intnat
+
+#endif
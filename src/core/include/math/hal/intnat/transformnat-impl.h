@@ -40,43 +40,22 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/transformnat-simd.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
 #include <map>
+#include <type_traits>
 #include <vector>
 
 namespace intnat {
 
 using namespace lbcrypto;
 
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInversePreconTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInverseReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityPreconReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
-
 template <typename VecType>
 std::map<typename VecType::Integer, VecType> ChineseRemainderTransformArbNat<VecType>::m_cyclotomicPolyMap;
 
@@ -318,6 +297,20 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
     //             element[j1 + t] = (loVal - hiVal) mod modulus
     //
 
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t>) {
+        static_assert(sizeof(IntType) == sizeof(uint64_t), "SIMD NTT kernels require a plain 64-bit integer layout");
+        const auto backend{GetNTTBackend()};
+        const uint32_t len(element->GetLength());
+        if (backend != SCALAR_NTT && len >= NTT_SIMD_MIN_RING_DIM) {
+            ForwardTransformToBitReverseInPlaceSIMD(
+                backend, reinterpret_cast<uint64_t*>(&(*element)[0]),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]), len,
+                element->GetModulus().ConvertToInt());
+            return;
+        }
+    }
+
     const auto modulus{element->GetModulus()};
     const uint32_t n(element->GetLength() >> 1);
     for (uint32_t m{1}, t{n}, logt{GetMSB(t)}; m < n; m <<= 1, t >>= 1, --logt) {
@@ -391,6 +384,14 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverse(const Ve
         (*result)[i] = element[i];
     }
 
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t>) {
+        // the SIMD kernels are faster than skipping zero coefficients
+        if (GetNTTBackend() != SCALAR_NTT && n >= NTT_SIMD_MIN_RING_DIM) {
+            ForwardTransformToBitReverseInPlace(rootOfUnityTable, preconRootOfUnityTable, result);
+            return;
+        }
+    }
+
     uint32_t indexOmega, indexHi;
     NativeInteger preconOmega;
     IntType omega, omegaFactor, loVal, hiVal, zero(0);
@@ -537,6 +538,20 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
     auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
 
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t>) {
+        static_assert(sizeof(IntType) == sizeof(uint64_t), "SIMD NTT kernels require a plain 64-bit integer layout");
+        const auto backend{GetNTTBackend()};
+        if (backend != SCALAR_NTT && n >= NTT_SIMD_MIN_RING_DIM) {
+            InverseTransformFromBitReverseInPlaceSIMD(
+                backend, reinterpret_cast<uint64_t*>(&(*element)[0]),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), omega1Inv.ConvertToInt(), preconOmega1Inv.ConvertToInt(), n,
+                modulus.ConvertToInt());
+            return;
+        }
+    }
+
     // peeled off first stage for performance
     for (uint32_t i{0}; i < n; i += 2) {
         auto omega{rootOfUnityInverseTable[(i + n) >> 1]};
@@ -641,6 +656,209 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     return;
 }
 
+template <typename VecType>
+typename NTTTwiddleRegistry<VecType>::Reference NTTTwiddleRegistry<VecType>::Register(const IntType& rootOfUnity,
+                                                                                     usint cycloOrder,
+                                                                                     const IntType& modulus) {
+    Reference found = Find(modulus, cycloOrder);
+    if (found.GetHandle() != NTT_INVALID_HANDLE)
+        return found;
+
+    Storage& storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+
+    // another thread may have registered the same key while we were waiting for the lock. The registered entries
+    // cannot be freed while the lock is held, so they are read without references; entries that did not fit into
+    // the index can only be found by scanning all registered entries
+    uint32_t slot = IndexSlot(modulus, cycloOrder);
+    for (uint32_t i = 0; i < INDEX_SIZE; ++i, slot = (slot + 1) % INDEX_SIZE) {
+        uint32_t entry = storage.index[slot].load(std::memory_order_relaxed);
+        if (entry == 0)
+            break;
+        const Tables& tables = Get(entry - 1);
+        if (tables.modulus == modulus && tables.cycloOrder == cycloOrder) {
+            AddRef(entry - 1);
+            return Reference(entry - 1);
+        }
+    }
+    const uint32_t size = storage.size.load(std::memory_order_relaxed);
+    if (storage.indexOverflow) {
+        for (uint32_t h = 0; h < size; ++h) {
+            if (!GetEntry(h).registered)
+                continue;
+            const Tables& tables = Get(h);
+            if (tables.modulus == modulus && tables.cycloOrder == cycloOrder) {
+                AddRef(h);
+                return Reference(h);
+            }
+        }
+    }
+
+    if (storage.freeHandles.empty() && size >= MAX_CHUNKS * CHUNK_SIZE)
+        OPENFHE_THROW("NTT twiddle registry is full");
+
+    usint CycloOrderHf  = (cycloOrder >> 1);
+    auto tables         = std::make_unique<Tables>();
+    tables->modulus     = modulus;
+    tables->rootOfUnity = rootOfUnity;
+    tables->cycloOrder  = cycloOrder;
+
+    IntType x(1), xinv(1);
+    usint msb  = GetMSB(CycloOrderHf - 1);
+    IntType mu = modulus.ComputeMu();
+    VecType Table(CycloOrderHf, modulus);
+    VecType TableI(CycloOrderHf, modulus);
+    IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
+    usint iinv;
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        iinv         = ReverseBits(i, msb);
+        Table[iinv]  = x;
+        TableI[iinv] = xinv;
+        x.ModMulEq(rootOfUnity, modulus, mu);
+        xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
+    }
+
+    NativeInteger nativeModulus = modulus.ConvertToInt();
+    VecType preconTable(CycloOrderHf, nativeModulus);
+    VecType preconTableI(CycloOrderHf, nativeModulus);
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        preconTable[i]  = NativeInteger(Table[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+        preconTableI[i] = NativeInteger(TableI[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+    }
+
+    tables->rootOfUnityReverseTable              = std::move(Table);
+    tables->rootOfUnityInverseReverseTable       = std::move(TableI);
+    tables->rootOfUnityPreconReverseTable        = std::move(preconTable);
+    tables->rootOfUnityInversePreconReverseTable = std::move(preconTableI);
+    tables->cycloOrderInv                        = IntType(CycloOrderHf).ModInverse(modulus);
+    tables->preconCycloOrderInv =
+        NativeInteger(tables->cycloOrderInv.ConvertToInt()).PrepModMulConst(nativeModulus).ConvertToInt();
+
+    // a freed handle is recycled before a new one is handed out
+    uint32_t handle;
+    if (!storage.freeHandles.empty()) {
+        handle = storage.freeHandles.back();
+        storage.freeHandles.pop_back();
+    }
+    else {
+        handle      = size;
+        auto& chunk = storage.chunks[handle >> CHUNK_BITS];
+        if (chunk.load(std::memory_order_relaxed) == nullptr)
+            chunk.store(new Entry[CHUNK_SIZE], std::memory_order_release);
+        storage.size.store(handle + 1, std::memory_order_relaxed);
+    }
+
+    // publish the tables before the handle becomes visible through the index; one reference is held by the
+    // registry and one by the caller
+    Entry& entry = GetEntry(handle);
+    entry.tables.store(tables.release(), std::memory_order_relaxed);
+    entry.registered = true;
+    entry.refs.store(2, std::memory_order_release);
+
+    // index the key; when the index is crowded the entry is still reachable by its handle, and lookups by key
+    // fall back to the scan above
+    slot = IndexSlot(modulus, cycloOrder);
+    uint32_t i = 0;
+    for (; i < INDEX_SIZE / 2; ++i, slot = (slot + 1) % INDEX_SIZE) {
+        if (storage.index[slot].load(std::memory_order_relaxed) == 0) {
+            storage.index[slot].store(handle + 1, std::memory_order_release);
+            break;
+        }
+    }
+    if (i == INDEX_SIZE / 2)
+        storage.indexOverflow = true;
+    return Reference(handle);
+}
+
+template <typename VecType>
+typename NTTTwiddleRegistry<VecType>::Reference NTTTwiddleRegistry<VecType>::Find(const IntType& modulus,
+                                                                                 usint cycloOrder) {
+    Storage& storage = GetStorage();
+    uint32_t slot    = IndexSlot(modulus, cycloOrder);
+    for (uint32_t i = 0; i < INDEX_SIZE; ++i, slot = (slot + 1) % INDEX_SIZE) {
+        uint32_t entry = storage.index[slot].load(std::memory_order_acquire);
+        if (entry == 0)
+            return Reference();
+        // the handle may be freed and recycled meanwhile, so its tables are only read under a reference
+        if (!TryAddRef(entry - 1))
+            continue;
+        Reference reference(entry - 1);
+        const Tables& tables = Get(entry - 1);
+        if (tables.modulus == modulus && tables.cycloOrder == cycloOrder)
+            return reference;
+    }
+    return Reference();
+}
+
+template <typename VecType>
+void NTTTwiddleRegistry<VecType>::Reset() {
+    Storage& storage = GetStorage();
+    std::vector<uint32_t> registered;
+    {
+        std::lock_guard<std::mutex> lock(storage.mutex);
+        for (auto& slot : storage.index)
+            slot.store(0, std::memory_order_release);
+        storage.indexOverflow = false;
+        const uint32_t size   = storage.size.load(std::memory_order_relaxed);
+        for (uint32_t h = 0; h < size; ++h) {
+            Entry& entry = GetEntry(h);
+            if (entry.registered) {
+                entry.registered = false;
+                registered.push_back(h);
+            }
+        }
+    }
+    // the references of the registry are dropped without the lock, which freeing the last reference takes
+    for (uint32_t h : registered)
+        Release(h);
+}
+
+template <typename VecType>
+bool NTTTwiddleRegistry<VecType>::TryAddRef(uint32_t handle) {
+    auto& refs     = GetEntry(handle).refs;
+    uint32_t count = refs.load(std::memory_order_relaxed);
+    while (count != 0) {
+        if (refs.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+template <typename VecType>
+void NTTTwiddleRegistry<VecType>::Release(uint32_t handle) {
+    Entry& entry = GetEntry(handle);
+    if (entry.refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+    // no reference is left and none can be acquired anymore, so the tables are freed and the handle recycled
+    Storage& storage = GetStorage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    delete entry.tables.exchange(nullptr, std::memory_order_relaxed);
+    storage.freeHandles.push_back(handle);
+}
+
+template <typename VecType>
+uint32_t NTTTwiddleRegistry<VecType>::IndexSlot(const IntType& modulus, usint cycloOrder) {
+    size_t hash = HashPair::HashCombine(std::hash<uint64_t>{}(modulus.template ConvertToInt<uint64_t>()),
+                                        std::hash<usint>{}(cycloOrder));
+    return static_cast<uint32_t>(hash % INDEX_SIZE);
+}
+
+template <typename VecType>
+typename NTTTwiddleRegistry<VecType>::Storage& NTTTwiddleRegistry<VecType>::GetStorage() {
+    // never destroyed, so that parameter sets destroyed at exit can still release their references
+    static Storage* storage = new Storage();
+    return *storage;
+}
+
+template <typename VecType>
+typename NTTTwiddleRegistry<VecType>::Reference ChineseRemainderTransformFTTNat<VecType>::GetTables(
+    const IntType& rootOfUnity, const usint CycloOrder, const IntType& modulus) {
+    auto reference = NTTTwiddleRegistry<VecType>::Find(modulus, CycloOrder);
+    if (reference.GetHandle() == NTT_INVALID_HANDLE)
+        reference = NTTTwiddleRegistry<VecType>::Register(rootOfUnity, CycloOrder, modulus);
+    return reference;
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const IntType& rootOfUnity,
                                                                                    const usint CycloOrder,
@@ -658,15 +876,19 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPla
         OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element->GetModulus();
+    const auto reference = GetTables(rootOfUnity, CycloOrder, element->GetModulus());
+    ForwardTransformToBitReverseInPlace(reference.GetHandle(), element);
+}
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(uint32_t handle, VecType* element) {
+    const auto& tables = NTTTwiddleRegistry<VecType>::Get(handle);
+    if (element->GetLength() != (tables.cycloOrder >> 1)) {
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
     }
 
     NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
-        m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus], element);
+        tables.rootOfUnityReverseTable, tables.rootOfUnityPreconReverseTable, element);
 }
 
 template <typename VecType>
@@ -687,16 +909,11 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverse(cons
         OPENFHE_THROW("result size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element.GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto reference = GetTables(rootOfUnity, CycloOrder, element.GetModulus());
+    const auto& tables   = NTTTwiddleRegistry<VecType>::Get(reference.GetHandle());
 
     NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(
-        element, m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus],
-        result);
+        element, tables.rootOfUnityReverseTable, tables.rootOfUnityPreconReverseTable, result);
 
     return;
 }
@@ -718,18 +935,21 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInP
         OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element->GetModulus();
+    const auto reference = GetTables(rootOfUnity, CycloOrder, element->GetModulus());
+    InverseTransformFromBitReverseInPlace(reference.GetHandle(), element);
+}
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(uint32_t handle,
+                                                                                     VecType* element) {
+    const auto& tables = NTTTwiddleRegistry<VecType>::Get(handle);
+    if (element->GetLength() != (tables.cycloOrder >> 1)) {
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
     }
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb],
-        element);
+        tables.rootOfUnityInverseReverseTable, tables.rootOfUnityInversePreconReverseTable, tables.cycloOrderInv,
+        tables.preconCycloOrderInv, element);
 }
 
 template <typename VecType>
@@ -750,12 +970,8 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         OPENFHE_THROW("result size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element.GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto reference = GetTables(rootOfUnity, CycloOrder, element.GetModulus());
+    const auto& tables   = NTTTwiddleRegistry<VecType>::Get(reference.GetHandle());
 
     usint n = element.GetLength();
     result->SetModulus(element.GetModulus());
@@ -763,69 +979,155 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         (*result)[i] = element[i];
     }
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb], result);
+        tables.rootOfUnityInverseReverseTable, tables.rootOfUnityInversePreconReverseTable, tables.cycloOrderInv,
+        tables.preconCycloOrderInv, result);
 
     return;
 }
 
 template <typename VecType>
-void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
-                                                          const IntType& modulus) {
-    usint CycloOrderHf = (CycloOrder >> 1);
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("size of root of unity and number of elements not of same size");
+    }
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-#pragma omp critical
-        {
-            IntType x(1), xinv(1);
-            usint msb  = GetMSB(CycloOrderHf - 1);
-            IntType mu = modulus.ComputeMu();
-            VecType Table(CycloOrderHf, modulus);
-            VecType TableI(CycloOrderHf, modulus);
-            IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
-            usint iinv;
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                iinv         = ReverseBits(i, msb);
-                Table[iinv]  = x;
-                TableI[iinv] = xinv;
-                x.ModMulEq(rootOfUnity, modulus, mu);
-                xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
-            }
-            m_rootOfUnityReverseTableByModulus[modulus]        = Table;
-            m_rootOfUnityInverseReverseTableByModulus[modulus] = TableI;
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
 
-            VecType TableCOI(msb + 1, modulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                IntType coInv(IntType(1 << i).ModInverse(modulus));
-                TableCOI[i] = coInv;
-            }
-            m_cycloOrderInverseTableByModulus[modulus] = TableCOI;
+    std::vector<typename NTTTwiddleRegistry<VecType>::Reference> references;
+    std::vector<uint32_t> handles;
+    std::vector<VecType*> transformed;
+    references.reserve(elements.size());
+    handles.reserve(elements.size());
+    transformed.reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] == IntType(1) || rootOfUnity[i] == IntType(0))
+            continue;
+        references.push_back(GetTables(rootOfUnity[i], CycloOrder, elements[i]->GetModulus()));
+        handles.push_back(references.back().GetHandle());
+        transformed.push_back(elements[i]);
+    }
+    ForwardTransformToBitReverseInPlace(handles, transformed);
+}
 
-            NativeInteger nativeModulus = modulus.ConvertToInt();
-            VecType preconTable(CycloOrderHf, nativeModulus);
-            VecType preconTableI(CycloOrderHf, nativeModulus);
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<uint32_t>& handles, const std::vector<VecType*>& elements) {
+    if (handles.size() != elements.size()) {
+        OPENFHE_THROW("number of handles and number of elements not of same size");
+    }
 
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                preconTable[i] = NativeInteger(m_rootOfUnityReverseTableByModulus[modulus][i].ConvertToInt())
-                                     .PrepModMulConst(nativeModulus);
-                preconTableI[i] = NativeInteger(m_rootOfUnityInverseReverseTableByModulus[modulus][i].ConvertToInt())
-                                      .PrepModMulConst(nativeModulus);
-            }
+    size_t size{elements.size()};
+    if (size == 0)
+        return;
 
-            VecType preconTableCOI(msb + 1, nativeModulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                preconTableCOI[i] = NativeInteger(m_cycloOrderInverseTableByModulus[modulus][i].ConvertToInt())
-                                        .PrepModMulConst(nativeModulus);
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t>) {
+        const usint CycloOrderHf = elements[0]->GetLength();
+        if (CycloOrderHf >= NTT_SIMD_MIN_RING_DIM) {
+            std::vector<NTTBatchEntry> entries(size);
+            for (size_t i = 0; i < size; ++i) {
+                const auto& tables = NTTTwiddleRegistry<VecType>::Get(handles[i]);
+                VecType* element   = elements[i];
+                if (element->GetLength() != CycloOrderHf || (tables.cycloOrder >> 1) != CycloOrderHf) {
+                    OPENFHE_THROW("all elements must have the same size, equal to CyclotomicOrder / 2");
+                }
+                entries[i].element          = reinterpret_cast<uint64_t*>(&(*element)[0]);
+                entries[i].rootOfUnityTable = reinterpret_cast<const uint64_t*>(&tables.rootOfUnityReverseTable[0]);
+                entries[i].preconRootOfUnityTable =
+                    reinterpret_cast<const uint64_t*>(&tables.rootOfUnityPreconReverseTable[0]);
+                entries[i].modulus = tables.modulus.ConvertToInt();
             }
+            ForwardTransformToBitReverseInPlaceBatch(GetNTTBackend(), entries.data(), size, CycloOrderHf);
+            return;
+        }
+    }
+
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+        ForwardTransformToBitReverseInPlace(handles[i], elements[i]);
+    });
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("size of root of unity and number of elements not of same size");
+    }
+
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
 
-            m_rootOfUnityPreconReverseTableByModulus[modulus]        = preconTable;
-            m_rootOfUnityInversePreconReverseTableByModulus[modulus] = preconTableI;
-            m_cycloOrderInversePreconTableByModulus[modulus]         = preconTableCOI;
+    std::vector<typename NTTTwiddleRegistry<VecType>::Reference> references;
+    std::vector<uint32_t> handles;
+    std::vector<VecType*> transformed;
+    references.reserve(elements.size());
+    handles.reserve(elements.size());
+    transformed.reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] == IntType(1) || rootOfUnity[i] == IntType(0))
+            continue;
+        references.push_back(GetTables(rootOfUnity[i], CycloOrder, elements[i]->GetModulus()));
+        handles.push_back(references.back().GetHandle());
+        transformed.push_back(elements[i]);
+    }
+    InverseTransformFromBitReverseInPlace(handles, transformed);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const std::vector<uint32_t>& handles, const std::vector<VecType*>& elements) {
+    if (handles.size() != elements.size()) {
+        OPENFHE_THROW("number of handles and number of elements not of same size");
+    }
+
+    size_t size{elements.size()};
+    if (size == 0)
+        return;
+
+    if constexpr (std::is_same_v<typename IntType::Integer, uint64_t>) {
+        const usint CycloOrderHf = elements[0]->GetLength();
+        if (CycloOrderHf >= NTT_SIMD_MIN_RING_DIM) {
+            std::vector<NTTBatchEntry> entries(size);
+            for (size_t i = 0; i < size; ++i) {
+                const auto& tables = NTTTwiddleRegistry<VecType>::Get(handles[i]);
+                VecType* element   = elements[i];
+                if (element->GetLength() != CycloOrderHf || (tables.cycloOrder >> 1) != CycloOrderHf) {
+                    OPENFHE_THROW("all elements must have the same size, equal to CyclotomicOrder / 2");
+                }
+                const IntType& modulus{tables.modulus};
+                // omega[bitreversed(1)] * (n inverse), used in the final stage of the intt
+                auto omega1Inv{tables.rootOfUnityInverseReverseTable[1].ModMulFastConst(
+                    tables.cycloOrderInv, modulus, tables.preconCycloOrderInv)};
+
+                entries[i].element = reinterpret_cast<uint64_t*>(&(*element)[0]);
+                entries[i].rootOfUnityTable =
+                    reinterpret_cast<const uint64_t*>(&tables.rootOfUnityInverseReverseTable[0]);
+                entries[i].preconRootOfUnityTable =
+                    reinterpret_cast<const uint64_t*>(&tables.rootOfUnityInversePreconReverseTable[0]);
+                entries[i].modulus             = modulus.ConvertToInt();
+                entries[i].cycloOrderInv       = tables.cycloOrderInv.ConvertToInt();
+                entries[i].preconCycloOrderInv = tables.preconCycloOrderInv.ConvertToInt();
+                entries[i].omega1Inv           = omega1Inv.ConvertToInt();
+                entries[i].preconOmega1Inv     = omega1Inv.PrepModMulConst(modulus).ConvertToInt();
+            }
+            InverseTransformFromBitReverseInPlaceBatch(GetNTTBackend(), entries.data(), size, CycloOrderHf);
+            return;
         }
     }
+
+    OpenFHEParallelControls.ParallelFor(0, size, [&](size_t i) {
+        InverseTransformFromBitReverseInPlace(handles[i], elements[i]);
+    });
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
+                                                          const IntType& modulus) {
+    NTTTwiddleRegistry<VecType>::Register(rootOfUnity, CycloOrder, modulus);
 }
 
 template <typename VecType>
@@ -847,12 +1149,7 @@ void ChineseRemainderTransformFTTNat<VecType>::PreCompute(std::vector<IntType>&
 
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::Reset() {
-    m_cycloOrderInverseTableByModulus.clear();
-    m_cycloOrderInversePreconTableByModulus.clear();
-    m_rootOfUnityReverseTableByModulus.clear();
-    m_rootOfUnityInverseReverseTableByModulus.clear();
-    m_rootOfUnityPreconReverseTableByModulus.clear();
-    m_rootOfUnityInversePreconReverseTableByModulus.clear();
+    NTTTwiddleRegistry<VecType>::Reset();
 }
 
 template <typename VecType>
@@ -0,0 +1,172 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Runtime-dispatched SIMD kernels (AVX2/AVX-512F) and the cache-blocked multi-tower driver for the native negacyclic NTT
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+
+#include <cstdint>
+
+namespace intnat {
+
+/**
+ * @brief Instruction set used by the native NTT kernels.
+ * SCALAR_NTT selects the portable loops in NumberTheoreticTransformNat (and portable lazy butterflies
+ * in the batched transforms).
+ */
+enum NTTBackend {
+    SCALAR_NTT = 0,
+    AVX2_NTT,
+    AVX512_NTT,
+};
+
+/**
+ * Checks whether the kernels for a backend were compiled in and the CPU supports them.
+ * @param backend backend to check
+ * @return true if the backend can be selected
+ */
+bool IsNTTBackendSupported(NTTBackend backend);
+
+/**
+ * Returns the backend chosen automatically at startup (the widest supported instruction set)
+ */
+NTTBackend GetDefaultNTTBackend();
+
+/**
+ * Returns the backend currently used by NumberTheoreticTransformNat
+ */
+NTTBackend GetNTTBackend();
+
+/**
+ * Overrides the backend used by NumberTheoreticTransformNat (e.g., for benchmarking or testing).
+ * Throws if the backend is not supported on this machine.
+ * @param backend backend to use
+ */
+void SetNTTBackend(NTTBackend backend);
+
+/**
+ * Smallest ring dimension handled by the SIMD kernels; smaller transforms use the scalar loops.
+ */
+constexpr uint32_t NTT_SIMD_MIN_RING_DIM = 16;
+
+/**
+ * Number of coefficients (a power of two) that the cache-blocked schedule keeps hot at a time.
+ * Longer transforms run their outer stages over column strips of about this many coefficients and
+ * their inner stages block by block, instead of sweeping the whole vector once per stage.
+ */
+constexpr uint32_t NTT_CACHE_BLOCK_SIZE = 2048;
+
+/**
+ * @brief One vector (tower) of a batched transform together with its precomputed tables.
+ * The inverse-only fields are ignored by the forward transform.
+ */
+struct NTTBatchEntry {
+    uint64_t* element{nullptr};
+    const uint64_t* rootOfUnityTable{nullptr};
+    const uint64_t* preconRootOfUnityTable{nullptr};
+    uint64_t modulus{0};
+    uint64_t cycloOrderInv{0};
+    uint64_t preconCycloOrderInv{0};
+    uint64_t omega1Inv{0};
+    uint64_t preconOmega1Inv{0};
+};
+
+/**
+ * In-place forward negacyclic NTT (Cooley-Tukey, bit-reversed output) using Harvey's lazy butterflies.
+ * Intermediate values stay in [0, 4q); the output is fully reduced to [0, q), so the result is
+ * identical to the scalar transform.
+ *
+ * @param backend SIMD backend to use; must be supported and not SCALAR_NTT
+ * @param element coefficients in [0, q), length n
+ * @param rootOfUnityTable roots of unity in bit-reversed order
+ * @param preconRootOfUnityTable Shoup's precomputations for rootOfUnityTable
+ * @param n ring dimension, a power of two >= NTT_SIMD_MIN_RING_DIM
+ * @param modulus q < 2^62
+ */
+void ForwardTransformToBitReverseInPlaceSIMD(NTTBackend backend, uint64_t* element, const uint64_t* rootOfUnityTable,
+                                             const uint64_t* preconRootOfUnityTable, uint32_t n, uint64_t modulus);
+
+/**
+ * In-place inverse negacyclic NTT (Gentleman-Sande, bit-reversed input) using Harvey's lazy butterflies.
+ * The multiplication by n^{-1} is folded into the last stage; the output is fully reduced to [0, q).
+ *
+ * @param backend SIMD backend to use; must be supported and not SCALAR_NTT
+ * @param element coefficients in [0, q), length n
+ * @param rootOfUnityInverseTable inverse roots of unity in bit-reversed order
+ * @param preconRootOfUnityInverseTable Shoup's precomputations for rootOfUnityInverseTable
+ * @param cycloOrderInv n^{-1} mod q
+ * @param preconCycloOrderInv Shoup's precomputation for cycloOrderInv
+ * @param omega1Inv rootOfUnityInverseTable[1] * n^{-1} mod q
+ * @param preconOmega1Inv Shoup's precomputation for omega1Inv
+ * @param n ring dimension, a power of two >= NTT_SIMD_MIN_RING_DIM
+ * @param modulus q < 2^62
+ */
+void InverseTransformFromBitReverseInPlaceSIMD(NTTBackend backend, uint64_t* element,
+                                               const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t omega1Inv,
+                                               uint64_t preconOmega1Inv, uint32_t n, uint64_t modulus);
+
+/**
+ * In-place forward negacyclic NTTs of several vectors of the same length, e.g. all towers of one or
+ * more DCRTPolys. The work of all vectors is split into cache-sized column strips and row blocks
+ * (see NTT_CACHE_BLOCK_SIZE) that are distributed over the OpenMP threads together, so the towers
+ * share the threads even when there are fewer towers than threads. The result is identical to
+ * calling the single-vector transform on every entry.
+ *
+ * @param backend backend to use (SCALAR_NTT uses portable lazy butterflies); must be supported
+ * @param entries vectors with their modulus and forward tables (rootOfUnityTable, preconRootOfUnityTable)
+ * @param count number of entries
+ * @param n ring dimension, a power of two >= NTT_SIMD_MIN_RING_DIM
+ */
+void ForwardTransformToBitReverseInPlaceBatch(NTTBackend backend, const NTTBatchEntry* entries, uint32_t count,
+                                              uint32_t n);
+
+/**
+ * In-place inverse negacyclic NTTs of several vectors of the same length; the batched counterpart of
+ * InverseTransformFromBitReverseInPlaceSIMD().
+ *
+ * @param backend backend to use (SCALAR_NTT uses portable lazy butterflies); must be supported
+ * @param entries vectors with their modulus, inverse tables (in rootOfUnityTable, preconRootOfUnityTable)
+ * and the n^{-1} constants
+ * @param count number of entries
+ * @param n ring dimension, a power of two >= NTT_SIMD_MIN_RING_DIM
+ */
+void InverseTransformFromBitReverseInPlaceBatch(NTTBackend backend, const NTTBatchEntry* entries, uint32_t count,
+                                                uint32_t n);
+
+}  // namespace intnat
+
+#endif
@@ -40,7 +40,11 @@
 
 #include "utils/inttypes.h"
 
+#include <array>
+#include <atomic>
+#include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
@@ -241,6 +245,162 @@ public:
                                                VecType* element);
 };
 
+/// Handle of parameter sets without registered NTT tables
+constexpr uint32_t NTT_INVALID_HANDLE = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Process-wide registry of the precomputed tables (twiddle factors) for the power-of-two cyclotomic NTT.
+ *
+ * The tables of a (modulus, cyclotomic order) pair are identified by a small integer handle. Parameter sets
+ * (ILNativeParams) obtain a Reference to their tables once, when they are created, and the transforms then index
+ * the tables directly. Published tables are immutable, so Get() and Find() take no locks; only the registration
+ * and the freeing of tables are serialized. As with the former per-modulus maps, the first root of unity
+ * registered for a key defines the tables used by all later transforms with that key.
+ *
+ * The tables are reference counted: the registry holds one reference while the key is registered, and every
+ * Reference holds another one. Reset() drops the references of the registry, and the tables are freed and their
+ * handle is recycled when the last Reference goes away.
+ */
+template <typename VecType>
+class NTTTwiddleRegistry {
+    using IntType = typename VecType::Integer;
+
+public:
+    /**
+     * @brief Precomputed tables of one (modulus, cyclotomic order) pair.
+     */
+    struct Tables {
+        IntType modulus;
+        IntType rootOfUnity;
+        usint cycloOrder{0};
+        /// forward roots of unity in bit-reversed order (twiddle factors)
+        VecType rootOfUnityReverseTable;
+        /// inverse roots of unity in bit-reversed order (inverse twiddle factors)
+        VecType rootOfUnityInverseReverseTable;
+        /// Shoup's precomputations of rootOfUnityReverseTable
+        VecType rootOfUnityPreconReverseTable;
+        /// Shoup's precomputations of rootOfUnityInverseReverseTable
+        VecType rootOfUnityInversePreconReverseTable;
+        /// inverse of n = cycloOrder / 2 modulo q, and its Shoup's precomputation
+        IntType cycloOrderInv;
+        IntType preconCycloOrderInv;
+    };
+
+    /**
+     * @brief Counted reference to the tables of a handle, which keeps the tables alive.
+     */
+    class Reference {
+    public:
+        Reference() = default;
+
+        Reference(const Reference& rhs) : m_handle(rhs.m_handle) {
+            if (m_handle != NTT_INVALID_HANDLE)
+                NTTTwiddleRegistry::AddRef(m_handle);
+        }
+
+        Reference(Reference&& rhs) noexcept : m_handle(rhs.m_handle) {
+            rhs.m_handle = NTT_INVALID_HANDLE;
+        }
+
+        Reference& operator=(Reference rhs) noexcept {
+            std::swap(m_handle, rhs.m_handle);
+            return *this;
+        }
+
+        ~Reference() {
+            if (m_handle != NTT_INVALID_HANDLE)
+                NTTTwiddleRegistry::Release(m_handle);
+        }
+
+        /**
+         * @return the handle to pass to Get(), or NTT_INVALID_HANDLE for an empty reference
+         */
+        uint32_t GetHandle() const {
+            return m_handle;
+        }
+
+    private:
+        friend class NTTTwiddleRegistry;
+        // takes over a reference that is already counted
+        explicit Reference(uint32_t handle) : m_handle(handle) {}
+
+        uint32_t m_handle{NTT_INVALID_HANDLE};
+    };
+
+    /**
+     * Returns a reference to the tables for (modulus, cycloOrder), computing them from rootOfUnity first if
+     * they are not registered yet. Safe to call from several threads.
+     *
+     * @param &rootOfUnity is the 2n-th root of unity in Z_q.
+     * @param cycloOrder is 2n, a power of two.
+     * @param &modulus is q, the prime modulus.
+     * @return the reference whose handle is passed to Get()
+     */
+    static Reference Register(const IntType& rootOfUnity, usint cycloOrder, const IntType& modulus);
+
+    /**
+     * Lock-free lookup of the tables of (modulus, cycloOrder).
+     * @return the reference, or an empty reference if no tables are registered for the key
+     */
+    static Reference Find(const IntType& modulus, usint cycloOrder);
+
+    /**
+     * Lock-free access to the tables of a handle. The caller must hold a Reference to the handle.
+     */
+    static const Tables& Get(uint32_t handle) {
+        return *GetEntry(handle).tables.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Forgets all keys, so the next transforms with any key compute fresh tables. The tables that no Reference
+     * holds are freed; the others stay valid until their last Reference goes away.
+     */
+    static void Reset();
+
+private:
+    static constexpr uint32_t CHUNK_BITS = 10;
+    static constexpr uint32_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr uint32_t MAX_CHUNKS = 64;
+    // open-addressing index from (modulus, cyclotomic order) to handle + 1 (0 marks an empty slot)
+    static constexpr uint32_t INDEX_SIZE = 1 << 12;
+
+    // the entries never move or go away, only their tables are freed and replaced when the handle is recycled
+    struct Entry {
+        std::atomic<const Tables*> tables{nullptr};
+        // number of references; 0 while the handle is free
+        std::atomic<uint32_t> refs{0};
+        // the registry holds a reference to the entry, guarded by the mutex
+        bool registered{false};
+    };
+
+    struct Storage {
+        std::mutex mutex;
+        // number of handles ever handed out
+        std::atomic<uint32_t> size{0};
+        // handles whose tables were freed, guarded by the mutex
+        std::vector<uint32_t> freeHandles;
+        // some registered entries did not fit into the index, guarded by the mutex
+        bool indexOverflow{false};
+        std::array<std::atomic<Entry*>, MAX_CHUNKS> chunks{};
+        std::array<std::atomic<uint32_t>, INDEX_SIZE> index{};
+    };
+
+    static Entry& GetEntry(uint32_t handle) {
+        return GetStorage().chunks[handle >> CHUNK_BITS].load(std::memory_order_acquire)[handle & (CHUNK_SIZE - 1)];
+    }
+
+    static void AddRef(uint32_t handle) {
+        GetEntry(handle).refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // acquires a reference unless the tables of the handle were freed
+    static bool TryAddRef(uint32_t handle);
+    static void Release(uint32_t handle);
+
+    static Storage& GetStorage();
+    static uint32_t IndexSlot(const IntType& modulus, usint cycloOrder);
+};
+
 /**
  * @brief Golden Chinese Remainder Transform FFT implementation.
  */
@@ -283,6 +443,16 @@ public:
    */
     void ForwardTransformToBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * In-place Forward Transform in the ring Z_q[X]/(X^n+1) using the tables registered under \p handle
+   * (see NTTTwiddleRegistry and ILParamsImpl::GetNTTHandle()); no lookup by modulus is needed.
+   *
+   * @param handle is the handle of the tables in NTTTwiddleRegistry.
+   * @param[in,out] &element is the input to the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlace(uint32_t handle, VecType* element);
+
     /**
    * Copies \p element into \p result and calls NumberTheoreticTransform::InverseTransformFromBitReverseInPlace()
    *
@@ -318,6 +488,63 @@ public:
    */
     void InverseTransformFromBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * In-place Inverse Transform in the ring Z_q[X]/(X^n+1) using the tables registered under \p handle.
+   *
+   * @param handle is the handle of the tables in NTTTwiddleRegistry.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlace(uint32_t handle, VecType* element);
+
+    /**
+   * In-place Forward Transform of several vectors (e.g., all towers of one or more DCRTPolys) in the
+   * ring Z_qi[X]/(X^n+1). For 64-bit native integers the transforms are fused: the work of all vectors
+   * is cache-blocked and spread over the threads together (see ForwardTransformToBitReverseInPlaceBatch()).
+   * The result is the same as calling ForwardTransformToBitReverseInPlace() on every vector.
+   *
+   * @param &rootOfUnity are the 2n-th roots of unity, one per vector.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param &elements are the distinct vectors to transform in place; the moduli may differ.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlace(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                             const std::vector<VecType*>& elements);
+
+    /**
+   * In-place Forward Transform of several vectors using the tables registered under \p handles.
+   *
+   * @param &handles are the handles of the tables in NTTTwiddleRegistry, one per vector.
+   * @param &elements are the distinct vectors to transform in place, all of the same length.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlace(const std::vector<uint32_t>& handles,
+                                             const std::vector<VecType*>& elements);
+
+    /**
+   * In-place Inverse Transform of several vectors in the ring Z_qi[X]/(X^n+1); the fused counterpart
+   * of InverseTransformFromBitReverseInPlace().
+   *
+   * @param &rootOfUnity are the 2n-th roots of unity, one per vector.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param &elements are the distinct vectors to transform in place; the moduli may differ.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlace(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                               const std::vector<VecType*>& elements);
+
+    /**
+   * In-place Inverse Transform of several vectors using the tables registered under \p handles.
+   *
+   * @param &handles are the handles of the tables in NTTTwiddleRegistry, one per vector.
+   * @param &elements are the distinct vectors to transform in place, all of the same length.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlace(const std::vector<uint32_t>& handles,
+                                               const std::vector<VecType*>& elements);
+
     /**
    * Precomputation of root of unity tables for transforms in the ring
    * Z_q[X]/(X^n+1)
@@ -347,25 +574,12 @@ public:
    */
     void Reset();
 
-    /// map to store the cyclo order inverse with modulus as a key
-    /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
-    static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
-
-    /// map to store the cyclo order inverse preconditioned with modulus as a key
-    /// Shoup's precomputation of above #m_cycloOrderInverseTableByModulus
-    static std::map<IntType, VecType> m_cycloOrderInversePreconTableByModulus;
-
-    /// map to store the forward roots of Unity for NTT, with bits reversed, with modulus as a key (aka twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityReverseTableByModulus;
-
-    /// map to store inverse roots of unity for iNTT, with bits reversed, with modulus as a key (aka inverse twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityInverseReverseTableByModulus;
-
-    /// map to store Shoup's precomputations of forward roots of unity for NTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityPreconReverseTableByModulus;
-
-    /// map to store Shoup's precomputations of inverse rou for iNTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityInversePreconReverseTableByModulus;
+    /**
+   * Returns a reference to the tables for (modulus, CycloOrder) in NTTTwiddleRegistry, registering them
+   * if needed.
+   */
+    static typename NTTTwiddleRegistry<VecType>::Reference GetTables(const IntType& rootOfUnity,
+                                                                     const usint CycloOrder, const IntType& modulus);
 };
 
 // struct used as a key in BlueStein transform
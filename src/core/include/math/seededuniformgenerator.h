@@ -0,0 +1,83 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides deterministic generation of uniform values mod q from a short seed. It is used to regenerate the
+  uniformly random halves of keys and ciphertexts instead of storing them
+ */
+
+#ifndef LBCRYPTO_INC_MATH_SEEDEDUNIFORMGENERATOR_H_
+#define LBCRYPTO_INC_MATH_SEEDEDUNIFORMGENERATOR_H_
+
+#include "math/hal/basicint.h"
+#include "math/math-hal.h"
+
+#include <array>
+#include <cstdint>
+
+namespace lbcrypto {
+
+/**
+ * @brief Expands a 256-bit seed into uniformly distributed vectors over Zq.
+ *
+ * The expansion always uses the built-in BLAKE2 engine (independently of the PRNG selected with
+ * PseudoRandomNumberGenerator::InitPRNGEngine()), so the same seed and stream id reproduce the same vector on any
+ * machine. Each (seed, streamId) pair is an independent stream; callers encode e.g. the digit and the tower index into
+ * streamId so that every RNS tower can be regenerated on its own and in any order.
+ */
+class SeededUniformGenerator {
+public:
+    static constexpr uint32_t SEED_WORDS{8};
+    using SeedType = std::array<uint32_t, SEED_WORDS>;
+
+    /**
+   * @brief Draws a fresh seed from the global PRNG
+   */
+    static SeedType GenerateSeed();
+
+    /**
+   * @brief Fills v with uniform values mod v.GetModulus() from the stream (seed, streamId)
+   * @param seed the 256-bit seed
+   * @param streamId identifier of the stream
+   * @param v the vector to fill; its length and modulus must be set
+   */
+    static void FillVector(const SeedType& seed, uint64_t streamId, NativeVector& v);
+
+    /**
+   * @brief Returns a vector of the given size with uniform values mod modulus from the stream (seed, streamId)
+   */
+    static NativeVector GenerateVector(const SeedType& seed, uint64_t streamId, uint32_t size,
+                                       const NativeInteger& modulus);
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_INC_MATH_SEEDEDUNIFORMGENERATOR_H_
@@ -0,0 +1,116 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Read-only memory mapping of a file and a stream buffer over a memory range
+ */
+
+#ifndef LBCRYPTO_UTILS_MAPPEDFILE_H
+#define LBCRYPTO_UTILS_MAPPEDFILE_H
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief A file mapped read-only into memory. The pages are read from disk on first access and can be dropped
+ * again by the OS under memory pressure, so mapping a large file costs address space but not resident memory.
+ * On platforms without mmap the whole file is read into memory instead.
+ */
+class MappedFile {
+public:
+    /**
+     * Maps a file; throws if the file cannot be opened or mapped.
+     * @param path is the path of the file.
+     * @param writable maps the file copy-on-write, so that the mapped memory can be modified; the changes never
+     * reach the file.
+     */
+    explicit MappedFile(const std::string& path, bool writable = false);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* GetData() const {
+        return m_data;
+    }
+
+    /// @return the mapped memory of a file mapped as writable
+    char* GetWritableData() const;
+
+    size_t GetSize() const {
+        return m_size;
+    }
+
+    const std::string& GetPath() const {
+        return m_path;
+    }
+
+    /**
+     * Asks the OS to start reading a range of the file in the background.
+     */
+    void WillNeed(size_t offset, size_t size) const;
+
+    /**
+     * Tells the OS that a range of the file is not needed anymore, so that its pages can be released.
+     */
+    void DontNeed(size_t offset, size_t size) const;
+
+private:
+    std::string m_path;
+    const char* m_data{nullptr};
+    size_t m_size{0};
+    // contents of the file when it could not be mapped
+    std::vector<char> m_buffer;
+    bool m_mapped{false};
+    bool m_writable{false};
+};
+
+/**
+ * @brief Read-only stream buffer over a memory range, used to deserialize objects from a mapped file with
+ * std::istream without copying the range first.
+ */
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const char* data, size_t size);
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_MAPPEDFILE_H
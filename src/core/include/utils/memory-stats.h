@@ -0,0 +1,152 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Opt-in instrumentation of the memory allocated and copied by native vectors and DCRT polynomials
+ */
+
+#ifndef LBCRYPTO_UTILS_MEMORY_STATS_H
+#define LBCRYPTO_UTILS_MEMORY_STATS_H
+
+#include "config_core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace lbcrypto {
+
+/**
+ * @brief Counters of the polynomial memory traffic, either since the last MemoryProfiler::Reset() or within the
+ * calls of one high-level API function.
+ */
+struct MemoryStats {
+    /// number of calls attributed to the counters (0 for the totals)
+    uint64_t calls{0};
+    /// blocks allocated for native vectors and tower buffers
+    uint64_t allocations{0};
+    uint64_t allocatedBytes{0};
+    /// deep copies of native vectors (copy construction and copy assignment)
+    uint64_t vectorCopies{0};
+    uint64_t vectorCopiedBytes{0};
+    /// moves of native vectors
+    uint64_t vectorMoves{0};
+    /// deep copies and moves of DCRT polynomials
+    uint64_t polyCopies{0};
+    uint64_t polyMoves{0};
+    /// largest number of bytes held by native vectors and tower buffers at any time in the process (totals only;
+    /// always 0 in the counters of a function)
+    uint64_t peakLiveBytes{0};
+
+    std::string ToJSON() const;
+};
+
+/**
+ * @brief Global sink of the instrumentation hooks.
+ *
+ * The hooks (OPENFHE_MEMSTATS_* below) are compiled only when the library is configured with WITH_MEMORY_STATS=ON;
+ * otherwise every counter stays at zero. All counters are process-global: there is no per-thread or per-call
+ * accounting. A call is attributed the difference of the global counters between its entry and its exit, which
+ * includes the work of the OpenMP threads it spawns but also that of any other thread running at the same time,
+ * so the attribution is exact only when one instrumented call runs at a time. For the same reason no peak is
+ * recorded per call; the peak of live bytes is only available in the totals.
+ */
+class MemoryProfiler {
+public:
+    static void RecordAllocation(size_t bytes) noexcept;
+    static void RecordDeallocation(size_t bytes) noexcept;
+    static void RecordVectorCopy(size_t bytes) noexcept;
+    static void RecordVectorMove() noexcept;
+    static void RecordPolyCopy() noexcept;
+    static void RecordPolyMove() noexcept;
+
+    /// @return the counters since the last Reset()
+    static MemoryStats GetTotals();
+
+    /// @return the number of bytes currently held by native vectors and tower buffers
+    static uint64_t GetLiveBytes();
+
+    /**
+     * Returns the counters accumulated over the calls of a high-level API function.
+     * @param name is the name of the function, e.g. "EvalMult".
+     */
+    static MemoryStats GetScope(const std::string& name);
+
+    /// @return the counters of every instrumented function called since the last Reset()
+    static std::map<std::string, MemoryStats> GetScopes();
+
+    /// Clears all counters except the number of live bytes; must not be called during an instrumented call
+    static void Reset();
+
+    /// @return {"total": {...}, "scopes": {"<function>": {...}, ...}}
+    static std::string ToJSON();
+};
+
+/**
+ * @brief Attributes the memory traffic of its lifetime to a high-level API function. Only the outermost scope of a
+ * thread records anything, so EvalMult called from EvalBootstrap is accounted to EvalBootstrap.
+ */
+class MemoryStatsScope {
+public:
+    explicit MemoryStatsScope(const char* name);
+    ~MemoryStatsScope();
+
+    MemoryStatsScope(const MemoryStatsScope&)            = delete;
+    MemoryStatsScope& operator=(const MemoryStatsScope&) = delete;
+
+private:
+    const char* m_name;
+    bool m_outermost;
+    MemoryStats m_entry;
+};
+
+}  // namespace lbcrypto
+
+#ifdef WITH_MEMORY_STATS
+    #define OPENFHE_MEMSTATS_ALLOC(bytes)       lbcrypto::MemoryProfiler::RecordAllocation(bytes)
+    #define OPENFHE_MEMSTATS_FREE(bytes)        lbcrypto::MemoryProfiler::RecordDeallocation(bytes)
+    #define OPENFHE_MEMSTATS_VECTOR_COPY(bytes) lbcrypto::MemoryProfiler::RecordVectorCopy(bytes)
+    #define OPENFHE_MEMSTATS_VECTOR_MOVE()      lbcrypto::MemoryProfiler::RecordVectorMove()
+    #define OPENFHE_MEMSTATS_POLY_COPY()        lbcrypto::MemoryProfiler::RecordPolyCopy()
+    #define OPENFHE_MEMSTATS_POLY_MOVE()        lbcrypto::MemoryProfiler::RecordPolyMove()
+    #define OPENFHE_MEMSTATS_SCOPE()            lbcrypto::MemoryStatsScope memStatsScope(__func__)
+#else
+    #define OPENFHE_MEMSTATS_ALLOC(bytes)
+    #define OPENFHE_MEMSTATS_FREE(bytes)
+    #define OPENFHE_MEMSTATS_VECTOR_COPY(bytes)
+    #define OPENFHE_MEMSTATS_VECTOR_MOVE()
+    #define OPENFHE_MEMSTATS_POLY_COPY()
+    #define OPENFHE_MEMSTATS_POLY_MOVE()
+    #define OPENFHE_MEMSTATS_SCOPE()
+#endif
+
+#endif  // LBCRYPTO_UTILS_MEMORY_STATS_H
@@ -0,0 +1,123 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  NUMA topology detection, thread binding and page interleaving (Linux only, no external library)
+ */
+
+#ifndef LBCRYPTO_UTILS_NUMA_H
+#define LBCRYPTO_UTILS_NUMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief NUMA nodes of the machine and the CPUs that belong to each of them, as reported by
+ * /sys/devices/system/node. A machine without that directory (or a platform other than Linux) is reported as a
+ * single node holding all CPUs.
+ */
+class NumaTopology {
+public:
+    /// @return the topology of the machine, read once on first use
+    static const NumaTopology& GetInstance();
+
+    /**
+     * Reads the topology from a sysfs node directory.
+     * @param nodeDir is the directory with one node<N>/cpulist file per node.
+     */
+    explicit NumaTopology(const std::string& nodeDir);
+
+    uint32_t GetNumNodes() const {
+        return static_cast<uint32_t>(m_nodeCPUs.size());
+    }
+
+    /// @return the CPUs of a node (empty for a memory-only node)
+    const std::vector<uint32_t>& GetNodeCPUs(uint32_t node) const {
+        return m_nodeCPUs.at(node);
+    }
+
+    /// @return the sysfs index of a node, used in memory policies
+    uint32_t GetNodeId(uint32_t node) const {
+        return m_nodeIds.at(node);
+    }
+
+    /// @return the node of a CPU, 0 for an unknown CPU
+    uint32_t GetNodeOfCPU(uint32_t cpu) const;
+
+    /**
+     * Parses a cpulist such as "0-3,8,10-11".
+     * @return the CPUs in the list, in ascending order
+     */
+    static std::vector<uint32_t> ParseCPUList(const std::string& list);
+
+private:
+    std::vector<uint32_t> m_nodeIds;
+    std::vector<std::vector<uint32_t>> m_nodeCPUs;
+};
+
+/**
+ * Restricts the calling thread to the CPUs of a NUMA node.
+ * @return false if the binding is not supported or was refused
+ */
+bool BindCurrentThreadToNode(uint32_t node);
+
+/**
+ * Lets the calling thread run on all the CPUs the process started with again.
+ */
+void UnbindCurrentThread();
+
+/**
+ * Spreads the pages of a memory range round-robin over all NUMA nodes and moves the pages that were already
+ * touched. Only the pages that lie entirely within the range are changed, so neighbouring allocations sharing its
+ * first or last page keep their placement.
+ * @return false if the range covers no full page or the memory policy could not be applied
+ */
+bool NumaInterleave(const void* p, size_t bytes);
+
+/**
+ * Interleaves the coefficients of all towers of a double-CRT polynomial over the NUMA nodes.
+ */
+template <typename DCRTPolyType>
+void NumaInterleaveTowers(const DCRTPolyType& poly) {
+    for (const auto& tower : poly.GetAllElements()) {
+        if (!tower.IsEmpty())
+            NumaInterleave(&tower.GetValues()[0], tower.GetLength() * sizeof(tower.GetValues()[0]));
+    }
+}
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_NUMA_H
@@ -36,12 +36,27 @@
 #ifndef SRC_CORE_LIB_UTILS_PARALLEL_H_
 #define SRC_CORE_LIB_UTILS_PARALLEL_H_
 
+#include "utils/task-pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
 #ifdef PARALLEL
     #include <omp.h>
 #endif
 
 namespace lbcrypto {
 
+/**
+ * @brief Execution layers of the parallel loops run through ParallelControls::ParallelFor()
+ */
+enum ParallelBackend {
+    OPENMP_BACKEND    = 0,  // Default value, every loop is an OpenMP parallel region
+    TASK_POOL_BACKEND = 1,  // loops are split into tasks run by the work-stealing TaskPool
+};
+
 class ParallelControls {
 public:
     // @Brief CTOR, enables parallel operations as default
@@ -51,25 +66,121 @@ public:
     ParallelControls() {
 #ifdef PARALLEL
         machineThreads = omp_get_max_threads();
+        taskMachineThreads = machineThreads;
         Enable();
             // omp_set_dynamic(0);
             // omp_set_nested(0);
             // omp_set_max_active_levels(1);
+#else
+        // the task pool does not depend on OpenMP
+        taskMachineThreads = std::max(1U, std::thread::hardware_concurrency());
+        Enable();
 #endif
     }
 
     // @Brief Enable() enables parallel operation
-    void Enable() const {
+    void Enable() {
 #ifdef PARALLEL
         omp_set_num_threads(machineThreads);
 #endif
+        taskThreads.store(taskMachineThreads, std::memory_order_relaxed);
     }
 
     // @Brief Disable() disables parallel operation
-    void Disable() const {
+    void Disable() {
 #ifdef PARALLEL
         omp_set_num_threads(1);
 #endif
+        taskThreads.store(1, std::memory_order_relaxed);
+    }
+
+    // @Brief selects the execution layer of ParallelFor()
+    void SetBackend(ParallelBackend b) {
+        backend.store(b, std::memory_order_relaxed);
+    }
+
+    ParallelBackend GetBackend() const {
+        return backend.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @Brief runs body(i) for every i in [begin, end) in parallel.
+     * With OPENMP_BACKEND this is a "parallel for" region of GetThreadLimit(end - begin) threads. With
+     * TASK_POOL_BACKEND the range is split into at most as many tasks as there are enabled threads; nested calls
+     * and calls from several threads then share the workers of the TaskPool instead of opening nested regions.
+     */
+    template <typename Func>
+    void ParallelFor(size_t begin, size_t end, Func&& body) const {
+        if (begin >= end)
+            return;
+        if (GetBackend() == TASK_POOL_BACKEND) {
+            auto range = [&body](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i)
+                    body(i);
+            };
+            TaskPool::GetInstance().RunRange(begin, end, taskThreads.load(std::memory_order_relaxed), range);
+            return;
+        }
+#pragma omp parallel for num_threads(GetThreadLimit(static_cast<int>(end - begin)))
+        for (size_t i = begin; i < end; ++i)
+            body(i);
+    }
+
+    /**
+     * @Brief runs body(i, first, last) over a rows x cols iteration space, e.g. towers x coefficients.
+     * When there are fewer rows than threads, every row is split into GetBlocksPerRow(rows, cols) blocks of
+     * consecutive columns so the idle threads get work; otherwise body sees whole rows, as with ParallelFor().
+     */
+    template <typename Func>
+    void ParallelFor2D(size_t rows, size_t cols, Func&& body) const {
+        const size_t blocks{GetBlocksPerRow(rows, cols)};
+        if (blocks <= 1) {
+            ParallelFor(0, rows, [&](size_t i) {
+                body(i, size_t(0), cols);
+            });
+            return;
+        }
+        // block boundaries are kept on multiples of 8 coefficients (one cache line of 64-bit words)
+        const size_t width{((cols + blocks - 1) / blocks + 7) & ~size_t(7)};
+        ParallelFor(0, rows * blocks, [&](size_t task) {
+            const size_t first{(task % blocks) * width};
+            if (first < cols)
+                body(task / blocks, first, std::min(first + width, cols));
+        });
+    }
+
+    /**
+     * @Brief number of column blocks ParallelFor2D() splits each row into: 1 when rows alone keep the enabled
+     * threads busy, otherwise enough blocks to cover the threads without going below GetMinBlockSize() columns
+     */
+    size_t GetBlocksPerRow(size_t rows, size_t cols) const {
+        const size_t minBlock{GetMinBlockSize()};
+        const size_t threads{static_cast<size_t>(GetActiveThreads())};
+        if (minBlock == 0 || rows == 0 || rows >= threads)
+            return 1;
+        const size_t blocks{std::min((threads + rows - 1) / rows, cols / minBlock)};
+        return blocks > 1 ? blocks : 1;
+    }
+
+    // @Brief sets the smallest number of columns (coefficients) ParallelFor2D() puts in a block; 0 disables the split
+    void SetMinBlockSize(size_t n) {
+        minBlockSize.store(n, std::memory_order_relaxed);
+    }
+
+    size_t GetMinBlockSize() const {
+        return minBlockSize.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @Brief NUMA mode: binds the OpenMP threads and the TaskPool workers to the NUMA nodes in contiguous groups
+     * (thread t of T runs on node t * nodes / T), and makes the evaluation keys and bootstrapping precomputations
+     * stored from then on spread their pages over all nodes (see NumaInterleave()). Disabling it unbinds the threads.
+     * Only the OpenMP threads existing at the time are bound; OMP_PLACES/OMP_PROC_BIND take precedence if set.
+     */
+    void SetNumaMode(bool enable);
+
+    bool GetNumaMode() const {
+        return numaMode.load(std::memory_order_relaxed);
     }
 
     int GetMachineThreads() const {
@@ -123,10 +234,29 @@ public:
         // set number of thread, but limit to the system set number of machine threads...
         omp_set_num_threads(nthreads > machineThreads ? machineThreads : nthreads);
 #endif
+        taskThreads.store(nthreads > taskMachineThreads ? taskMachineThreads : nthreads, std::memory_order_relaxed);
     }
 
 private:
+    // threads a loop run by ParallelFor() currently gets with the selected backend
+    int GetActiveThreads() const {
+        if (GetBackend() == TASK_POOL_BACKEND)
+            return taskThreads.load(std::memory_order_relaxed);
+#ifdef PARALLEL
+        return omp_in_parallel() ? 1 : omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
     int machineThreads{1};
+    int taskMachineThreads{1};
+    // number of tasks a loop is split into by the task pool
+    std::atomic<int> taskThreads{1};
+    std::atomic<ParallelBackend> backend{OPENMP_BACKEND};
+    // default keeps a block of 64-bit coefficients at 16 KB, well above the cost of scheduling it
+    std::atomic<size_t> minBlockSize{2048};
+    std::atomic<bool> numaMode{false};
 };
 
 extern ParallelControls OpenFHEParallelControls;
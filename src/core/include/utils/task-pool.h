@@ -0,0 +1,124 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Work-stealing pool of threads used by the task backend of ParallelControls
+ */
+
+#ifndef LBCRYPTO_UTILS_TASK_POOL_H
+#define LBCRYPTO_UTILS_TASK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Pool of worker threads executing chunks of parallel loops.
+ *
+ * Every worker owns a deque of tasks: it takes its own tasks from the back and steals from the front of the deques
+ * of the other workers when it runs out of work. A loop started by a worker (a nested loop) queues its chunks on the
+ * deque of that worker; a loop started by any other thread queues them on a shared queue. The thread starting a
+ * loop executes tasks too until all chunks of its loop have completed, so nested loops and loops started
+ * concurrently by several threads share the same workers instead of spawning more threads.
+ */
+class TaskPool {
+public:
+    using RangeFunction = void (*)(void* context, size_t begin, size_t end);
+
+    /// @return the pool of the process, started on first use with one worker less than the number of threads
+    static TaskPool& GetInstance();
+
+    TaskPool(const TaskPool&)            = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * Runs body(begin, end) over a range split into consecutive chunks and waits for all of them.
+     * @param begin is the first index of the range.
+     * @param end is the index past the last one.
+     * @param maxTasks is the largest number of chunks.
+     * @param body is called once per chunk.
+     * @param context is passed to body.
+     * The first exception thrown by a chunk is rethrown once all chunks have completed.
+     */
+    void RunRange(size_t begin, size_t end, size_t maxTasks, RangeFunction body, void* context);
+
+    template <typename Func>
+    void RunRange(size_t begin, size_t end, size_t maxTasks, Func& body) {
+        RunRange(
+            begin, end, maxTasks, [](void* f, size_t first, size_t last) { (*static_cast<Func*>(f))(first, last); },
+            &body);
+    }
+
+    /// @return the number of worker threads (the threads starting loops come on top)
+    uint32_t GetNumWorkers() const {
+        return static_cast<uint32_t>(m_threads.size());
+    }
+
+    /**
+     * Binds the workers to NUMA nodes (see NumaTopology). Every worker applies its entry before it picks its next
+     * task; a negative entry lets the worker run on all CPUs of the process again.
+     * @param nodes has one node per worker.
+     */
+    void SetWorkerNodes(const std::vector<int32_t>& nodes);
+
+private:
+    struct Job;
+    struct Task;
+    struct Queue;
+
+    explicit TaskPool(uint32_t workers);
+
+    bool RunOne(int32_t self);
+    void WorkerLoop(int32_t self);
+    void ApplyWorkerNode(int32_t self, uint32_t& epoch);
+
+    // deques of the workers followed by the shared queue of the other threads
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_queued{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    // node of every worker, changed together with the epoch
+    std::mutex m_nodeMutex;
+    std::vector<int32_t> m_workerNodes;
+    std::atomic<uint32_t> m_nodeEpoch{0};
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_TASK_POOL_H
@@ -0,0 +1,641 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Runtime-dispatched SIMD kernels (AVX2/AVX-512F) and the cache-blocked driver for the native negacyclic NTT
+ */
+
+#include "math/hal/intnat/transformnat-simd.h"
+
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__EMSCRIPTEN__)
+    #define NTT_SIMD_X86 1
+    // GCC 12 reports the _mm512_undefined_*() placeholders inside the AVX-512 intrinsic headers as
+    // maybe-uninitialized once they are inlined into a target("avx512f") function
+    #if !defined(__clang__)
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+
+namespace {
+
+// ---------------------------------------------------------------------------------------------
+// Every kernel works on a "stage slice": for the butterfly groups i in [iBegin, iEnd) of the stage
+// with m groups of half-size t, it processes the segments x = a + 2*i*t + c, y = x + t of length len
+// for c = col, col + stride, ... < t. A whole stage is (0, m, 0, t, t); the cache-blocked driver
+// below uses narrower slices. Each butterfly performs exactly the same operations in any slicing,
+// so every schedule produces the same (bit-exact) result.
+// ---------------------------------------------------------------------------------------------
+using StageKernel = void (*)(uint64_t* a, const uint64_t* w, const uint64_t* wp, uint32_t m, uint32_t t,
+                             uint32_t iBegin, uint32_t iEnd, uint32_t col, uint32_t len, uint32_t stride, uint64_t q);
+// last inverse stage (m = 1) with the multiplication by n^{-1} folded in
+using LastStageKernel = void (*)(uint64_t* a, uint32_t t, uint32_t col, uint32_t len, uint32_t stride, uint64_t nInv,
+                                 uint64_t nInvPrecon, uint64_t w1nInv, uint64_t w1nInvPrecon, uint64_t q);
+// reduction from [0, 4q) to [0, q) after the last forward stage
+using ReduceKernel = void (*)(uint64_t* a, uint32_t len, uint64_t q);
+
+struct NTTKernels {
+    StageKernel forwardStage;
+    StageKernel inverseStage;
+    LastStageKernel inverseLastStage;
+    ReduceKernel reduce;
+};
+
+// ---------------------------------------------------------------------------------------------
+// Portable lazy butterflies, used by SCALAR_NTT and for the stages narrower than a vector.
+// x * w mod q computed with Shoup's precomputation wp = floor(w * 2^64 / q); the result is in [0, 2q)
+// for any 64-bit x.
+// ---------------------------------------------------------------------------------------------
+inline uint64_t MulHi64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+    uint64_t aLo{a & 0xffffffff}, aHi{a >> 32}, bLo{b & 0xffffffff}, bHi{b >> 32};
+    uint64_t t{aHi * bLo + ((aLo * bLo) >> 32)};
+    uint64_t u{aLo * bHi + (t & 0xffffffff)};
+    return aHi * bHi + (t >> 32) + (u >> 32);
+#endif
+}
+
+inline uint64_t ModMulLazy(uint64_t x, uint64_t w, uint64_t wp, uint64_t q) {
+    return x * w - MulHi64(x, wp) * q;
+}
+
+// inputs in [0, 4q), outputs in [0, 4q)
+inline void ForwardSpan(uint64_t* x, uint64_t* y, uint32_t len, uint64_t w, uint64_t wp, uint64_t q) {
+    const uint64_t twoq = q << 1;
+    for (uint32_t j = 0; j < len; ++j) {
+        uint64_t u = x[j] >= twoq ? x[j] - twoq : x[j];
+        uint64_t v = ModMulLazy(y[j], w, wp, q);
+        x[j]       = u + v;
+        y[j]       = u - v + twoq;
+    }
+}
+
+// inputs in [0, 2q), outputs in [0, 2q)
+inline void InverseSpan(uint64_t* x, uint64_t* y, uint32_t len, uint64_t w, uint64_t wp, uint64_t q) {
+    const uint64_t twoq = q << 1;
+    for (uint32_t j = 0; j < len; ++j) {
+        uint64_t u = x[j] + y[j];
+        uint64_t v = x[j] - y[j] + twoq;
+        x[j]       = u >= twoq ? u - twoq : u;
+        y[j]       = ModMulLazy(v, w, wp, q);
+    }
+}
+
+// inputs in [0, 2q), outputs in [0, q)
+inline void InverseLastSpan(uint64_t* x, uint64_t* y, uint32_t len, uint64_t nInv, uint64_t nInvPrecon,
+                            uint64_t w1nInv, uint64_t w1nInvPrecon, uint64_t q) {
+    const uint64_t twoq = q << 1;
+    for (uint32_t j = 0; j < len; ++j) {
+        uint64_t u = ModMulLazy(x[j] + y[j], nInv, nInvPrecon, q);
+        uint64_t v = ModMulLazy(x[j] - y[j] + twoq, w1nInv, w1nInvPrecon, q);
+        x[j]       = u >= q ? u - q : u;
+        y[j]       = v >= q ? v - q : v;
+    }
+}
+
+void ForwardStageScalar(uint64_t* a, const uint64_t* w, const uint64_t* wp, uint32_t m, uint32_t t, uint32_t iBegin,
+                        uint32_t iEnd, uint32_t col, uint32_t len, uint32_t stride, uint64_t q) {
+    for (uint32_t i = iBegin; i < iEnd; ++i) {
+        uint64_t* base = a + ((2 * i) * t);
+        for (uint32_t c = col; c < t; c += stride)
+            ForwardSpan(base + c, base + c + t, len, w[m + i], wp[m + i], q);
+    }
+}
+
+void InverseStageScalar(uint64_t* a, const uint64_t* w, const uint64_t* wp, uint32_t m, uint32_t t, uint32_t iBegin,
+                        uint32_t iEnd, uint32_t col, uint32_t len, uint32_t stride, uint64_t q) {
+    for (uint32_t i = iBegin; i < iEnd; ++i) {
+        uint64_t* base = a + ((2 * i) * t);
+        for (uint32_t c = col; c < t; c += stride)
+            InverseSpan(base + c, base + c + t, len, w[m + i], wp[m + i], q);
+    }
+}
+
+void InverseLastStageScalar(uint64_t* a, uint32_t t, uint32_t col, uint32_t len, uint32_t stride, uint64_t nInv,
+                            uint64_t nInvPrecon, uint64_t w1nInv, uint64_t w1nInvPrecon, uint64_t q) {
+    for (uint32_t c = col; c < t; c += stride)
+        InverseLastSpan(a + c, a + c + t, len, nInv, nInvPrecon, w1nInv, w1nInvPrecon, q);
+}
+
+void ReduceScalar(uint64_t* a, uint32_t len, uint64_t q) {
+    const uint64_t twoq = q << 1;
+    for (uint32_t j = 0; j < len; ++j) {
+        uint64_t x = a[j] >= twoq ? a[j] - twoq : a[j];
+        a[j]       = x >= q ? x - q : x;
+    }
+}
+
+constexpr NTTKernels SCALAR_KERNELS{ForwardStageScalar, InverseStageScalar, InverseLastStageScalar, ReduceScalar};
+
+#ifdef NTT_SIMD_X86
+// ---------------------------------------------------------------------------------------------
+// AVX2: 4 lanes. There is no 64x64-bit multiply, so the high and low halves of the products are
+// assembled from 32x32-bit partial products. AVX2 only compares signed 64-bit integers, and the
+// lazy values reach 4q >= 2^63 for q >= 2^61, so the comparisons flip the sign bits of both operands
+// to compare them as unsigned integers.
+// ---------------------------------------------------------------------------------------------
+    #define NTT_AVX2_INLINE __attribute__((target("avx2"), always_inline)) inline
+
+NTT_AVX2_INLINE __m256i MulHi64AVX2(__m256i a, __m256i b) {
+    const __m256i lo32 = _mm256_set1_epi64x(0xffffffff);
+    __m256i aHi        = _mm256_srli_epi64(a, 32);
+    __m256i bHi        = _mm256_srli_epi64(b, 32);
+    __m256i lolo       = _mm256_mul_epu32(a, b);
+    __m256i lohi       = _mm256_mul_epu32(a, bHi);
+    __m256i hilo       = _mm256_mul_epu32(aHi, b);
+    __m256i hihi       = _mm256_mul_epu32(aHi, bHi);
+    __m256i t          = _mm256_add_epi64(hilo, _mm256_srli_epi64(lolo, 32));
+    __m256i u          = _mm256_add_epi64(lohi, _mm256_and_si256(t, lo32));
+    return _mm256_add_epi64(_mm256_add_epi64(hihi, _mm256_srli_epi64(t, 32)), _mm256_srli_epi64(u, 32));
+}
+
+NTT_AVX2_INLINE __m256i MulLo64AVX2(__m256i a, __m256i b) {
+    __m256i lolo  = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)),
+                                     _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+    return _mm256_add_epi64(lolo, _mm256_slli_epi64(cross, 32));
+}
+
+NTT_AVX2_INLINE __m256i ModMulLazyAVX2(__m256i x, __m256i w, __m256i wp, __m256i q) {
+    __m256i qhat = MulHi64AVX2(x, wp);
+    return _mm256_sub_epi64(MulLo64AVX2(x, w), MulLo64AVX2(qhat, q));
+}
+
+// x >= bound ? x - bound : x, comparing as unsigned integers
+NTT_AVX2_INLINE __m256i ReduceAVX2(__m256i x, __m256i bound) {
+    const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(uint64_t(1) << 63));
+    __m256i lt         = _mm256_cmpgt_epi64(_mm256_xor_si256(bound, sign), _mm256_xor_si256(x, sign));
+    return _mm256_sub_epi64(x, _mm256_andnot_si256(lt, bound));
+}
+
+NTT_AVX2_INLINE __m256i LoadAVX2(const uint64_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+NTT_AVX2_INLINE void StoreAVX2(uint64_t* p, __m256i x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x);
+}
+
+__attribute__((target("avx2"))) void ForwardStageAVX2(uint64_t* a, const uint64_t* w, const uint64_t* wp, uint32_t m,
+                                                      uint32_t t, uint32_t iBegin, uint32_t iEnd, uint32_t col,
+                                                      uint32_t len, uint32_t stride, uint64_t q) {
+    if (len < 4) {
+        ForwardStageScalar(a, w, wp, m, t, iBegin, iEnd, col, len, stride, q);
+        return;
+    }
+    const __m256i vq  = _mm256_set1_epi64x(q);
+    const __m256i v2q = _mm256_set1_epi64x(q << 1);
+    for (uint32_t i = iBegin; i < iEnd; ++i) {
+        const __m256i omega       = _mm256_set1_epi64x(w[m + i]);
+        const __m256i preconOmega = _mm256_set1_epi64x(wp[m + i]);
+        uint64_t* base            = a + ((2 * i) * t);
+        for (uint32_t c = col; c < t; c += stride) {
+            uint64_t* x = base + c;
+            uint64_t* y = x + t;
+            for (uint32_t j = 0; j < len; j += 4) {
+                __m256i u = ReduceAVX2(LoadAVX2(x + j), v2q);
+                __m256i v = ModMulLazyAVX2(LoadAVX2(y + j), omega, preconOmega, vq);
+                StoreAVX2(x + j, _mm256_add_epi64(u, v));
+                StoreAVX2(y + j, _mm256_add_epi64(_mm256_sub_epi64(u, v), v2q));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2"))) void InverseStageAVX2(uint64_t* a, const uint64_t* w, const uint64_t* wp, uint32_t m,
+                                                      uint32_t t, uint32_t iBegin, uint32_t iEnd, uint32_t col,
+                                                      uint32_t len, uint32_t stride, uint64_t q) {
+    if (len < 4) {
+        InverseStageScalar(a, w, wp, m, t, iBegin, iEnd, col, len, stride, q);
+        return;
+    }
+    const __m256i vq  = _mm256_set1_epi64x(q);
+    const __m256i v2q = _mm256_set1_epi64x(q << 1);
+    for (uint32_t i = iBegin; i < iEnd; ++i) {
+        const __m256i omega       = _mm256_set1_epi64x(w[m + i]);
+        const __m256i preconOmega = _mm256_set1_epi64x(wp[m + i]);
+        uint64_t* base            = a + ((2 * i) * t);
+        for (uint32_t c = col; c < t; c += stride) {
+            uint64_t* x = base + c;
+            uint64_t* y = x + t;
+            for (uint32_t j = 0; j < len; j += 4) {
+                __m256i X = LoadAVX2(x + j);
+                __m256i Y = LoadAVX2(y + j);
+                StoreAVX2(x + j, ReduceAVX2(_mm256_add_epi64(X, Y), v2q));
+                StoreAVX2(y + j, ModMulLazyAVX2(_mm256_add_epi64(_mm256_sub_epi64(X, Y), v2q), omega, preconOmega, vq));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2"))) void InverseLastStageAVX2(uint64_t* a, uint32_t t, uint32_t col, uint32_t len,
+                                                          uint32_t stride, uint64_t nInv, uint64_t nInvPrecon,
+                                                          uint64_t w1nInv, uint64_t w1nInvPrecon, uint64_t q) {
+    if (len < 4) {
+        InverseLastStageScalar(a, t, col, len, stride, nInv, nInvPrecon, w1nInv, w1nInvPrecon, q);
+        return;
+    }
+    const __m256i vq            = _mm256_set1_epi64x(q);
+    const __m256i v2q           = _mm256_set1_epi64x(q << 1);
+    const __m256i vnInv         = _mm256_set1_epi64x(nInv);
+    const __m256i vnInvPrecon   = _mm256_set1_epi64x(nInvPrecon);
+    const __m256i vw1nInv       = _mm256_set1_epi64x(w1nInv);
+    const __m256i vw1nInvPrecon = _mm256_set1_epi64x(w1nInvPrecon);
+    for (uint32_t c = col; c < t; c += stride) {
+        uint64_t* x = a + c;
+        uint64_t* y = x + t;
+        for (uint32_t j = 0; j < len; j += 4) {
+            __m256i X = LoadAVX2(x + j);
+            __m256i Y = LoadAVX2(y + j);
+            __m256i u = ModMulLazyAVX2(_mm256_add_epi64(X, Y), vnInv, vnInvPrecon, vq);
+            __m256i v = ModMulLazyAVX2(_mm256_add_epi64(_mm256_sub_epi64(X, Y), v2q), vw1nInv, vw1nInvPrecon, vq);
+            StoreAVX2(x + j, ReduceAVX2(u, vq));
+            StoreAVX2(y + j, ReduceAVX2(v, vq));
+        }
+    }
+}
+
+__attribute__((target("avx2"))) void ReduceAVX2(uint64_t* a, uint32_t len, uint64_t q) {
+    if (len < 4) {
+        ReduceScalar(a, len, q);
+        return;
+    }
+    const __m256i vq  = _mm256_set1_epi64x(q);
+    const __m256i v2q = _mm256_set1_epi64x(q << 1);
+    for (uint32_t j = 0; j < len; j += 4)
+        StoreAVX2(a + j, ReduceAVX2(ReduceAVX2(LoadAVX2(a + j), v2q), vq));
+}
+
+constexpr NTTKernels AVX2_KERNELS{ForwardStageAVX2, InverseStageAVX2, InverseLastStageAVX2, ReduceAVX2};
+
+// ---------------------------------------------------------------------------------------------
+// AVX-512F: 8 lanes. Only AVX-512F instructions are used (no DQ/IFMA), so the 64-bit products are
+// assembled from 32x32-bit partial products as in the AVX2 kernels.
+// ---------------------------------------------------------------------------------------------
+    #define NTT_AVX512_INLINE __attribute__((target("avx512f"), always_inline)) inline
+
+NTT_AVX512_INLINE __m512i MulHi64AVX512(__m512i a, __m512i b) {
+    const __m512i lo32 = _mm512_set1_epi64(0xffffffff);
+    __m512i aHi        = _mm512_srli_epi64(a, 32);
+    __m512i bHi        = _mm512_srli_epi64(b, 32);
+    __m512i lolo       = _mm512_mul_epu32(a, b);
+    __m512i lohi       = _mm512_mul_epu32(a, bHi);
+    __m512i hilo       = _mm512_mul_epu32(aHi, b);
+    __m512i hihi       = _mm512_mul_epu32(aHi, bHi);
+    __m512i t          = _mm512_add_epi64(hilo, _mm512_srli_epi64(lolo, 32));
+    __m512i u          = _mm512_add_epi64(lohi, _mm512_and_si512(t, lo32));
+    return _mm512_add_epi64(_mm512_add_epi64(hihi, _mm512_srli_epi64(t, 32)), _mm512_srli_epi64(u, 32));
+}
+
+NTT_AVX512_INLINE __m512i MulLo64AVX512(__m512i a, __m512i b) {
+    __m512i lolo  = _mm512_mul_epu32(a, b);
+    __m512i cross = _mm512_add_epi64(_mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)),
+                                     _mm512_mul_epu32(_mm512_srli_epi64(a, 32), b));
+    return _mm512_add_epi64(lolo, _mm512_slli_epi64(cross, 32));
+}
+
+NTT_AVX512_INLINE __m512i ModMulLazyAVX512(__m512i x, __m512i w, __m512i wp, __m512i q) {
+    __m512i qhat = MulHi64AVX512(x, wp);
+    return _mm512_sub_epi64(MulLo64AVX512(x, w), MulLo64AVX512(qhat, q));
+}
+
+// x >= bound ? x - bound : x (x - bound wraps around when x < bound)
+NTT_AVX512_INLINE __m512i ReduceAVX512(__m512i x, __m512i bound) {
+    return _mm512_min_epu64(x, _mm512_sub_epi64(x, bound));
+}
+
+__attribute__((target("avx512f"))) void ForwardStageAVX512(uint64_t* a, const uint64_t* w, const uint64_t* wp,
+                                                           uint32_t m, uint32_t t, uint32_t iBegin, uint32_t iEnd,
+                                                           uint32_t col, uint32_t len, uint32_t stride, uint64_t q) {
+    if (len < 8) {
+        ForwardStageAVX2(a, w, wp, m, t, iBegin, iEnd, col, len, stride, q);
+        return;
+    }
+    const __m512i vq  = _mm512_set1_epi64(q);
+    const __m512i v2q = _mm512_set1_epi64(q << 1);
+    for (uint32_t i = iBegin; i < iEnd; ++i) {
+        const __m512i omega       = _mm512_set1_epi64(w[m + i]);
+        const __m512i preconOmega = _mm512_set1_epi64(wp[m + i]);
+        uint64_t* base            = a + ((2 * i) * t);
+        for (uint32_t c = col; c < t; c += stride) {
+            uint64_t* x = base + c;
+            uint64_t* y = x + t;
+            for (uint32_t j = 0; j < len; j += 8) {
+                __m512i u = ReduceAVX512(_mm512_loadu_si512(x + j), v2q);
+                __m512i v = ModMulLazyAVX512(_mm512_loadu_si512(y + j), omega, preconOmega, vq);
+                _mm512_storeu_si512(x + j, _mm512_add_epi64(u, v));
+                _mm512_storeu_si512(y + j, _mm512_add_epi64(_mm512_sub_epi64(u, v), v2q));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx512f"))) void InverseStageAVX512(uint64_t* a, const uint64_t* w, const uint64_t* wp,
+                                                           uint32_t m, uint32_t t, uint32_t iBegin, uint32_t iEnd,
+                                                           uint32_t col, uint32_t len, uint32_t stride, uint64_t q) {
+    if (len < 8) {
+        InverseStageAVX2(a, w, wp, m, t, iBegin, iEnd, col, len, stride, q);
+        return;
+    }
+    const __m512i vq  = _mm512_set1_epi64(q);
+    const __m512i v2q = _mm512_set1_epi64(q << 1);
+    for (uint32_t i = iBegin; i < iEnd; ++i) {
+        const __m512i omega       = _mm512_set1_epi64(w[m + i]);
+        const __m512i preconOmega = _mm512_set1_epi64(wp[m + i]);
+        uint64_t* base            = a + ((2 * i) * t);
+        for (uint32_t c = col; c < t; c += stride) {
+            uint64_t* x = base + c;
+            uint64_t* y = x + t;
+            for (uint32_t j = 0; j < len; j += 8) {
+                __m512i X = _mm512_loadu_si512(x + j);
+                __m512i Y = _mm512_loadu_si512(y + j);
+                _mm512_storeu_si512(x + j, ReduceAVX512(_mm512_add_epi64(X, Y), v2q));
+                _mm512_storeu_si512(
+                    y + j, ModMulLazyAVX512(_mm512_add_epi64(_mm512_sub_epi64(X, Y), v2q), omega, preconOmega, vq));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx512f"))) void InverseLastStageAVX512(uint64_t* a, uint32_t t, uint32_t col, uint32_t len,
+                                                               uint32_t stride, uint64_t nInv, uint64_t nInvPrecon,
+                                                               uint64_t w1nInv, uint64_t w1nInvPrecon, uint64_t q) {
+    if (len < 8) {
+        InverseLastStageAVX2(a, t, col, len, stride, nInv, nInvPrecon, w1nInv, w1nInvPrecon, q);
+        return;
+    }
+    const __m512i vq            = _mm512_set1_epi64(q);
+    const __m512i v2q           = _mm512_set1_epi64(q << 1);
+    const __m512i vnInv         = _mm512_set1_epi64(nInv);
+    const __m512i vnInvPrecon   = _mm512_set1_epi64(nInvPrecon);
+    const __m512i vw1nInv       = _mm512_set1_epi64(w1nInv);
+    const __m512i vw1nInvPrecon = _mm512_set1_epi64(w1nInvPrecon);
+    for (uint32_t c = col; c < t; c += stride) {
+        uint64_t* x = a + c;
+        uint64_t* y = x + t;
+        for (uint32_t j = 0; j < len; j += 8) {
+            __m512i X = _mm512_loadu_si512(x + j);
+            __m512i Y = _mm512_loadu_si512(y + j);
+            __m512i u = ModMulLazyAVX512(_mm512_add_epi64(X, Y), vnInv, vnInvPrecon, vq);
+            __m512i v =
+                ModMulLazyAVX512(_mm512_add_epi64(_mm512_sub_epi64(X, Y), v2q), vw1nInv, vw1nInvPrecon, vq);
+            _mm512_storeu_si512(x + j, ReduceAVX512(u, vq));
+            _mm512_storeu_si512(y + j, ReduceAVX512(v, vq));
+        }
+    }
+}
+
+__attribute__((target("avx512f"))) void ReduceAVX512(uint64_t* a, uint32_t len, uint64_t q) {
+    if (len < 8) {
+        ReduceAVX2(a, len, q);
+        return;
+    }
+    const __m512i vq  = _mm512_set1_epi64(q);
+    const __m512i v2q = _mm512_set1_epi64(q << 1);
+    for (uint32_t j = 0; j < len; j += 8)
+        _mm512_storeu_si512(a + j, ReduceAVX512(ReduceAVX512(_mm512_loadu_si512(a + j), v2q), vq));
+}
+
+constexpr NTTKernels AVX512_KERNELS{ForwardStageAVX512, InverseStageAVX512, InverseLastStageAVX512, ReduceAVX512};
+
+NTTBackend DetectNTTBackend() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return AVX512_NTT;
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2_NTT;
+    return SCALAR_NTT;
+}
+#else
+NTTBackend DetectNTTBackend() {
+    return SCALAR_NTT;
+}
+#endif
+
+const NTTKernels& GetNTTKernels(NTTBackend backend) {
+    switch (backend) {
+#ifdef NTT_SIMD_X86
+        case AVX512_NTT:
+            return AVX512_KERNELS;
+        case AVX2_NTT:
+            return AVX2_KERNELS;
+#endif
+        case SCALAR_NTT:
+            return SCALAR_KERNELS;
+        default:
+            break;
+    }
+    OPENFHE_THROW("NTT kernels are not available for backend " + std::to_string(backend));
+}
+
+// ---------------------------------------------------------------------------------------------
+// Cache-blocked schedule. With B = NTT_CACHE_BLOCK_SIZE, the stages with t >= B only combine
+// coefficients whose indices agree modulo B, so they are run as a column pass over strips of S
+// consecutive columns (n / B rows of S coefficients each). The stages with t < B never leave an
+// aligned block of B coefficients, so they are run as a row pass block by block. This is the
+// four-step split of the transform, but it keeps the original butterflies and their bit-reversed
+// order instead of transposing, so the output is unchanged.
+// ---------------------------------------------------------------------------------------------
+
+// columns per strip: n / B rows of S coefficients fill about one block of B coefficients
+inline uint32_t ColumnStripWidth(uint32_t n) {
+    return std::max<uint32_t>(NTT_CACHE_BLOCK_SIZE / (n / NTT_CACHE_BLOCK_SIZE), 8);
+}
+
+// forward stages t = len / 2, ..., 1 of the aligned block [begin, begin + len), followed by the final reduction
+void ForwardRows(const NTTKernels& k, const NTTBatchEntry& e, uint32_t n, uint32_t begin, uint32_t len) {
+    for (uint32_t t = len >> 1; t >= 1; t >>= 1) {
+        const uint32_t iBegin = begin / (2 * t);
+        k.forwardStage(e.element, e.rootOfUnityTable, e.preconRootOfUnityTable, n / (2 * t), t, iBegin,
+                       iBegin + len / (2 * t), 0, t, t, e.modulus);
+    }
+    k.reduce(e.element + begin, len, e.modulus);
+}
+
+// forward stages t = n / 2, ..., B on the columns [col, col + width)
+void ForwardColumns(const NTTKernels& k, const NTTBatchEntry& e, uint32_t n, uint32_t col, uint32_t width) {
+    for (uint32_t m = 1, t = n >> 1; t >= NTT_CACHE_BLOCK_SIZE; m <<= 1, t >>= 1)
+        k.forwardStage(e.element, e.rootOfUnityTable, e.preconRootOfUnityTable, m, t, 0, m, col, width,
+                       NTT_CACHE_BLOCK_SIZE, e.modulus);
+}
+
+// inverse stages t = 1, ..., len / 2 of the aligned block [begin, begin + len), excluding the last stage t = n / 2
+void InverseRows(const NTTKernels& k, const NTTBatchEntry& e, uint32_t n, uint32_t begin, uint32_t len) {
+    for (uint32_t t = 1; t < len && t < (n >> 1); t <<= 1) {
+        const uint32_t iBegin = begin / (2 * t);
+        k.inverseStage(e.element, e.rootOfUnityTable, e.preconRootOfUnityTable, n / (2 * t), t, iBegin,
+                       iBegin + len / (2 * t), 0, t, t, e.modulus);
+    }
+}
+
+// inverse stages t = B, ..., n / 2 on the columns [col, col + width) with columns repeating every stride
+void InverseColumns(const NTTKernels& k, const NTTBatchEntry& e, uint32_t n, uint32_t col, uint32_t width,
+                    uint32_t stride) {
+    for (uint32_t m = n / (2 * stride), t = stride; m > 1; m >>= 1, t <<= 1)
+        k.inverseStage(e.element, e.rootOfUnityTable, e.preconRootOfUnityTable, m, t, 0, m, col, width, stride,
+                       e.modulus);
+    k.inverseLastStage(e.element, n >> 1, col, width, stride, e.cycloOrderInv, e.preconCycloOrderInv, e.omega1Inv,
+                       e.preconOmega1Inv, e.modulus);
+}
+
+// runs body(i) for i in [0, count), spread over the threads through ParallelControls if parallel is set
+template <typename Func>
+void ForEachTask(bool parallel, uint32_t count, Func&& body) {
+    if (parallel) {
+        lbcrypto::OpenFHEParallelControls.ParallelFor(0, count, body);
+        return;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+        body(i);
+}
+
+void ForwardTransformBatch(const NTTKernels& k, const NTTBatchEntry* entries, uint32_t count, uint32_t n,
+                           bool parallel) {
+    if (n <= NTT_CACHE_BLOCK_SIZE) {
+        ForEachTask(parallel, count, [&](uint32_t i) {
+            ForwardRows(k, entries[i], n, 0, n);
+        });
+        return;
+    }
+    const uint32_t width{ColumnStripWidth(n)};
+    const uint32_t strips{NTT_CACHE_BLOCK_SIZE / width};
+    const uint32_t rows{n / NTT_CACHE_BLOCK_SIZE};
+    const uint32_t columnTasks{count * strips};
+    ForEachTask(parallel, columnTasks, [&](uint32_t task) {
+        ForwardColumns(k, entries[task / strips], n, (task % strips) * width, width);
+    });
+    const uint32_t rowTasks{count * rows};
+    ForEachTask(parallel, rowTasks, [&](uint32_t task) {
+        ForwardRows(k, entries[task / rows], n, (task % rows) * NTT_CACHE_BLOCK_SIZE, NTT_CACHE_BLOCK_SIZE);
+    });
+}
+
+void InverseTransformBatch(const NTTKernels& k, const NTTBatchEntry* entries, uint32_t count, uint32_t n,
+                           bool parallel) {
+    if (n <= NTT_CACHE_BLOCK_SIZE) {
+        ForEachTask(parallel, count, [&](uint32_t i) {
+            InverseRows(k, entries[i], n, 0, n);
+            InverseColumns(k, entries[i], n, 0, n >> 1, n >> 1);
+        });
+        return;
+    }
+    const uint32_t rows{n / NTT_CACHE_BLOCK_SIZE};
+    const uint32_t rowTasks{count * rows};
+    ForEachTask(parallel, rowTasks, [&](uint32_t task) {
+        InverseRows(k, entries[task / rows], n, (task % rows) * NTT_CACHE_BLOCK_SIZE, NTT_CACHE_BLOCK_SIZE);
+    });
+    const uint32_t width{ColumnStripWidth(n)};
+    const uint32_t strips{NTT_CACHE_BLOCK_SIZE / width};
+    const uint32_t columnTasks{count * strips};
+    ForEachTask(parallel, columnTasks, [&](uint32_t task) {
+        InverseColumns(k, entries[task / strips], n, (task % strips) * width, width, NTT_CACHE_BLOCK_SIZE);
+    });
+}
+
+// function-local statics so that the backend is valid even when transforms run during static initialization
+std::atomic<NTTBackend>& CurrentNTTBackend() {
+    static std::atomic<NTTBackend> backend{GetDefaultNTTBackend()};
+    return backend;
+}
+
+}  // namespace
+
+bool IsNTTBackendSupported(NTTBackend backend) {
+    const NTTBackend best{GetDefaultNTTBackend()};
+    switch (backend) {
+        case SCALAR_NTT:
+            return true;
+        case AVX2_NTT:
+            return best == AVX2_NTT || best == AVX512_NTT;
+        case AVX512_NTT:
+            return best == AVX512_NTT;
+    }
+    return false;
+}
+
+NTTBackend GetDefaultNTTBackend() {
+    static const NTTBackend backend{DetectNTTBackend()};
+    return backend;
+}
+
+NTTBackend GetNTTBackend() {
+    return CurrentNTTBackend().load(std::memory_order_relaxed);
+}
+
+void SetNTTBackend(NTTBackend backend) {
+    if (!IsNTTBackendSupported(backend))
+        OPENFHE_THROW("NTT backend " + std::to_string(backend) + " is not supported on this machine");
+    CurrentNTTBackend().store(backend, std::memory_order_relaxed);
+}
+
+void ForwardTransformToBitReverseInPlaceSIMD(NTTBackend backend, uint64_t* element, const uint64_t* rootOfUnityTable,
+                                             const uint64_t* preconRootOfUnityTable, uint32_t n, uint64_t modulus) {
+    if (backend == SCALAR_NTT)
+        OPENFHE_THROW("SIMD NTT kernels are not available for backend " + std::to_string(backend));
+    NTTBatchEntry entry{element, rootOfUnityTable, preconRootOfUnityTable, modulus};
+    ForwardTransformBatch(GetNTTKernels(backend), &entry, 1, n, false);
+}
+
+void InverseTransformFromBitReverseInPlaceSIMD(NTTBackend backend, uint64_t* element,
+                                               const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t omega1Inv,
+                                               uint64_t preconOmega1Inv, uint32_t n, uint64_t modulus) {
+    if (backend == SCALAR_NTT)
+        OPENFHE_THROW("SIMD NTT kernels are not available for backend " + std::to_string(backend));
+    NTTBatchEntry entry{element,       rootOfUnityInverseTable, preconRootOfUnityInverseTable, modulus,
+                        cycloOrderInv, preconCycloOrderInv,     omega1Inv,                     preconOmega1Inv};
+    InverseTransformBatch(GetNTTKernels(backend), &entry, 1, n, false);
+}
+
+void ForwardTransformToBitReverseInPlaceBatch(NTTBackend backend, const NTTBatchEntry* entries, uint32_t count,
+                                              uint32_t n) {
+    ForwardTransformBatch(GetNTTKernels(backend), entries, count, n, true);
+}
+
+void InverseTransformFromBitReverseInPlaceBatch(NTTBackend backend, const NTTBatchEntry* entries, uint32_t count,
+                                                uint32_t n) {
+    InverseTransformBatch(GetNTTKernels(backend), entries, count, n, true);
+}
+
+}  // namespace intnat
@@ -0,0 +1,89 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides deterministic generation of uniform values mod q from a short seed
+ */
+
+#include "math/seededuniformgenerator.h"
+#include "math/distributiongenerator.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/exception.h"
+
+namespace lbcrypto {
+
+SeededUniformGenerator::SeedType SeededUniformGenerator::GenerateSeed() {
+    SeedType seed{};
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (auto& s : seed)
+        s = prng();
+    return seed;
+}
+
+void SeededUniformGenerator::FillVector(const SeedType& seed, uint64_t streamId, NativeVector& v) {
+    using NativeInt = typename NativeInteger::Integer;
+
+    const NativeInt q{v.GetModulus().ConvertToInt<NativeInt>()};
+    if (q == 0)
+        OPENFHE_THROW("0 modulus?");
+
+    // the stream id occupies the words following the seed, so that every stream is keyed independently
+    default_prng::Blake2Engine::blake2_seed_array_t key{};
+    for (uint32_t i = 0; i < SEED_WORDS; ++i)
+        key[i] = seed[i];
+    key[SEED_WORDS]     = static_cast<uint32_t>(streamId);
+    key[SEED_WORDS + 1] = static_cast<uint32_t>(streamId >> 32);
+    default_prng::Blake2Engine engine(key, 0);
+
+    // rejection sampling with a mask of the modulus bit length accepts a sample with probability above 1/2
+    const uint32_t bits{v.GetModulus().GetMSB()};
+    const uint32_t chunks{(bits + 31) / 32};
+    const NativeInt mask{bits >= sizeof(NativeInt) * 8 ? ~NativeInt(0) : (NativeInt(1) << bits) - 1};
+
+    const size_t n{v.GetLength()};
+    for (size_t j = 0; j < n;) {
+        NativeInt r{0};
+        for (uint32_t c = 0; c < chunks; ++c)
+            r |= static_cast<NativeInt>(engine()) << (32 * c);
+        r &= mask;
+        if (r < q)
+            v[j++] = r;
+    }
+}
+
+NativeVector SeededUniformGenerator::GenerateVector(const SeedType& seed, uint64_t streamId, uint32_t size,
+                                                    const NativeInteger& modulus) {
+    NativeVector v(size, modulus);
+    FillVector(seed, streamId, v);
+    return v;
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,154 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Read-only memory mapping of a file and a stream buffer over a memory range
+ */
+
+#include "utils/mappedfile.h"
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define OPENFHE_HAVE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lbcrypto {
+
+#ifdef OPENFHE_HAVE_MMAP
+namespace {
+
+// madvise needs a page-aligned start, so the range is widened down to the page that holds its first byte
+void AdviseRange(const char* data, size_t fileSize, size_t offset, size_t size, int advice) {
+    if (offset >= fileSize || size == 0)
+        return;
+    size = std::min(size, fileSize - offset);
+    static const size_t pageSize{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+    size_t start{offset - offset % pageSize};
+    madvise(const_cast<char*>(data) + start, size + (offset - start), advice);
+}
+
+}  // namespace
+#endif
+
+MappedFile::MappedFile(const std::string& path, bool writable) : m_path(path), m_writable(writable) {
+#ifdef OPENFHE_HAVE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        OPENFHE_THROW("Cannot open file " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        OPENFHE_THROW("Cannot read the size of file " + path);
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size > 0) {
+        void* p = mmap(nullptr, m_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            m_data   = static_cast<const char*>(p);
+            m_mapped = true;
+        }
+    }
+    close(fd);
+    if (m_mapped || m_size == 0)
+        return;
+#endif
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        OPENFHE_THROW("Cannot open file " + path);
+    m_size = static_cast<size_t>(file.tellg());
+    m_buffer.resize(m_size);
+    file.seekg(0);
+    if (m_size > 0 && !file.read(m_buffer.data(), m_size))
+        OPENFHE_THROW("Cannot read file " + path);
+    m_data = m_buffer.data();
+}
+
+MappedFile::~MappedFile() {
+#ifdef OPENFHE_HAVE_MMAP
+    if (m_mapped)
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+char* MappedFile::GetWritableData() const {
+    if (!m_writable)
+        OPENFHE_THROW("File " + m_path + " is not mapped as writable");
+    return const_cast<char*>(m_data);
+}
+
+void MappedFile::WillNeed(size_t offset, size_t size) const {
+#ifdef OPENFHE_HAVE_MMAP
+    if (m_mapped)
+        AdviseRange(m_data, m_size, offset, size, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::DontNeed(size_t offset, size_t size) const {
+#ifdef OPENFHE_HAVE_MMAP
+    if (m_mapped)
+        AdviseRange(m_data, m_size, offset, size, MADV_DONTNEED);
+#endif
+}
+
+MemoryStreamBuf::MemoryStreamBuf(const char* data, size_t size) {
+    char* p = const_cast<char*>(data);
+    setg(p, p, p + size);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                   std::ios_base::openmode which) {
+    if (!(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+    off_type base{0};
+    if (dir == std::ios_base::cur)
+        base = gptr() - eback();
+    else if (dir == std::ios_base::end)
+        base = egptr() - eback();
+    off_type pos{base + off};
+    if (pos < 0 || pos > egptr() - eback())
+        return pos_type(off_type(-1));
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,184 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Opt-in instrumentation of the memory allocated and copied by native vectors and DCRT polynomials
+ */
+
+#include "utils/memory-stats.h"
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+
+namespace lbcrypto {
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> allocatedBytes{0};
+std::atomic<uint64_t> vectorCopies{0};
+std::atomic<uint64_t> vectorCopiedBytes{0};
+std::atomic<uint64_t> vectorMoves{0};
+std::atomic<uint64_t> polyCopies{0};
+std::atomic<uint64_t> polyMoves{0};
+std::atomic<uint64_t> liveBytes{0};
+std::atomic<uint64_t> peakLiveBytes{0};
+
+std::mutex scopesMutex;
+std::map<std::string, MemoryStats> scopes;
+
+thread_local uint32_t scopeDepth{0};
+
+void RaisePeak(std::atomic<uint64_t>& peak, uint64_t value) noexcept {
+    uint64_t cur{peak.load(std::memory_order_relaxed)};
+    while (cur < value && !peak.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+std::string MemoryStats::ToJSON() const {
+    std::stringstream s;
+    s << "{\"calls\": " << calls << ", \"allocations\": " << allocations << ", \"allocatedBytes\": " << allocatedBytes
+      << ", \"vectorCopies\": " << vectorCopies << ", \"vectorCopiedBytes\": " << vectorCopiedBytes
+      << ", \"vectorMoves\": " << vectorMoves << ", \"polyCopies\": " << polyCopies << ", \"polyMoves\": " << polyMoves;
+    // the peak is process-wide, so it is reported for the totals only
+    if (calls == 0)
+        s << ", \"peakLiveBytes\": " << peakLiveBytes;
+    s << "}";
+    return s.str();
+}
+
+void MemoryProfiler::RecordAllocation(size_t bytes) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    uint64_t live{liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes};
+    RaisePeak(peakLiveBytes, live);
+}
+
+void MemoryProfiler::RecordDeallocation(size_t bytes) noexcept {
+    liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::RecordVectorCopy(size_t bytes) noexcept {
+    vectorCopies.fetch_add(1, std::memory_order_relaxed);
+    vectorCopiedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::RecordVectorMove() noexcept {
+    vectorMoves.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::RecordPolyCopy() noexcept {
+    polyCopies.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryProfiler::RecordPolyMove() noexcept {
+    polyMoves.fetch_add(1, std::memory_order_relaxed);
+}
+
+MemoryStats MemoryProfiler::GetTotals() {
+    MemoryStats stats;
+    stats.allocations       = allocations.load(std::memory_order_relaxed);
+    stats.allocatedBytes    = allocatedBytes.load(std::memory_order_relaxed);
+    stats.vectorCopies      = vectorCopies.load(std::memory_order_relaxed);
+    stats.vectorCopiedBytes = vectorCopiedBytes.load(std::memory_order_relaxed);
+    stats.vectorMoves       = vectorMoves.load(std::memory_order_relaxed);
+    stats.polyCopies        = polyCopies.load(std::memory_order_relaxed);
+    stats.polyMoves         = polyMoves.load(std::memory_order_relaxed);
+    stats.peakLiveBytes     = peakLiveBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint64_t MemoryProfiler::GetLiveBytes() {
+    return liveBytes.load(std::memory_order_relaxed);
+}
+
+MemoryStats MemoryProfiler::GetScope(const std::string& name) {
+    std::lock_guard<std::mutex> lock(scopesMutex);
+    auto it = scopes.find(name);
+    return it == scopes.end() ? MemoryStats() : it->second;
+}
+
+std::map<std::string, MemoryStats> MemoryProfiler::GetScopes() {
+    std::lock_guard<std::mutex> lock(scopesMutex);
+    return scopes;
+}
+
+void MemoryProfiler::Reset() {
+    std::lock_guard<std::mutex> lock(scopesMutex);
+    scopes.clear();
+    allocations.store(0, std::memory_order_relaxed);
+    allocatedBytes.store(0, std::memory_order_relaxed);
+    vectorCopies.store(0, std::memory_order_relaxed);
+    vectorCopiedBytes.store(0, std::memory_order_relaxed);
+    vectorMoves.store(0, std::memory_order_relaxed);
+    polyCopies.store(0, std::memory_order_relaxed);
+    polyMoves.store(0, std::memory_order_relaxed);
+    peakLiveBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::string MemoryProfiler::ToJSON() {
+    std::stringstream s;
+    s << "{\"total\": " << GetTotals().ToJSON() << ", \"scopes\": {";
+    bool first{true};
+    for (const auto& scope : GetScopes()) {
+        s << (first ? "" : ", ") << "\"" << scope.first << "\": " << scope.second.ToJSON();
+        first = false;
+    }
+    s << "}}";
+    return s.str();
+}
+
+MemoryStatsScope::MemoryStatsScope(const char* name) : m_name{name}, m_outermost{scopeDepth++ == 0} {
+    if (m_outermost)
+        m_entry = MemoryProfiler::GetTotals();
+}
+
+MemoryStatsScope::~MemoryStatsScope() {
+    --scopeDepth;
+    if (!m_outermost)
+        return;
+    const MemoryStats exit{MemoryProfiler::GetTotals()};
+    std::lock_guard<std::mutex> lock(scopesMutex);
+    auto& stats = scopes[m_name];
+    stats.calls += 1;
+    stats.allocations += exit.allocations - m_entry.allocations;
+    stats.allocatedBytes += exit.allocatedBytes - m_entry.allocatedBytes;
+    stats.vectorCopies += exit.vectorCopies - m_entry.vectorCopies;
+    stats.vectorCopiedBytes += exit.vectorCopiedBytes - m_entry.vectorCopiedBytes;
+    stats.vectorMoves += exit.vectorMoves - m_entry.vectorMoves;
+    stats.polyCopies += exit.polyCopies - m_entry.polyCopies;
+    stats.polyMoves += exit.polyMoves - m_entry.polyMoves;
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,197 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  NUMA topology detection, thread binding and page interleaving (Linux only, no external library)
+ */
+
+#include "utils/numa.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <linux/mempolicy.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+#ifdef __linux__
+// CPUs the process may run on, captured before any thread is bound
+cpu_set_t InitialProcessMask() {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &mask);
+    }
+    return mask;
+}
+
+const cpu_set_t processMask{InitialProcessMask()};
+
+bool SetCurrentThreadMask(const cpu_set_t& mask) {
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+}
+#endif
+
+}  // namespace
+
+const NumaTopology& NumaTopology::GetInstance() {
+    static const NumaTopology topology("/sys/devices/system/node");
+    return topology;
+}
+
+NumaTopology::NumaTopology(const std::string& nodeDir) {
+    std::vector<std::pair<uint32_t, std::vector<uint32_t>>> nodes;
+#ifdef __linux__
+    if (DIR* dir = opendir(nodeDir.c_str())) {
+        while (const dirent* entry = readdir(dir)) {
+            const std::string name{entry->d_name};
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+                continue;
+            std::ifstream cpulist(nodeDir + "/" + name + "/cpulist");
+            std::string list;
+            std::getline(cpulist, list);
+            nodes.emplace_back(std::stoul(name.substr(4)), ParseCPUList(list));
+        }
+        closedir(dir);
+    }
+#endif
+    if (nodes.empty()) {
+        std::vector<uint32_t> cpus(std::max(1U, std::thread::hardware_concurrency()));
+        for (uint32_t cpu = 0; cpu < cpus.size(); ++cpu)
+            cpus[cpu] = cpu;
+        nodes.emplace_back(0, std::move(cpus));
+    }
+    std::sort(nodes.begin(), nodes.end());
+    for (auto& [id, cpus] : nodes) {
+        m_nodeIds.push_back(id);
+        m_nodeCPUs.push_back(std::move(cpus));
+    }
+}
+
+uint32_t NumaTopology::GetNodeOfCPU(uint32_t cpu) const {
+    for (uint32_t node = 0; node < m_nodeCPUs.size(); ++node) {
+        if (std::binary_search(m_nodeCPUs[node].begin(), m_nodeCPUs[node].end(), cpu))
+            return node;
+    }
+    return 0;
+}
+
+std::vector<uint32_t> NumaTopology::ParseCPUList(const std::string& list) {
+    std::vector<uint32_t> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        // drops the trailing newline and any other whitespace
+        auto isNoise = [](char c) {
+            return !std::isdigit(static_cast<unsigned char>(c)) && c != '-';
+        };
+        range.erase(std::remove_if(range.begin(), range.end(), isNoise), range.end());
+        if (range.empty())
+            continue;
+        const auto dash{range.find('-')};
+        const auto first{static_cast<uint32_t>(std::stoul(range.substr(0, dash)))};
+        const auto last{dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)))};
+        for (uint32_t cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+bool BindCurrentThreadToNode(uint32_t node) {
+#ifdef __linux__
+    const auto& topology = NumaTopology::GetInstance();
+    if (node >= topology.GetNumNodes())
+        return false;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    bool any{false};
+    for (uint32_t cpu : topology.GetNodeCPUs(node)) {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &processMask)) {
+            CPU_SET(cpu, &mask);
+            any = true;
+        }
+    }
+    return any && SetCurrentThreadMask(mask);
+#else
+    return false;
+#endif
+}
+
+void UnbindCurrentThread() {
+#ifdef __linux__
+    SetCurrentThreadMask(processMask);
+#endif
+}
+
+bool NumaInterleave(const void* p, size_t bytes) {
+#if defined(__linux__) && defined(SYS_mbind)
+    const auto& topology = NumaTopology::GetInstance();
+    if (topology.GetNumNodes() < 2)
+        return false;
+    const uintptr_t page{static_cast<uintptr_t>(sysconf(_SC_PAGESIZE))};
+    const uintptr_t begin{(reinterpret_cast<uintptr_t>(p) + page - 1) & ~(page - 1)};
+    const uintptr_t end{(reinterpret_cast<uintptr_t>(p) + bytes) & ~(page - 1)};
+    if (begin >= end)
+        return false;
+    constexpr size_t BITS{8 * sizeof(unsigned long)};  // NOLINT
+    std::vector<unsigned long> nodeMask;                 // NOLINT
+    for (uint32_t node = 0; node < topology.GetNumNodes(); ++node) {
+        const uint32_t id{topology.GetNodeId(node)};
+        if (nodeMask.size() <= id / BITS)
+            nodeMask.resize(id / BITS + 1, 0);
+        nodeMask[id / BITS] |= 1UL << (id % BITS);
+    }
+    // maxnode counts one bit more than the highest node the kernel should look at
+    return syscall(SYS_mbind, begin, end - begin, MPOL_INTERLEAVE, nodeMask.data(), nodeMask.size() * BITS + 1,
+                   MPOL_MF_MOVE) == 0;
+#else
+    return false;
+#endif
+}
+
+}  // namespace lbcrypto
@@ -34,9 +34,36 @@
  */
 
 #include "utils/parallel.h"
+#include "utils/numa.h"
+
+#include <vector>
 
 namespace lbcrypto {
 
 ParallelControls OpenFHEParallelControls;
 
+void ParallelControls::SetNumaMode(bool enable) {
+    const uint32_t nodes{NumaTopology::GetInstance().GetNumNodes()};
+#ifdef PARALLEL
+    #pragma omp parallel num_threads(machineThreads)
+    {
+        const uint32_t t = omp_get_thread_num();
+        if (enable)
+            BindCurrentThreadToNode(t * nodes / omp_get_num_threads());
+        else
+            UnbindCurrentThread();
+    }
+#endif
+    // the thread starting a loop counts as thread 0 of the pool
+    auto& pool = TaskPool::GetInstance();
+    const uint32_t workers{pool.GetNumWorkers()};
+    std::vector<int32_t> workerNodes(workers, -1);
+    if (enable) {
+        for (uint32_t w = 0; w < workers; ++w)
+            workerNodes[w] = static_cast<int32_t>((w + 1) * nodes / (workers + 1));
+    }
+    pool.SetWorkerNodes(workerNodes);
+    numaMode.store(enable, std::memory_order_relaxed);
 }
+
+}  // namespace lbcrypto
@@ -0,0 +1,210 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Work-stealing pool of threads used by the task backend of ParallelControls
+ */
+
+#include "utils/task-pool.h"
+#include "utils/numa.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
+namespace lbcrypto {
+
+struct TaskPool::Job {
+    RangeFunction body;
+    void* context;
+    std::atomic<size_t> pending;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+struct TaskPool::Task {
+    Job* job;
+    size_t begin;
+    size_t end;
+};
+
+struct TaskPool::Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+namespace {
+
+// index of the calling thread among the workers of the pool, -1 for any other thread
+thread_local int32_t workerIndex{-1};
+
+}  // namespace
+
+TaskPool& TaskPool::GetInstance() {
+#ifdef PARALLEL
+    static const uint32_t threads = omp_get_max_threads();
+#else
+    static const uint32_t threads = std::thread::hardware_concurrency();
+#endif
+    // never destroyed, so that loops run from static destructors still find their workers
+    static TaskPool* pool = new TaskPool(threads > 1 ? threads - 1 : 0);
+    return *pool;
+}
+
+TaskPool::TaskPool(uint32_t workers) {
+    m_queues.reserve(workers + 1);
+    for (uint32_t i = 0; i <= workers; ++i)
+        m_queues.emplace_back(std::make_unique<Queue>());
+    m_threads.reserve(workers);
+    for (uint32_t i = 0; i < workers; ++i) {
+        m_threads.emplace_back(&TaskPool::WorkerLoop, this, static_cast<int32_t>(i));
+        m_threads.back().detach();
+    }
+}
+
+void TaskPool::RunRange(size_t begin, size_t end, size_t maxTasks, RangeFunction body, void* context) {
+    if (begin >= end)
+        return;
+    const size_t n{end - begin};
+    const size_t chunks{std::min(n, std::max<size_t>(maxTasks, 1))};
+    if (chunks == 1 || m_threads.empty()) {
+        body(context, begin, end);
+        return;
+    }
+
+    Job job;
+    job.body    = body;
+    job.context = context;
+    job.pending.store(chunks, std::memory_order_relaxed);
+
+    auto& queue = *m_queues[workerIndex >= 0 ? workerIndex : m_threads.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (size_t c = chunks; c > 0; --c)
+            queue.tasks.push_back({&job, begin + (c - 1) * n / chunks, begin + c * n / chunks});
+    }
+    m_queued.fetch_add(chunks, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+
+    // the starting thread works on any queued task until its own loop is complete
+    while (job.pending.load(std::memory_order_acquire) > 0) {
+        if (!RunOne(workerIndex))
+            std::this_thread::yield();
+    }
+
+    if (job.error)
+        std::rethrow_exception(job.error);
+}
+
+bool TaskPool::RunOne(int32_t self) {
+    Task task{nullptr, 0, 0};
+    const size_t numQueues{m_queues.size()};
+    const size_t shared{numQueues - 1};
+    // own deque from the back, then the shared queue and the other deques from the front
+    if (self >= 0) {
+        auto& own = *m_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+        }
+    }
+    for (size_t k = 0; task.job == nullptr && k < numQueues; ++k) {
+        const size_t victim{(shared + k) % numQueues};
+        if (static_cast<int32_t>(victim) == self)
+            continue;
+        auto& queue = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+    }
+    if (task.job == nullptr)
+        return false;
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+    Job& job = *task.job;
+    try {
+        job.body(job.context, task.begin, task.end);
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(job.errorMutex);
+        if (!job.error)
+            job.error = std::current_exception();
+    }
+    job.pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void TaskPool::SetWorkerNodes(const std::vector<int32_t>& nodes) {
+    {
+        std::lock_guard<std::mutex> lock(m_nodeMutex);
+        m_workerNodes = nodes;
+        m_workerNodes.resize(m_threads.size(), -1);
+    }
+    m_nodeEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void TaskPool::ApplyWorkerNode(int32_t self, uint32_t& epoch) {
+    int32_t node;
+    {
+        std::lock_guard<std::mutex> lock(m_nodeMutex);
+        epoch = m_nodeEpoch.load(std::memory_order_acquire);
+        node  = m_workerNodes[self];
+    }
+    if (node >= 0)
+        BindCurrentThreadToNode(static_cast<uint32_t>(node));
+    else
+        UnbindCurrentThread();
+}
+
+void TaskPool::WorkerLoop(int32_t self) {
+    workerIndex = self;
+    uint32_t epoch{0};
+    while (true) {
+        if (m_nodeEpoch.load(std::memory_order_acquire) != epoch)
+            ApplyWorkerNode(self, epoch);
+        if (RunOne(self))
+            continue;
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] { return m_queued.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+}  // namespace lbcrypto
@@ -33,7 +33,9 @@
   This code exercises the math libraries of the OpenFHE lattice encryption library.
  */
 
+#include <future>
 #include <iostream>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
@@ -550,3 +552,67 @@ void modmul_vector(const std::string& msg) {
 TEST(UTBinVect, modmul_vector) {
     RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+TEST(UTBinVect, native_scratch_arena) {
+    constexpr usint n = 1 << 12;
+    NativeInteger q("1152921504606584833");
+    const size_t limit{intnat::ScratchArena::GetLimit()};
+
+    intnat::ScratchArena::SetLimit(0);
+    {
+        NativeVector v(n, q);
+    }
+    EXPECT_EQ(intnat::ScratchArena::GetCachedBytes(), 0U) << "Failure: cached with the arena disabled";
+
+    intnat::ScratchArena::SetLimit(4 * n * sizeof(NativeInteger));
+    const NativeInteger* released;
+    {
+        NativeVector v(n, q);
+        released = &v[0];
+    }
+    EXPECT_EQ(intnat::ScratchArena::GetCachedBytes(), n * sizeof(NativeInteger)) << "Failure: block not cached";
+    {
+        NativeVector v(n, q, NativeInteger(7));
+        EXPECT_EQ(&v[0], released) << "Failure: block not reused";
+        EXPECT_EQ(intnat::ScratchArena::GetCachedBytes(), 0U) << "Failure: reused block still cached";
+        for (usint i = 0; i < n; ++i)
+            EXPECT_EQ(v[i], NativeInteger(7)) << "Failure: reused block not initialized";
+    }
+
+    {
+        std::vector<NativeVector> vs(8, NativeVector(n, q));
+    }
+    EXPECT_EQ(intnat::ScratchArena::GetCachedBytes(), 4 * n * sizeof(NativeInteger)) << "Failure: limit exceeded";
+
+    intnat::ScratchArena::Trim(n * sizeof(NativeInteger));
+    EXPECT_EQ(intnat::ScratchArena::GetCachedBytes(), n * sizeof(NativeInteger)) << "Failure: Trim";
+
+    // another thread applies a lowered limit on its next allocation
+    intnat::ScratchArena::SetLimit(4 * n * sizeof(NativeInteger));
+    std::promise<void> filled;
+    std::promise<void> lowered;
+    size_t cachedBefore{0};
+    size_t cachedAfter{0};
+    std::thread worker([&] {
+        {
+            std::vector<NativeVector> vs(4, NativeVector(n, q));
+        }
+        cachedBefore = intnat::ScratchArena::GetCachedBytes();
+        filled.set_value();
+        lowered.get_future().wait();
+        {
+            NativeVector v(n, q);
+        }
+        cachedAfter = intnat::ScratchArena::GetCachedBytes();
+    });
+    filled.get_future().wait();
+    intnat::ScratchArena::SetLimit(n * sizeof(NativeInteger));
+    lowered.set_value();
+    worker.join();
+    EXPECT_EQ(cachedBefore, 4 * n * sizeof(NativeInteger)) << "Failure: worker cache not filled";
+    EXPECT_EQ(cachedAfter, n * sizeof(NativeInteger)) << "Failure: lowered limit not applied by another thread";
+
+    intnat::ScratchArena::SetLimit(limit);
+    intnat::ScratchArena::Trim();
+    EXPECT_EQ(intnat::ScratchArena::GetCachedBytes(), 0U) << "Failure: Trim";
+}
@@ -38,6 +38,7 @@
 #include "math/distrgen.h"
 #include "testdefs.h"
 #include "utils/debug.h"
+#include "utils/memory-stats.h"
 
 #include <iostream>
 #include <vector>
@@ -592,6 +593,208 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+template <typename Element>
+void DCRT_switch_format_batch(const std::string& msg) {
+    uint32_t order     = 16384;
+    uint32_t nBits     = 50;
+    uint32_t towersize = 3;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+
+    Element coef(dug, ildcrtparams, Format::COEFFICIENT);
+    Element eval(dug, ildcrtparams, Format::EVALUATION);
+
+    Element coefExpected(coef);
+    Element evalExpected(eval);
+    coefExpected.SwitchFormat();
+    evalExpected.SwitchFormat();
+
+    Element::SwitchFormat({&coef, &eval});
+    EXPECT_EQ(Format::EVALUATION, coef.GetFormat()) << msg;
+    EXPECT_EQ(Format::COEFFICIENT, eval.GetFormat()) << msg;
+    EXPECT_EQ(coefExpected, coef) << msg << " Failure: batched forward transform";
+    EXPECT_EQ(evalExpected, eval) << msg << " Failure: batched inverse transform";
+}
+
+TEST(UTDCRTPoly, DCRT_switch_format_batch) {
+    RUN_BIG_DCRTPOLYS(DCRT_switch_format_batch, "DCRT_switch_format_batch");
+}
+
+template <typename Element>
+void DCRT_contiguous_towers(const std::string& msg) {
+    uint32_t order     = 2048;
+    uint32_t nBits     = 50;
+    uint32_t towersize = 4;
+    uint32_t n         = order / 2;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+    Element a(dug, ildcrtparams, Format::EVALUATION);
+    Element b(dug, ildcrtparams, Format::EVALUATION);
+
+    auto isContiguous = [n](const Element& e) {
+        const auto* base = reinterpret_cast<const char*>(&e.GetElementAtIndex(0).GetValues()[0]);
+        if (reinterpret_cast<uintptr_t>(base) % intnat::TOWER_BUFFER_ALIGNMENT != 0)
+            return false;
+        for (size_t i = 1; i < e.GetNumOfElements(); ++i) {
+            const auto* tower = reinterpret_cast<const char*>(&e.GetElementAtIndex(i).GetValues()[0]);
+            if (tower != base + i * n * sizeof(NativeInteger))
+                return false;
+        }
+        return true;
+    };
+
+    Element expectedSum(a + b);
+    Element expectedProduct(a * b);
+    Element expectedSlice(a.CloneTowers(1, 2));
+
+    Element::SetTowerLayout(CONTIGUOUS_TOWERS);
+
+    Element zero(ildcrtparams, Format::EVALUATION, true);
+    EXPECT_TRUE(isContiguous(zero)) << msg << " Failure: constructor from parameters";
+    EXPECT_EQ(zero, Element(ildcrtparams, Format::EVALUATION, true)) << msg;
+
+    Element copy(a);
+    EXPECT_TRUE(isContiguous(copy)) << msg << " Failure: copy constructor";
+    EXPECT_EQ(a, copy) << msg;
+
+    Element slice(a.CloneTowers(1, 2));
+    EXPECT_TRUE(isContiguous(slice)) << msg << " Failure: CloneTowers";
+    EXPECT_EQ(expectedSlice, slice) << msg;
+
+    // contiguous towers are copied in one piece
+    Element sliceOfCopy(copy.CloneTowers(1, 2));
+    EXPECT_TRUE(isContiguous(sliceOfCopy)) << msg << " Failure: CloneTowers of contiguous towers";
+    EXPECT_EQ(expectedSlice, sliceOfCopy) << msg;
+    Element copyOfCopy(copy);
+    EXPECT_TRUE(isContiguous(copyOfCopy)) << msg << " Failure: copy of contiguous towers";
+    EXPECT_EQ(a, copyOfCopy) << msg;
+
+    // towers that are not zeroed are overwritten in place
+    Element overwritten(ildcrtparams, Format::EVALUATION);
+    for (size_t i = 0; i < towersize; ++i)
+        overwritten.SetElementAtIndex(i, a.GetElementAtIndex(i));
+    EXPECT_TRUE(isContiguous(overwritten)) << msg << " Failure: constructor without zeroing";
+    EXPECT_EQ(a, overwritten) << msg;
+
+    // the results do not depend on the layout, and the towers keep their value semantics
+    copy += b;
+    EXPECT_EQ(expectedSum, copy) << msg;
+    Element product(a.Clone());
+    product *= b;
+    EXPECT_EQ(expectedProduct, product) << msg;
+    EXPECT_EQ(expectedSlice, a.CloneTowers(1, 2)) << msg;
+
+    copy.DropLastElement();
+    EXPECT_EQ(towersize - 1, copy.GetNumOfElements()) << msg;
+    copy.SetElementAtIndex(0, b.GetElementAtIndex(0));
+    EXPECT_EQ(b.GetElementAtIndex(0), copy.GetElementAtIndex(0)) << msg;
+    EXPECT_TRUE(isContiguous(copy)) << msg << " Failure: copy into a tower";
+
+    Element::SetTowerLayout(SEPARATE_TOWERS);
+}
+
+TEST(UTDCRTPoly, DCRT_contiguous_towers) {
+    RUN_BIG_DCRTPOLYS(DCRT_contiguous_towers, "DCRT_contiguous_towers");
+}
+
+template <typename Element>
+void DCRT_coefficient_blocks(const std::string& msg) {
+    uint32_t order     = 2048;
+    uint32_t nBits     = 50;
+    uint32_t towersize = 3;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+    Element a(dug, ildcrtparams, Format::EVALUATION);
+    Element b(dug, ildcrtparams, Format::EVALUATION);
+    Element c(dug, ildcrtparams, Format::COEFFICIENT);
+
+    // constants of a rescaling by the last modulus; any values below the moduli give a valid comparison
+    const auto& ql = ildcrtparams->GetParams().back()->GetModulus();
+    std::vector<NativeInteger> qlInvModq, scale;
+    for (uint32_t i = 0; i + 1 < towersize; ++i) {
+        const auto& qi = ildcrtparams->GetParams()[i]->GetModulus();
+        qlInvModq.push_back(ql.ModInverse(qi));
+        scale.push_back(NativeInteger(1234567 + i).Mod(qi));
+    }
+    auto rescale = [&](const Element& e) {
+        Element r(e);
+        r.DropLastElementAndScale(scale, qlInvModq);
+        return r;
+    };
+    auto results = [&]() {
+        Element sum(a), difference(a), product(a);
+        sum += b;
+        difference -= b;
+        product *= b;
+        return std::vector<Element>{a + b, a - b, a * b, sum, difference, product, rescale(a), rescale(c)};
+    };
+
+    auto& controls        = OpenFHEParallelControls;
+    const size_t minBlock = controls.GetMinBlockSize();
+
+    // whole towers only
+    controls.SetMinBlockSize(0);
+    EXPECT_EQ(controls.GetBlocksPerRow(towersize, order / 2), 1U) << msg;
+    auto expected = results();
+
+    // blocks of 8 coefficients whenever there are more threads than towers
+    controls.SetMinBlockSize(8);
+    auto blocked = results();
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(expected[i], blocked[i]) << msg << " Failure: operation " << i;
+
+    Element product(a);
+    EXPECT_THROW(product *= c, OpenFHEException) << msg;
+
+    controls.SetMinBlockSize(minBlock);
+}
+
+TEST(UTDCRTPoly, DCRT_coefficient_blocks) {
+    RUN_BIG_DCRTPOLYS(DCRT_coefficient_blocks, "DCRT_coefficient_blocks");
+}
+
+TEST(UTDCRTPoly, DCRT_memory_stats) {
+    uint32_t order     = 2048;
+    uint32_t towersize = 4;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<BigInteger>>(order, towersize, 50);
+    DCRTPoly::DugType dug;
+    DCRTPoly a(dug, ildcrtparams, Format::EVALUATION);
+
+    MemoryProfiler::Reset();
+    {
+        MemoryStatsScope outer("Copy");
+        MemoryStatsScope inner("Nested");
+        DCRTPoly copy(a);
+        DCRTPoly moved(std::move(copy));
+    }
+    auto stats = MemoryProfiler::GetScope("Copy");
+#ifdef WITH_MEMORY_STATS
+    EXPECT_EQ(stats.calls, 1U);
+    EXPECT_EQ(stats.polyCopies, 1U);
+    EXPECT_EQ(stats.polyMoves, 1U);
+    EXPECT_EQ(stats.vectorCopies, towersize);
+    uint32_t n = order / 2;
+    EXPECT_EQ(stats.vectorCopiedBytes, towersize * n * sizeof(NativeInteger));
+    EXPECT_EQ(stats.allocatedBytes, towersize * n * sizeof(NativeInteger));
+    EXPECT_EQ(stats.peakLiveBytes, 0U) << "Failure: peak recorded for a call";
+    EXPECT_GE(MemoryProfiler::GetTotals().peakLiveBytes, stats.allocatedBytes);
+    EXPECT_EQ(MemoryProfiler::GetScope("Nested").calls, 0U) << "Failure: nested scope recorded";
+    EXPECT_NE(MemoryProfiler::ToJSON().find("\"Copy\": {\"calls\": 1,"), std::string::npos);
+#else
+    EXPECT_EQ(stats.calls, 1U);
+    EXPECT_EQ(stats.allocations, 0U) << "Failure: hooks not compiled out";
+    EXPECT_EQ(MemoryProfiler::GetTotals().vectorCopies, 0U) << "Failure: hooks not compiled out";
+#endif
+    MemoryProfiler::Reset();
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
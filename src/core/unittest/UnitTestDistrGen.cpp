@@ -41,6 +41,7 @@
 #include "lattice/lat-hal.h"
 #include "math/distrgen.h"
 #include "math/nbtheory.h"
+#include "math/seededuniformgenerator.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
 #include "utils/utilities.h"
@@ -389,6 +390,31 @@ TEST(UTDistrGen, BinaryUniformGenerator) {
     RUN_ALL_BACKENDS(BinaryUniformGeneratorTest, "BinaryUniformGeneratorTest")
 }
 
+TEST(UTDistrGen, SeededUniformGenerator) {
+    const NativeInteger modulus("1152921504606830593");
+    const uint32_t length = 100000;
+
+    const auto seed = SeededUniformGenerator::GenerateSeed();
+    NativeVector v0 = SeededUniformGenerator::GenerateVector(seed, 0, length, modulus);
+    NativeVector v1 = SeededUniformGenerator::GenerateVector(seed, 1, length, modulus);
+
+    // the same seed and stream id always give the same vector
+    EXPECT_EQ(v0, SeededUniformGenerator::GenerateVector(seed, 0, length, modulus));
+    EXPECT_NE(v0, v1) << "different streams give the same vector";
+
+    auto otherSeed = seed;
+    otherSeed[0] ^= 1;
+    EXPECT_NE(v0, SeededUniformGenerator::GenerateVector(otherSeed, 0, length, modulus))
+        << "different seeds give the same vector";
+
+    double mean = 0;
+    for (uint32_t i = 0; i < length; ++i) {
+        EXPECT_LT(v0[i], modulus);
+        mean += v0[i].ConvertToDouble() / modulus.ConvertToDouble();
+    }
+    EXPECT_LT(std::abs(mean / length - 0.5), 0.01) << "Seeded Uniform Distribution Failure Mean is incorrect";
+}
+
 // mean test
 template <typename V>
 void TernaryUniformGeneratorTest(const std::string& msg) {
@@ -39,6 +39,8 @@
   */
 
 #include <iostream>
+#include <random>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
@@ -111,3 +113,212 @@ void switch_format_simple_double_crt(const std::string& msg) {
 TEST(UTNTT, switch_format_simple_double_crt) {
     RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt, "switch_format_simple_double_crt")
 }
+
+TEST(UTNTT, simd_backends_match_scalar) {
+    const auto defaultBackend{intnat::GetNTTBackend()};
+    for (usint n : {16, 32, 1024, 8192}) {
+        usint m = n << 1;
+        NativeInteger modulus(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+        NativeInteger rootOfUnity(RootOfUnity(m, modulus));
+        ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootOfUnity, m, modulus);
+
+        DiscreteUniformGeneratorImpl<NativeVector> dug;
+        NativeVector input(dug.GenerateVector(n, modulus));
+        // exercise the boundary values of the lazy reductions
+        input[0] = modulus - NativeInteger(1);
+        input[1] = 0;
+
+        intnat::SetNTTBackend(intnat::SCALAR_NTT);
+        NativeVector forward(input);
+        ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(rootOfUnity, m, &forward);
+        NativeVector inverse(input);
+        ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(rootOfUnity, m, &inverse);
+
+        for (auto backend : {intnat::AVX2_NTT, intnat::AVX512_NTT}) {
+            if (!intnat::IsNTTBackendSupported(backend))
+                continue;
+            std::string msg{"backend " + std::to_string(backend) + ", n = " + std::to_string(n)};
+            intnat::SetNTTBackend(backend);
+
+            NativeVector forwardSIMD(input);
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(rootOfUnity, m,
+                                                                                              &forwardSIMD);
+            EXPECT_EQ(forward, forwardSIMD) << msg;
+
+            NativeVector forwardCopy(n);
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(input, rootOfUnity, m,
+                                                                                       &forwardCopy);
+            EXPECT_EQ(forward, forwardCopy) << msg;
+
+            NativeVector inverseSIMD(input);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                                                                &inverseSIMD);
+            EXPECT_EQ(inverse, inverseSIMD) << msg;
+
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                                                                &forwardSIMD);
+            EXPECT_EQ(input, forwardSIMD) << msg;
+        }
+    }
+    intnat::SetNTTBackend(defaultBackend);
+}
+
+#if defined(HAVE_INT128)
+// the lazy values of the kernels reach 4q, which is above 2^63 for moduli of 62 bits; the kernels have to compare
+// them as unsigned integers. The moduli and twiddles need not form a valid NTT for the backends to agree.
+TEST(UTNTT, simd_backends_wide_modulus) {
+    const uint32_t n{1024};
+    const uint64_t q{(uint64_t(1) << 62) - 57};
+    std::mt19937_64 rng(42);
+    auto random = [&]() {
+        return rng() % q;
+    };
+    // Shoup's precomputation floor(w * 2^64 / q)
+    auto precon = [&](uint64_t w) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(w) << 64) / q);
+    };
+    std::vector<uint64_t> roots(n), preconRoots(n), input(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        roots[i]       = random();
+        preconRoots[i] = precon(roots[i]);
+        input[i]       = random();
+    }
+    input[0] = q - 1;
+    const uint64_t nInv{random()}, omega1Inv{random()};
+
+    auto transform = [&](intnat::NTTBackend backend, bool forward) {
+        std::vector<uint64_t> values(input);
+        intnat::NTTBatchEntry entry{values.data(), roots.data(), preconRoots.data(), q,
+                                    nInv,          precon(nInv), omega1Inv,          precon(omega1Inv)};
+        if (forward)
+            intnat::ForwardTransformToBitReverseInPlaceBatch(backend, &entry, 1, n);
+        else
+            intnat::InverseTransformFromBitReverseInPlaceBatch(backend, &entry, 1, n);
+        return values;
+    };
+
+    for (bool forward : {true, false}) {
+        const auto expected = transform(intnat::SCALAR_NTT, forward);
+        for (auto backend : {intnat::AVX2_NTT, intnat::AVX512_NTT}) {
+            if (intnat::IsNTTBackendSupported(backend))
+                EXPECT_EQ(expected, transform(backend, forward)) << "backend " << backend << ", forward " << forward;
+        }
+    }
+}
+#endif
+
+TEST(UTNTT, fused_multi_tower_matches_single) {
+    const auto defaultBackend{intnat::GetNTTBackend()};
+    const usint towers{3};
+    // ring dimensions below, at and above NTT_CACHE_BLOCK_SIZE
+    for (usint n : {16, 2048, 4096, 16384}) {
+        usint m = n << 1;
+        std::vector<NativeInteger> roots;
+        std::vector<NativeVector> inputs;
+        NativeInteger modulus(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+        DiscreteUniformGeneratorImpl<NativeVector> dug;
+        for (usint i = 0; i < towers; ++i) {
+            roots.push_back(RootOfUnity(m, modulus));
+            inputs.push_back(dug.GenerateVector(n, modulus));
+            modulus = PreviousPrime(modulus, m);
+        }
+
+        intnat::SetNTTBackend(intnat::SCALAR_NTT);
+        std::vector<NativeVector> forward(inputs), inverse(inputs);
+        for (usint i = 0; i < towers; ++i) {
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(roots[i], m, &forward[i]);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots[i], m,
+                                                                                                &inverse[i]);
+        }
+
+        for (auto backend : {intnat::SCALAR_NTT, intnat::AVX2_NTT, intnat::AVX512_NTT}) {
+            if (!intnat::IsNTTBackendSupported(backend))
+                continue;
+            std::string msg{"backend " + std::to_string(backend) + ", n = " + std::to_string(n)};
+            intnat::SetNTTBackend(backend);
+
+            std::vector<NativeVector> forwardFused(inputs), inverseFused(inputs);
+            std::vector<NativeVector*> forwardPtrs, inversePtrs;
+            for (usint i = 0; i < towers; ++i) {
+                forwardPtrs.push_back(&forwardFused[i]);
+                inversePtrs.push_back(&inverseFused[i]);
+            }
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(roots, m, forwardPtrs);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots, m, inversePtrs);
+            for (usint i = 0; i < towers; ++i) {
+                EXPECT_EQ(forward[i], forwardFused[i]) << msg << ", tower " << i;
+                EXPECT_EQ(inverse[i], inverseFused[i]) << msg << ", tower " << i;
+            }
+
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots, m, forwardPtrs);
+            for (usint i = 0; i < towers; ++i)
+                EXPECT_EQ(inputs[i], forwardFused[i]) << msg << ", tower " << i;
+        }
+    }
+    intnat::SetNTTBackend(defaultBackend);
+}
+
+TEST(UTNTT, twiddle_registry_handles) {
+    using Registry = intnat::NTTTwiddleRegistry<NativeVector>;
+    const usint n{1024}, m{n << 1};
+    NativeInteger modulus(LastPrime<NativeInteger>(MAX_MODULUS_SIZE - 2, m));
+    NativeInteger root(RootOfUnity(m, modulus));
+
+    // parameters register their tables eagerly, and all registrations of a key share one handle
+    ILNativeParams params(m, modulus, root);
+    uint32_t handle{params.GetNTTHandle()};
+    ASSERT_NE(handle, intnat::NTT_INVALID_HANDLE);
+    EXPECT_EQ(handle, Registry::Find(modulus, m).GetHandle());
+    EXPECT_EQ(handle, Registry::Register(root, m, modulus).GetHandle());
+    EXPECT_EQ(handle, ILNativeParams(params).GetNTTHandle());
+    EXPECT_EQ(Registry::Get(handle).modulus, modulus);
+    EXPECT_EQ(Registry::Get(handle).cycloOrder, m);
+    EXPECT_EQ(Registry::Find(modulus, m << 1).GetHandle(), intnat::NTT_INVALID_HANDLE);
+
+    // parameters without a proper root of unity do not get tables
+    EXPECT_EQ(ILNativeParams(m, modulus, NativeInteger(1)).GetNTTHandle(), intnat::NTT_INVALID_HANDLE);
+    EXPECT_EQ(ILNativeParams(8, NativeInteger(1234), NativeInteger(5678)).GetNTTHandle(), intnat::NTT_INVALID_HANDLE);
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector input(dug.GenerateVector(n, modulus));
+    NativeVector byRoot(input), byHandle(input);
+    ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(root, m, &byRoot);
+    ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(handle, &byHandle);
+    EXPECT_EQ(byRoot, byHandle);
+    ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(handle, &byHandle);
+    EXPECT_EQ(input, byHandle);
+
+    // concurrent registration of a new key yields a single entry
+    NativeInteger modulus2(PreviousPrime(modulus, m));
+    NativeInteger root2(RootOfUnity(m, modulus2));
+    const int threads{8};
+    std::vector<uint32_t> handles(threads);
+#pragma omp parallel for num_threads(threads)
+    for (int i = 0; i < threads; ++i)
+        handles[i] = Registry::Register(root2, m, modulus2).GetHandle();
+    for (int i = 0; i < threads; ++i)
+        EXPECT_EQ(handles[i], handles[0]);
+    EXPECT_NE(handles[0], handle);
+    EXPECT_EQ(handles[0], Registry::Find(modulus2, m).GetHandle());
+}
+
+TEST(UTNTT, twiddle_registry_recycling) {
+    using Registry = intnat::NTTTwiddleRegistry<NativeVector>;
+    const usint m{16};
+    NativeInteger modulus(LastPrime<NativeInteger>(30, m));
+    NativeInteger root(RootOfUnity(m, modulus));
+
+    // referenced tables outlive Reset()
+    auto reference = Registry::Register(root, m, modulus);
+    Registry::Reset();
+    EXPECT_EQ(Registry::Find(modulus, m).GetHandle(), intnat::NTT_INVALID_HANDLE);
+    EXPECT_EQ(Registry::Get(reference.GetHandle()).modulus, modulus);
+    reference = {};
+
+    // unreferenced tables are freed by Reset(), and their handles are recycled, so registering more tables than
+    // the registry can hold at once succeeds
+    for (uint32_t i = 0; i < 70000; ++i) {
+        Registry::Register(root, m, modulus);
+        Registry::Reset();
+    }
+}
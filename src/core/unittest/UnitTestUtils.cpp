@@ -37,8 +37,24 @@
 #include <iostream>
 #include "include/gtest/gtest.h"
 
+#include "utils/exception.h"
+#include "utils/mappedfile.h"
+#include "utils/numa.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+    #include <stdlib.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 using namespace lbcrypto;
 
 TEST(Utilities, IsPowerOfTwo) {
@@ -53,3 +69,146 @@ TEST(Utilities, IsPowerOfTwo) {
         EXPECT_FALSE(IsPowerOfTwo(not_power_of_two));
     }
 }
+
+TEST(Utilities, ParallelFor) {
+    const ParallelBackend backend{OpenFHEParallelControls.GetBackend()};
+    for (auto b : {OPENMP_BACKEND, TASK_POOL_BACKEND}) {
+        OpenFHEParallelControls.SetBackend(b);
+
+        // nested loops cover every index exactly once
+        std::vector<std::vector<uint32_t>> v(37, std::vector<uint32_t>(101, 0));
+        OpenFHEParallelControls.ParallelFor(0, v.size(), [&](size_t i) {
+            OpenFHEParallelControls.ParallelFor(0, v[i].size(), [&](size_t j) { v[i][j] += i * 1000 + j; });
+        });
+        for (size_t i = 0; i < v.size(); ++i) {
+            for (size_t j = 0; j < v[i].size(); ++j)
+                ASSERT_EQ(v[i][j], i * 1000 + j) << "Failure: backend " << b;
+        }
+
+        std::vector<uint32_t> offset(10, 0);
+        OpenFHEParallelControls.ParallelFor(3, 7, [&](size_t i) { offset[i] = 1; });
+        EXPECT_EQ(offset, std::vector<uint32_t>({0, 0, 0, 1, 1, 1, 1, 0, 0, 0})) << "Failure: backend " << b;
+    }
+
+    // the task pool hands exceptions back to the calling thread
+    OpenFHEParallelControls.SetBackend(TASK_POOL_BACKEND);
+    EXPECT_THROW(OpenFHEParallelControls.ParallelFor(0, 64,
+                                                     [](size_t i) {
+                                                         if (i == 57)
+                                                             throw std::runtime_error("task failure");
+                                                     }),
+                 std::runtime_error);
+
+    OpenFHEParallelControls.SetBackend(backend);
+}
+
+TEST(Utilities, NumaTopology) {
+    EXPECT_EQ(NumaTopology::ParseCPUList("0-3,8,10-11\n"), std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_TRUE(NumaTopology::ParseCPUList("").empty());
+
+    // a missing directory is one node with every CPU
+    NumaTopology single("/nonexistent");
+    EXPECT_EQ(single.GetNumNodes(), 1U);
+    EXPECT_FALSE(single.GetNodeCPUs(0).empty());
+
+#ifdef __linux__
+    char dir[] = "/tmp/openfhe-numa-XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    const std::string root{dir};
+    const std::vector<std::pair<std::string, std::string>> nodes{{"node0", "0-1,4-5"}, {"node2", "2-3,6-7"}};
+    for (const auto& [node, cpus] : nodes) {
+        mkdir((root + "/" + node).c_str(), 0700);
+        std::ofstream(root + "/" + node + "/cpulist") << cpus << "\n";
+    }
+    mkdir((root + "/power").c_str(), 0700);
+
+    NumaTopology two(root);
+    ASSERT_EQ(two.GetNumNodes(), 2U);
+    EXPECT_EQ(two.GetNodeId(1), 2U);
+    EXPECT_EQ(two.GetNodeCPUs(1), std::vector<uint32_t>({2, 3, 6, 7}));
+    EXPECT_EQ(two.GetNodeOfCPU(5), 0U);
+    EXPECT_EQ(two.GetNodeOfCPU(6), 1U);
+
+    for (const auto& [node, _] : nodes) {
+        std::remove((root + "/" + node + "/cpulist").c_str());
+        rmdir((root + "/" + node).c_str());
+    }
+    rmdir((root + "/power").c_str());
+    rmdir(dir);
+#endif
+
+    // loops give the same results with the threads bound to the nodes of the machine
+    const ParallelBackend backend{OpenFHEParallelControls.GetBackend()};
+    OpenFHEParallelControls.SetNumaMode(true);
+    EXPECT_TRUE(OpenFHEParallelControls.GetNumaMode());
+    for (auto b : {OPENMP_BACKEND, TASK_POOL_BACKEND}) {
+        OpenFHEParallelControls.SetBackend(b);
+        std::vector<uint32_t> v(1000, 0);
+        OpenFHEParallelControls.ParallelFor(0, v.size(), [&](size_t i) { v[i] = i; });
+        for (size_t i = 0; i < v.size(); ++i)
+            ASSERT_EQ(v[i], i) << "Failure: backend " << b;
+    }
+    std::vector<uint64_t> buffer(1 << 16, 7);
+    NumaInterleave(buffer.data(), buffer.size() * sizeof(uint64_t));
+    EXPECT_EQ(buffer, std::vector<uint64_t>(1 << 16, 7)) << "Failure: interleaving changed the data";
+    OpenFHEParallelControls.SetNumaMode(false);
+    EXPECT_FALSE(OpenFHEParallelControls.GetNumaMode());
+    OpenFHEParallelControls.SetBackend(backend);
+}
+
+TEST(Utilities, MappedFile) {
+    const std::string path{"mappedfile-test.bin"};
+    std::string contents(10000, 0);
+    for (size_t i = 0; i < contents.size(); ++i)
+        contents[i] = static_cast<char>(i * 7);
+    std::ofstream(path, std::ios::binary).write(contents.data(), contents.size());
+
+    {
+        MappedFile file(path);
+        ASSERT_EQ(file.GetSize(), contents.size());
+        EXPECT_EQ(std::string(file.GetData(), file.GetSize()), contents);
+        // advice only changes residency, never the contents
+        file.WillNeed(4000, 100000);
+        file.DontNeed(1, 5000);
+        EXPECT_EQ(std::string(file.GetData(), file.GetSize()), contents);
+
+        MemoryStreamBuf buf(file.GetData() + 100, 50);
+        std::istream is(&buf);
+        std::string part(20, 0);
+        is.read(&part[0], part.size());
+        EXPECT_EQ(part, contents.substr(100, 20));
+        is.seekg(45);
+        is.read(&part[0], part.size());
+        EXPECT_EQ(is.gcount(), 5) << "Failure: read past the end of the range";
+        EXPECT_EQ(part.substr(0, 5), contents.substr(145, 5));
+    }
+    std::remove(path.c_str());
+
+    EXPECT_THROW(MappedFile("/nonexistent/mappedfile-test.bin"), OpenFHEException);
+}
+
+TEST(Utilities, ParallelFor2D) {
+    const ParallelBackend backend{OpenFHEParallelControls.GetBackend()};
+    const size_t minBlock{OpenFHEParallelControls.GetMinBlockSize()};
+    OpenFHEParallelControls.SetMinBlockSize(8);
+    for (auto b : {OPENMP_BACKEND, TASK_POOL_BACKEND}) {
+        OpenFHEParallelControls.SetBackend(b);
+
+        // blocks never overlap and cover every column of every row, also when cols is not a multiple of 8
+        for (size_t rows : {1, 2, 64}) {
+            std::vector<std::vector<uint32_t>> v(rows, std::vector<uint32_t>(1003, 0));
+            OpenFHEParallelControls.ParallelFor2D(rows, 1003, [&](size_t i, size_t first, size_t last) {
+                for (size_t j = first; j < last; ++j)
+                    v[i][j] += 1;
+            });
+            for (size_t i = 0; i < rows; ++i)
+                ASSERT_EQ(v[i], std::vector<uint32_t>(1003, 1)) << "Failure: backend " << b << " rows " << rows;
+        }
+        EXPECT_EQ(OpenFHEParallelControls.GetBlocksPerRow(1, 15), 1U) << "Failure: block below the minimum size";
+    }
+    OpenFHEParallelControls.SetMinBlockSize(0);
+    EXPECT_EQ(OpenFHEParallelControls.GetBlocksPerRow(1, 1 << 16), 1U) << "Failure: split not disabled";
+
+    OpenFHEParallelControls.SetMinBlockSize(minBlock);
+    OpenFHEParallelControls.SetBackend(backend);
+}
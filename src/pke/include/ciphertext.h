@@ -42,7 +42,9 @@
 #include "metadata.h"
 #include "key/key.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -86,7 +88,7 @@ public:
    * Copy constructor
    */
     CiphertextImpl(const CiphertextImpl<Element>& ciphertext) : CryptoObject<Element>(ciphertext) {
-        m_elements         = ciphertext.m_elements;
+        CopyElements(ciphertext);
         m_noiseScaleDeg    = ciphertext.m_noiseScaleDeg;
         m_level            = ciphertext.m_level;
         m_hopslevel        = ciphertext.m_hopslevel;
@@ -98,7 +100,7 @@ public:
     }
 
     explicit CiphertextImpl(Ciphertext<Element> ciphertext) : CryptoObject<Element>(*ciphertext) {
-        m_elements         = ciphertext->m_elements;
+        CopyElements(*ciphertext);
         m_noiseScaleDeg    = ciphertext->m_noiseScaleDeg;
         m_level            = ciphertext->m_level;
         m_hopslevel        = ciphertext->m_hopslevel;
@@ -113,7 +115,7 @@ public:
    * Move constructor
    */
     CiphertextImpl(CiphertextImpl<Element>&& ciphertext) : CryptoObject<Element>(ciphertext) {
-        m_elements         = std::move(ciphertext.m_elements);
+        MoveElements(std::move(ciphertext));
         m_noiseScaleDeg    = std::move(ciphertext.m_noiseScaleDeg);
         m_level            = std::move(ciphertext.m_level);
         m_hopslevel        = std::move(ciphertext.m_hopslevel);
@@ -125,7 +127,7 @@ public:
     }
 
     explicit CiphertextImpl(Ciphertext<Element>&& ciphertext) : CryptoObject<Element>(*ciphertext) {
-        m_elements         = std::move(ciphertext->m_elements);
+        MoveElements(std::move(*ciphertext));
         m_noiseScaleDeg    = std::move(ciphertext->m_noiseScaleDeg);
         m_level            = std::move(ciphertext->m_level);
         m_hopslevel        = std::move(ciphertext->m_hopslevel);
@@ -183,7 +185,7 @@ public:
     CiphertextImpl<Element>& operator=(const CiphertextImpl<Element>& rhs) {
         if (this != &rhs) {
             CryptoObject<Element>::operator=(rhs);
-            this->m_elements         = rhs.m_elements;
+            this->CopyElements(rhs);
             this->m_noiseScaleDeg    = rhs.m_noiseScaleDeg;
             this->m_level            = rhs.m_level;
             this->m_hopslevel        = rhs.m_hopslevel;
@@ -206,7 +208,7 @@ public:
     CiphertextImpl<Element>& operator=(CiphertextImpl<Element>&& rhs) {
         if (this != &rhs) {
             CryptoObject<Element>::operator=(rhs);
-            this->m_elements         = std::move(rhs.m_elements);
+            this->MoveElements(std::move(rhs));
             this->m_noiseScaleDeg    = std::move(rhs.m_noiseScaleDeg);
             this->m_level            = std::move(rhs.m_level);
             this->m_hopslevel        = std::move(rhs.m_hopslevel);
@@ -227,6 +229,7 @@ public:
    * @return the first (and only!) ring element
    */
     const Element& GetElement() const {
+        ExpandSeed();
         if (m_elements.size() == 1)
             return m_elements[0];
 
@@ -242,6 +245,7 @@ public:
    * @return the first (and only!) ring element
    */
     Element& GetElement() {
+        ExpandSeed();
         if (m_elements.size() == 1)
             return m_elements[0];
 
@@ -255,6 +259,7 @@ public:
    * @return vector of ring elements
    */
     const std::vector<Element>& GetElements() const {
+        ExpandSeed();
         return m_elements;
     }
 
@@ -263,11 +268,13 @@ public:
    * @return vector of ring elements
    */
     std::vector<Element>& GetElements() {
+        ExpandSeed();
         return m_elements;
     }
 
     size_t NumberCiphertextElements() const {
-        return m_elements.size();
+        std::lock_guard<std::mutex> lock(m_seedMutex);
+        return m_elements.size() + (m_seed.empty() ? 0 : 1);
     }
 
     /**
@@ -277,6 +284,7 @@ public:
    * @param &element is a polynomial ring element.
    */
     void SetElement(const Element& element) {
+        ExpandSeed();
         if (m_elements.size() == 0)
             m_elements.push_back(element);
         else if (m_elements.size() == 1)
@@ -293,6 +301,7 @@ public:
    * @param &element is a polynomial ring element.
    */
     void SetElements(const std::vector<Element>& elements) {
+        ClearSeed();
         m_elements = elements;
     }
 
@@ -302,9 +311,57 @@ public:
    * @param &&element is a polynomial ring element.
    */
     void SetElements(std::vector<Element>&& elements) {
+        ClearSeed();
         m_elements = std::move(elements);
     }
 
+    /**
+   * Turns the ciphertext into a seeded ciphertext: the elements set so far are all elements but the last, and the
+   * last one is expanded from the seed on first access. A fresh secret-key encryption is stored this way, so it takes
+   * half of the memory and of the serialized size until it is used.
+   *
+   * @param &seed is the seed of the last element, see ExpandSeededElement().
+   */
+    void SetSeed(const std::vector<uint32_t>& seed) {
+        if (seed.size() != SEED_WORDS)
+            OPENFHE_THROW("Seed must have " + std::to_string(SEED_WORDS) + " words");
+        std::lock_guard<std::mutex> lock(m_seedMutex);
+        if (m_elements.empty() || !m_seed.empty())
+            OPENFHE_THROW("Seeded ciphertexts need all elements but the last one set, and a single seed");
+        m_seed = seed;
+        m_seeded.store(true, std::memory_order_release);
+    }
+
+    /**
+   * Returns true if the last element of the ciphertext is still stored as a seed
+   */
+    bool IsSeeded() const {
+        return m_seeded.load(std::memory_order_acquire);
+    }
+
+    /**
+   * Returns the elements stored in the ciphertext without expanding its seed, e.g. for serialization.
+   *
+   * @param &seed receives the seed of the last element, or is cleared if the ciphertext stores all of its elements.
+   * @return all elements of the ciphertext, or all elements but the last one if the ciphertext is seeded.
+   */
+    std::vector<Element> GetStoredElements(std::vector<uint32_t>& seed) const {
+        std::lock_guard<std::mutex> lock(m_seedMutex);
+        seed = m_seed;
+        return m_elements;
+    }
+
+    /**
+   * Expands the last element of a seeded ciphertext. Tower i is drawn from the stream i of the seed, so the
+   * expansion does not depend on the number of towers that follow it.
+   *
+   * @param &seed the seed of the ciphertext.
+   * @param &params the parameters of the element to generate.
+   * @return the uniformly random element in EVALUATION format.
+   */
+    static Element ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                       const std::shared_ptr<typename Element::Params>& params);
+
     /**
    * Get the degree of the scaling factor for the encrypted message.
    */
@@ -456,6 +513,10 @@ public:
         (*m_metadataMap)[key] = std::move(value);
     }
 
+    /**
+   * Returns a copy of this ciphertext. A seeded ciphertext is expanded first, so that the copies used in
+   * homomorphic operations share the expanded element.
+   */
     virtual Ciphertext<Element> Clone() const {
         Ciphertext<Element> cRes = this->CloneZero();
         cRes->SetElements(this->GetElements());
@@ -536,10 +597,11 @@ public:
         for (auto i = c.m_metadataMap->begin(); i != c.m_metadataMap->end(); ++i)
             out << "(\"" << i->first << "\", " << *(i->second) << ") ";
         out << "]" << std::endl;
-        for (size_t i = 0; i < c.m_elements.size(); i++) {
+        const auto& elements = c.GetElements();
+        for (size_t i = 0; i < elements.size(); i++) {
             if (i != 0)
                 out << std::endl;
-            out << "Element " << i << ": " << c.m_elements[i];
+            out << "Element " << i << ": " << elements[i];
         }
         return out;
     }
@@ -551,7 +613,12 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(cereal::base_class<CryptoObject<Element>>(this));
-        ar(cereal::make_nvp("v", m_elements));
+        {
+            // a seeded ciphertext is saved without expanding its last element
+            std::lock_guard<std::mutex> lock(m_seedMutex);
+            ar(cereal::make_nvp("v", m_elements));
+            ar(cereal::make_nvp("sd", m_seed));
+        }
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -570,6 +637,13 @@ public:
         }
         ar(cereal::base_class<CryptoObject<Element>>(this));
         ar(cereal::make_nvp("v", m_elements));
+        m_seed.clear();
+        if (version > 1) {
+            ar(cereal::make_nvp("sd", m_seed));
+            if (!m_seed.empty() && (m_seed.size() != SEED_WORDS || m_elements.empty()))
+                OPENFHE_THROW("Invalid seed of a seeded ciphertext");
+        }
+        m_seeded.store(!m_seed.empty(), std::memory_order_release);
         ar(cereal::make_nvp("d", m_noiseScaleDeg));
         ar(cereal::make_nvp("l", m_level));
         ar(cereal::make_nvp("t", m_hopslevel));
@@ -584,12 +658,54 @@ public:
         return "Ciphertext";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
-    // vector of ring elements for this Ciphertext
-    std::vector<Element> m_elements;
+    // number of 32-bit words of a seed, as in SeededUniformGenerator
+    static constexpr uint32_t SEED_WORDS = 8;
+
+    // expands the last element of a seeded ciphertext; thread-safe, so that const accessors can call it
+    void ExpandSeed() const {
+        if (!m_seeded.load(std::memory_order_acquire))
+            return;
+        std::lock_guard<std::mutex> lock(m_seedMutex);
+        if (!m_seed.empty()) {
+            m_elements.push_back(ExpandSeededElement(m_seed, m_elements.back().GetParams()));
+            m_seed.clear();
+            m_seeded.store(false, std::memory_order_release);
+        }
+    }
+
+    void ClearSeed() {
+        std::lock_guard<std::mutex> lock(m_seedMutex);
+        m_seed.clear();
+        m_seeded.store(false, std::memory_order_release);
+    }
+
+    void CopyElements(const CiphertextImpl<Element>& rhs) {
+        std::lock_guard<std::mutex> lock(rhs.m_seedMutex);
+        m_elements = rhs.m_elements;
+        m_seed     = rhs.m_seed;
+        m_seeded.store(!m_seed.empty(), std::memory_order_release);
+    }
+
+    void MoveElements(CiphertextImpl<Element>&& rhs) {
+        m_elements = std::move(rhs.m_elements);
+        m_seed     = std::move(rhs.m_seed);
+        m_seeded.store(!m_seed.empty(), std::memory_order_release);
+        rhs.m_seed.clear();
+        rhs.m_seeded.store(false, std::memory_order_release);
+    }
+
+    // vector of ring elements for this Ciphertext; of a seeded ciphertext, all elements but the last one, which is
+    // appended on first access (mutable, so that the const accessors can expand it)
+    mutable std::vector<Element> m_elements;
+
+    // seed of the last element of a seeded ciphertext, empty once the element is expanded
+    mutable std::vector<uint32_t> m_seed;
+    mutable std::atomic<bool> m_seeded{false};
+    mutable std::mutex m_seedMutex;
 
     // the degree of the scaling factor for the encrypted message.
     uint32_t m_noiseScaleDeg = 1;
@@ -611,6 +727,16 @@ private:
     MetadataMap m_metadataMap = std::make_shared<std::map<std::string, std::shared_ptr<Metadata>>>();
 };
 
+template <>
+DCRTPoly CiphertextImpl<DCRTPoly>::ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                                       const std::shared_ptr<DCRTPoly::Params>& params);
+template <>
+NativePoly CiphertextImpl<NativePoly>::ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                                           const std::shared_ptr<NativePoly::Params>& params);
+template <>
+Poly CiphertextImpl<Poly>::ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                               const std::shared_ptr<Poly::Params>& params);
+
 // TODO the op= are not doing the work in-place, and should be updated
 
 /**
@@ -44,6 +44,7 @@
 
 #include "key/evalkey.h"
 #include "key/keypair.h"
+#include "key/keystore.h"
 
 #include "schemebase/base-pke.h"
 #include "schemebase/base-scheme.h"
@@ -52,6 +53,7 @@
 #include "scheme/scheme-swch-params.h"
 
 #include "utils/caller_info.h"
+#include "utils/memory-stats.h"
 #include "utils/serial.h"
 #include "utils/type_name.h"
 
@@ -69,6 +71,8 @@
 
 namespace lbcrypto {
 
+class EvalKeyStoreWriter;
+
 /**
  * @brief CryptoContextImpl
  *
@@ -230,30 +234,43 @@ class CryptoContextImpl : public Serializable {
    * @param indexList - array of specific indices to check the key map against
    * @return indices that do not have automorphism keys associated with
    */
-    static std::set<uint32_t> GetEvalAutomorphismNoKeyIndices(const std::string& keyID,
-                                                              const std::set<uint32_t>& indices) {
-        std::set<uint32_t> existingIndices{CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(keyID)};
+    std::set<uint32_t> GetEvalAutomorphismNoKeyIndices(const std::string& keyID,
+                                                       const std::set<uint32_t>& indices) const {
+        std::set<uint32_t> existingIndices;
+        if (const auto keyMap = GetKeyStore().FindEvalAutomorphismKeys(keyID)) {
+            for (const auto& [index, _] : *keyMap)
+                existingIndices.insert(index);
+        }
         // if no index found for the given keyID, then the entire set "indices" is returned
         return (existingIndices.empty()) ? indices :
                                            CryptoContextImpl<Element>::GetUniqueValues(existingIndices, indices);
     }
     /**
-   * Get automorphism keys for a specific secret key tag
-   */
-    static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(const std::string& keyID);
-    /**
    * @brief Get automorphism keys for a specific secret key tag and an array of specific indices
+   * @param store - key store to get the keys from
    * @param keyID - secret key tag
    * @param indexList - array of specific indices to retrieve key for
    * @return shared_ptr to std::map where the map key/data pair is index/automorphism key
    */
     static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetPartialEvalAutomorphismKeyMapPtr(
-        const std::string& keyID, const std::vector<uint32_t>& indexList);
+        const KeyStore<Element>& store, const std::string& keyID, const std::vector<uint32_t>& indexList);
 
-    // cached evalmult keys, by secret key UID
-    static std::map<std::string, std::vector<EvalKey<Element>>> s_evalMultKeyMap;
-    // cached evalautomorphism keys, by secret key UID
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> s_evalAutomorphismKeyMap;
+    /**
+   * @brief Get the key store of a crypto context, or the shared store if the context is null
+   */
+    static KeyStore<Element>& GetKeyStoreOf(const CryptoContext<Element>& cc) {
+        return cc ? cc->GetKeyStore() : s_keyStore;
+    }
+
+    /**
+   * @brief Add automorphism keys to a key store
+   */
+    static void InsertEvalAutomorphismKey(KeyStore<Element>& store,
+                                          const std::shared_ptr<std::map<usint, EvalKey<Element>>> mapToInsert,
+                                          const std::string& keyTag);
+
+    // cached evalmult and evalautomorphism keys, by secret key UID, shared by the contexts without a key store
+    static KeyStore<Element> s_keyStore;
 
 protected:
     // crypto parameters used for this context
@@ -265,6 +282,9 @@ protected:
 
     uint32_t m_keyGenLevel{0};
 
+    // key store owned by this context (and possibly others); nullptr for the shared store
+    std::shared_ptr<KeyStore<Element>> m_keyStore{nullptr};
+
     /**
    * TypeCheck makes sure that an operation between two ciphertexts is permitted
    * @param a
@@ -559,6 +579,7 @@ public:
         scheme              = c.scheme;
         this->m_keyGenLevel = 0;
         this->m_schemeId    = c.m_schemeId;
+        this->m_keyStore    = c.m_keyStore;
     }
 
     /**
@@ -571,6 +592,7 @@ public:
         scheme        = rhs.scheme;
         m_keyGenLevel = rhs.m_keyGenLevel;
         m_schemeId    = rhs.m_schemeId;
+        m_keyStore    = rhs.m_keyStore;
         return *this;
     }
 
@@ -634,13 +656,13 @@ public:
    */
     template <typename ST>
     static bool SerializeEvalMultKey(std::ostream& ser, const ST& sertype, std::string id = "") {
-        const auto& evalMultKeys = CryptoContextImpl<Element>::GetAllEvalMultKeys();
+        const auto evalMultKeys = CryptoContextImpl<Element>::GetEvalKeyStore().GetEvalMultKeys();
         if (id.length() == 0) {
-            Serial::Serialize(evalMultKeys, ser, sertype);
+            Serial::Serialize(*evalMultKeys, ser, sertype);
         }
         else {
-            const auto it = evalMultKeys.find(id);
-            if (it == evalMultKeys.end())
+            const auto it = evalMultKeys->find(id);
+            if (it == evalMultKeys->end())
                 return false;  // no such id
 
             std::map<std::string, std::vector<EvalKey<Element>>> omap{{it->first, it->second}};
@@ -662,7 +684,7 @@ public:
     template <typename ST>
     static bool SerializeEvalMultKey(std::ostream& ser, const ST& sertype, const CryptoContext<Element> cc) {
         std::map<std::string, std::vector<EvalKey<Element>>> omap;
-        for (const auto& [key, vec] : CryptoContextImpl<Element>::GetAllEvalMultKeys()) {
+        for (const auto& [key, vec] : *cc->GetKeyStore().GetEvalMultKeys()) {
             if (vec[0]->GetCryptoContext() == cc) {
                 omap[key] = vec;
             }
@@ -699,24 +721,24 @@ public:
     }
 
     /**
-   * ClearEvalMultKeys - flush EvalMultKey cache
+   * ClearEvalMultKeys - flush EvalMultKey cache of the shared key store
    */
     static void ClearEvalMultKeys();
 
     /**
-   * ClearEvalMultKeys - flush EvalMultKey cache for a given id
+   * ClearEvalMultKeys - flush EvalMultKey cache of the shared key store for a given id
    * @param id the correponding key id
    */
     static void ClearEvalMultKeys(const std::string& id);
     /**
-   * ClearEvalMultKeys - flush EvalMultKey cache for a given context
+   * ClearEvalMultKeys - flush EvalMultKey cache for a given context, in the key store of the context
    * @param cc crypto context
    */
     static void ClearEvalMultKeys(const CryptoContext<Element> cc);
 
     /**
    * InsertEvalMultKey - add the given vector of keys to the map, replacing the
-   * existing vector if it is there
+   * existing vector if it is there. The keys go to the key store of their crypto context
    * @param evalKeyVec vector of keys
    * @param keyTag key identifier, unique for every cryptocontext
    */
@@ -802,17 +824,14 @@ public:
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, std::string id = "") {
         // TODO (dsuponit): do we need Serailize/Deserialized to return bool?
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>* smap;
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
         if (id.length() == 0) {
-            smap = &CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+            Serial::Serialize(*CryptoContextImpl<Element>::GetEvalKeyStore().GetEvalAutomorphismKeys(), ser, sertype);
         }
         else {
-            const auto keys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
-            omap[id]        = keys;
-            smap            = &omap;
+            std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
+            omap[id] = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
+            Serial::Serialize(omap, ser, sertype);
         }
-        Serial::Serialize(*smap, ser, sertype);
         return true;
     }
 
@@ -827,7 +846,7 @@ public:
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, const CryptoContext<Element> cc) {
         std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
-        for (const auto& k : CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys()) {
+        for (const auto& k : *cc->GetKeyStore().GetEvalAutomorphismKeys()) {
             if (k.second->begin()->second->GetCryptoContext() == cc) {
                 omap[k.first] = k.second;
             }
@@ -852,7 +871,7 @@ public:
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, const std::string& keyID,
                                              const std::vector<uint32_t>& indexList) {
         std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> keyMap = {
-            {keyID, CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(keyID, indexList)}};
+            {keyID, CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(s_keyStore, keyID, indexList)}};
 
         Serial::Serialize(keyMap, ser, sertype);
         return true;
@@ -923,31 +942,60 @@ public:
     }
 
     /**
-   * ClearEvalAutomorphismKeys - flush EvalAutomorphismKey cache
+   * ClearEvalAutomorphismKeys - flush EvalAutomorphismKey cache of the shared key store
    */
     static void ClearEvalAutomorphismKeys();
 
     /**
-   * ClearEvalAutomorphismKeys - flush EvalAutomorphismKey cache for a given id
+   * ClearEvalAutomorphismKeys - flush EvalAutomorphismKey cache of the shared key store for a given id
    * @param id
    */
     static void ClearEvalAutomorphismKeys(const std::string& id);
 
     /**
    * ClearEvalAutomorphismKeys - flush EvalAutomorphismKey cache for a given
-   * context
+   * context, in the key store of the context
    * @param cc
    */
     static void ClearEvalAutomorphismKeys(const CryptoContext<Element> cc);
 
     /**
    * InsertEvalAutomorphismKey - add the given map of keys to the map, replacing
-   * the existing map if there
+   * the existing map if there. The keys go to the key store of their crypto context
    * @param mapToInsert
    */
     // TODO (dsuponit): move InsertEvalAutomorphismKey() to the private section of the class
     static void InsertEvalAutomorphismKey(const std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap,
                                           const std::string& keyTag = "");
+
+    /**
+   * WriteEvalAutomorphismKeyStore - writes the automorphism keys of a key ID in the key store of this context
+   * to a key store file, which LoadEvalAutomorphismKeyStore() maps into memory and loads key by key
+   * @param path - path of the key store file
+   * @param keyID - key ID of the keys to write
+   */
+    void WriteEvalAutomorphismKeyStore(const std::string& path, const std::string& keyID) const;
+
+    /**
+   * LoadEvalAutomorphismKeyStore - memory-maps a key store file and adds its keys to the automorphism key map,
+   * replacing the existing keys of the same key ID. Each key is deserialized on first use, and only the
+   * maxResidentKeys most recently used keys are kept in memory. The loaded keys cannot be serialized with
+   * SerializeEvalAutomorphismKey().
+   * @param path - path of the key store file
+   * @param maxResidentKeys - maximum number of keys kept in memory at once; 0 keeps all used keys
+   * @param indices - automorphism indices of the keys to add; empty for all keys of the store
+   */
+    void LoadEvalAutomorphismKeyStore(const std::string& path, uint32_t maxResidentKeys = 0,
+                                      const std::vector<uint32_t>& indices = {});
+
+    /**
+   * ReadEvalAutomorphismKeyStore - deserializes keys of a key store file in parallel and adds them to the
+   * automorphism key map. Only the records of the selected keys are read; keys already in the map for the same
+   * key ID and index are kept.
+   * @param path - path of the key store file
+   * @param indices - automorphism indices of the keys to read; empty for all keys of the store
+   */
+    void ReadEvalAutomorphismKeyStore(const std::string& path, const std::vector<uint32_t>& indices = {});
     //------------------------------------------------------------------------------
     // TURN FEATURES ON
     //------------------------------------------------------------------------------
@@ -999,6 +1047,49 @@ public:
         m_keyGenLevel = level;
     }
 
+    /**
+   * Returns true if evaluation keys are generated in the seeded form
+   */
+    bool GetSeededEvalKeys() const {
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRLWE<Element>>(params);
+        return cryptoParams != nullptr && cryptoParams->GetSeededEvalKeys();
+    }
+
+    /**
+   * Setter for the seeded form of evaluation keys: the relinearization and rotation keys generated from now on store
+   * a 256-bit seed instead of the uniformly random half of every digit, which halves their memory and serialized size.
+   * Supported for BV and HYBRID key switching; threshold (multiparty) key generation always produces full keys.
+   * @param seeded true to generate seeded keys
+   */
+    void SetSeededEvalKeys(bool seeded) {
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRLWE<Element>>(params);
+        if (cryptoParams == nullptr)
+            OPENFHE_THROW("Seeded evaluation keys require RLWE crypto parameters");
+        cryptoParams->SetSeededEvalKeys(seeded);
+    }
+
+    /**
+   * Returns true if encryption with the secret key produces seeded ciphertexts
+   */
+    bool GetSeededEncryption() const {
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRLWE<Element>>(params);
+        return cryptoParams != nullptr && cryptoParams->GetSeededEncryption();
+    }
+
+    /**
+   * Setter for seeded secret-key encryption: the ciphertexts encrypted with a private key from now on store a 256-bit
+   * seed instead of the uniformly random element c1, which halves their memory and serialized size until c1 is
+   * expanded on first use. Public-key encryption and BFV with the EXTENDED encryption technique, whose c1 is not
+   * freshly uniform, always produce full ciphertexts.
+   * @param seeded true to produce seeded ciphertexts
+   */
+    void SetSeededEncryption(bool seeded) {
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRLWE<Element>>(params);
+        if (cryptoParams == nullptr)
+            OPENFHE_THROW("Seeded encryption requires RLWE crypto parameters");
+        cryptoParams->SetSeededEncryption(seeded);
+    }
+
     /**
    * Getter for element params
    * @return
@@ -1056,34 +1147,74 @@ public:
     //------------------------------------------------------------------------------
 
     /**
-   * Get a map of relinearization keys for all secret keys
+   * Get the store holding the relinearization and automorphism keys of all secret keys of the contexts that have
+   * no key store of their own. The store can be used from several threads: lookups do not block, and the keys of a
+   * tag can be inserted, replaced or evicted atomically while other threads evaluate.
+   */
+    static KeyStore<Element>& GetEvalKeyStore() {
+        return s_keyStore;
+    }
+
+    /**
+   * Give this context a key store of its own, e.g. one per tenant of a service. The keys generated with this
+   * context and the keys inserted or deserialized for it are then kept in that store only, its evaluation
+   * functions look keys up there, and GetKeyStore().GetByteSize() accounts for their memory. Evicting a tag from
+   * the store, or clearing it, releases the memory of its keys as soon as no ciphertext operation holds them
+   * anymore. Note that the keys refer to the context, so a context with a store of its own is only released
+   * after its keys are cleared. The static getters and the Clear/Serialize functions that take a key tag rather
+   * than a context work on the shared store only.
+   * Set the store before generating keys; the keys already in the previous store are not moved.
+   * @param keyStore the key store; several contexts may share it. nullptr selects the shared store again.
+   */
+    void SetKeyStore(std::shared_ptr<KeyStore<Element>> keyStore) {
+        m_keyStore = std::move(keyStore);
+    }
+
+    /**
+   * Get the store holding the keys of this context: its own store set with SetKeyStore(), or the shared one
+   */
+    KeyStore<Element>& GetKeyStore() const {
+        return m_keyStore ? *m_keyStore : s_keyStore;
+    }
+
+    /**
+   * Get a copy of the map of relinearization keys for all secret keys in the shared store. Keys are added and
+   * removed with the Insert/Clear functions or through GetEvalKeyStore().
    */
-    static std::map<std::string, std::vector<EvalKey<Element>>>& GetAllEvalMultKeys();
+    static std::map<std::string, std::vector<EvalKey<Element>>> GetAllEvalMultKeys();
 
     /**
    * Get relinearization keys for a specific secret key tag
    */
-    static const std::vector<EvalKey<Element>>& GetEvalMultKeyVector(const std::string& keyID);
+    static std::vector<EvalKey<Element>> GetEvalMultKeyVector(const std::string& keyID);
 
     /**
-   * Get a map of automorphism keys for all secret keys
+   * Get a copy of the map of automorphism keys for all secret keys. The key maps in it are shared with the key
+   * store and must not be modified.
    */
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalAutomorphismKeys();
+    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> GetAllEvalAutomorphismKeys();
     /**
-   * Get automorphism keys for a specific secret key tag
+   * Get automorphism keys for a specific secret key tag. The map is shared with the key store and must not be
+   * modified; it stays valid while it is held, also if the keys of the tag are replaced or cleared meanwhile.
    */
-    static std::map<usint, EvalKey<Element>>& GetEvalAutomorphismKeyMap(const std::string& keyID) {
+    static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(const std::string& keyID);
+    /**
+   * Get a copy of the automorphism keys for a specific secret key tag; GetEvalAutomorphismKeyMapPtr() avoids the
+   * copy.
+   */
+    static std::map<usint, EvalKey<Element>> GetEvalAutomorphismKeyMap(const std::string& keyID) {
         return *(CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID));
     }
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for all secret keys
+   * Get a copy of the map of summation keys (each is composed of several automorphism keys) for all secret keys
    */
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalSumKeys();
+    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> GetAllEvalSumKeys();
 
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag
+   * Get a copy of the map of summation keys (each is composed of several automorphism keys) for a specific secret
+   * key tag
    */
-    static const std::map<usint, EvalKey<Element>>& GetEvalSumKeyMap(const std::string& id);
+    static std::map<usint, EvalKey<Element>> GetEvalSumKeyMap(const std::string& id);
 
     //------------------------------------------------------------------------------
     // PLAINTEXT FACTORY METHODS
@@ -1212,6 +1343,7 @@ public:
    * @return ciphertext (or null on failure)
    */
     Ciphertext<Element> Encrypt(const Plaintext& plaintext, const PublicKey<Element> publicKey) const {
+        OPENFHE_MEMSTATS_SCOPE();
         if (plaintext == nullptr)
             OPENFHE_THROW("Input plaintext is nullptr");
         ValidateKey(publicKey);
@@ -1247,6 +1379,7 @@ public:
    * @return ciphertext (or null on failure)
    */
     Ciphertext<Element> Encrypt(const Plaintext& plaintext, const PrivateKey<Element> privateKey) const {
+        OPENFHE_MEMSTATS_SCOPE();
         //    if (plaintext == nullptr)
         //      OPENFHE_THROW( "Input plaintext is nullptr");
         ValidateKey(privateKey);
@@ -1325,6 +1458,7 @@ public:
    * @return new CiphertextImpl after applying key switch
    */
     Ciphertext<Element> KeySwitch(ConstCiphertext<Element> ciphertext, const EvalKey<Element> evalKey) const {
+        OPENFHE_MEMSTATS_SCOPE();
         ValidateCiphertext(ciphertext);
         ValidateKey(evalKey);
 
@@ -1379,6 +1513,7 @@ public:
    * @return the result as a new ciphertext
    */
     Ciphertext<Element> EvalAdd(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        OPENFHE_MEMSTATS_SCOPE();
         TypeCheck(ciphertext1, ciphertext2);
         return GetScheme()->EvalAdd(ciphertext1, ciphertext2);
     }
@@ -1736,9 +1871,10 @@ public:
    * @return new ciphertext for ciphertext1 * ciphertext2
    */
     Ciphertext<Element> EvalMult(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        OPENFHE_MEMSTATS_SCOPE();
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext1->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
@@ -1755,7 +1891,7 @@ public:
     Ciphertext<Element> EvalMultMutable(Ciphertext<Element>& ciphertext1, Ciphertext<Element>& ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext1->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
@@ -1771,7 +1907,7 @@ public:
     void EvalMultMutableInPlace(Ciphertext<Element>& ciphertext1, Ciphertext<Element>& ciphertext2) const {
         TypeCheck(ciphertext1, ciphertext2);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext1->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
@@ -1785,9 +1921,10 @@ public:
    * @return squared ciphertext
    */
     Ciphertext<Element> EvalSquare(ConstCiphertext<Element> ciphertext) const {
+        OPENFHE_MEMSTATS_SCOPE();
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
@@ -1803,7 +1940,7 @@ public:
     Ciphertext<Element> EvalSquareMutable(Ciphertext<Element>& ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
@@ -1819,7 +1956,7 @@ public:
     void EvalSquareInPlace(Ciphertext<Element>& ciphertext) const {
         ValidateCiphertext(ciphertext);
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMultMutable");
         }
@@ -1845,11 +1982,12 @@ public:
    * @return relinearized ciphertext
    */
     Ciphertext<Element> Relinearize(ConstCiphertext<Element> ciphertext) const {
+        OPENFHE_MEMSTATS_SCOPE();
         // input parameter check
         if (!ciphertext)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext->GetKeyTag());
 
         if (evalKeyVec.size() < (ciphertext->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW(
@@ -1869,7 +2007,7 @@ public:
         if (!ciphertext)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext->GetKeyTag());
         if (evalKeyVec.size() < (ciphertext->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW(
                 "Insufficient value was used for maxRelinSkDeg to generate "
@@ -1887,11 +2025,12 @@ public:
    */
     Ciphertext<Element> EvalMultAndRelinearize(ConstCiphertext<Element> ciphertext1,
                                                ConstCiphertext<Element> ciphertext2) const {
+        OPENFHE_MEMSTATS_SCOPE();
         // input parameter check
         if (!ciphertext1 || !ciphertext2)
             OPENFHE_THROW("Input ciphertext is nullptr");
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext1->GetKeyTag());
 
         if (evalKeyVec.size() <
             (ciphertext1->NumberCiphertextElements() + ciphertext2->NumberCiphertextElements() - 3)) {
@@ -1910,6 +2049,7 @@ public:
    * @return the result of multiplication
    */
     Ciphertext<Element> EvalMult(ConstCiphertext<Element> ciphertext, ConstPlaintext plaintext) const {
+        OPENFHE_MEMSTATS_SCOPE();
         TypeCheck(ciphertext, plaintext);
         return GetScheme()->EvalMult(ciphertext, plaintext);
     }
@@ -2045,7 +2185,7 @@ public:
 
         std::vector<uint32_t> newIndices(indicesToGenerate.begin(), indicesToGenerate.end());
         auto evalKeys = GetScheme()->EvalAutomorphismKeyGen(privateKey, newIndices);
-        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, privateKey->GetKeyTag());
 
         return evalKeys;
     }
@@ -2127,10 +2267,11 @@ public:
    * @return a rotated ciphertext
    */
     Ciphertext<Element> EvalRotate(ConstCiphertext<Element> ciphertext, int32_t index) const {
+        OPENFHE_MEMSTATS_SCOPE();
         ValidateCiphertext(ciphertext);
 
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-        return GetScheme()->EvalAtIndex(ciphertext, index, evalKeyMap);
+        const auto evalKeyMap = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+        return GetScheme()->EvalAtIndex(ciphertext, index, *evalKeyMap);
     }
 
     /**
@@ -2161,6 +2302,7 @@ public:
    * decomposition)
    */
     std::shared_ptr<std::vector<Element>> EvalFastRotationPrecompute(ConstCiphertext<Element> ciphertext) const {
+        OPENFHE_MEMSTATS_SCOPE();
         return GetScheme()->EvalFastRotationPrecompute(ciphertext);
     }
 
@@ -2202,6 +2344,7 @@ public:
    */
     Ciphertext<Element> EvalFastRotation(ConstCiphertext<Element> ciphertext, const usint index, const usint m,
                                          const std::shared_ptr<std::vector<Element>> digits) const {
+        OPENFHE_MEMSTATS_SCOPE();
         return GetScheme()->EvalFastRotation(ciphertext, index, m, digits);
     }
 
@@ -2218,9 +2361,9 @@ public:
    */
     Ciphertext<Element> EvalFastRotationExt(ConstCiphertext<Element> ciphertext, usint index,
                                             const std::shared_ptr<std::vector<Element>> digits, bool addFirst) const {
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+        const auto evalKeyMap = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
 
-        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeyMap);
+        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, *evalKeyMap);
     }
 
     /**
@@ -2258,6 +2401,61 @@ public:
         return GetScheme()->KeySwitchExt(ciphertext, addFirst);
     }
 
+    /**
+   * Rotates a ciphertext by every index in a list. The digit decomposition (ModUp) is computed
+   * once and shared by all rotations, so each additional index only costs the key switching
+   * inner product and one ModDown. Uses the rotation keys stored in the crypto context.
+   *
+   * @param ciphertext input ciphertext
+   * @param indices rotation indices (positive is a left shift, negative is a right shift)
+   * @return the rotated ciphertexts, in the order of indices
+   */
+    std::vector<Ciphertext<Element>> EvalRotateMany(ConstCiphertext<Element> ciphertext,
+                                                    const std::vector<int32_t>& indices) const;
+
+    /**
+   * Only supported for hybrid key switching.
+   * Double-hoisted variant of EvalRotateMany: the ModUp is shared by all rotations and the ModDown
+   * is skipped, so the rotations are returned in the extended CRT basis P*Q. The results can be
+   * combined with EvalAddExt and brought back to Q with a single KeySwitchDown.
+   *
+   * @param ciphertext input ciphertext in basis Q
+   * @param indices rotation indices (positive is a left shift, negative is a right shift)
+   * @param addFirst if true, the first element c0 is also computed (otherwise ignored)
+   * @return the rotated ciphertexts in the extended basis P*Q, in the order of indices
+   */
+    std::vector<Ciphertext<Element>> EvalRotateManyExt(ConstCiphertext<Element> ciphertext,
+                                                       const std::vector<int32_t>& indices, bool addFirst = true) const;
+
+    /**
+   * Adds two ciphertexts in the extended CRT basis P*Q (as returned by EvalRotateManyExt or
+   * EvalFastRotationExt). No metadata checks are made.
+   *
+   * @param ciphertext1 first ciphertext in the extended basis, updated in place
+   * @param ciphertext2 second ciphertext in the extended basis
+   */
+    void EvalAddExtInPlace(Ciphertext<Element>& ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        std::vector<Element>& cv1       = ciphertext1->GetElements();
+        const std::vector<Element>& cv2 = ciphertext2->GetElements();
+
+        for (size_t i = 0; i < cv1.size(); ++i) {
+            cv1[i] += cv2[i];
+        }
+    }
+
+    /**
+   * Adds two ciphertexts in the extended CRT basis P*Q.
+   *
+   * @param ciphertext1 first ciphertext in the extended basis
+   * @param ciphertext2 second ciphertext in the extended basis
+   * @return the sum in the extended basis
+   */
+    Ciphertext<Element> EvalAddExt(ConstCiphertext<Element> ciphertext1, ConstCiphertext<Element> ciphertext2) const {
+        Ciphertext<Element> result = ciphertext1->Clone();
+        EvalAddExtInPlace(result, ciphertext2);
+        return result;
+    }
+
     /**
    * EvalAtIndexKeyGen generates evaluation keys for a list of rotation indices
    *
@@ -2289,6 +2487,19 @@ public:
                           const PublicKey<Element> publicKey = nullptr) {
         EvalAtIndexKeyGen(privateKey, indexList, publicKey);
     };
+
+    /**
+   * EvalRotateKeyGen generates evaluation keys for a list of rotation indices and appends them to a key store
+   * file as they are produced, instead of adding them to the automorphism key map. The keys are generated in
+   * batches of batchSize indices, so that at most one batch is in memory at a time.
+   *
+   * @param privateKey private key.
+   * @param indexList list of indices.
+   * @param writer key store file the keys are appended to; it is not closed.
+   * @param batchSize number of keys generated at once; 0 for the number of threads.
+   */
+    void EvalRotateKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
+                          EvalKeyStoreWriter& writer, uint32_t batchSize = 0) const;
     // [[deprecated(
     //     "Use EvalRotateKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList) instead.")]] void
     // EvalRotateKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
@@ -2321,7 +2532,7 @@ public:
         ValidateCiphertext(ciphertext1);
         ValidateCiphertext(ciphertext2);
 
-        auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertext1->GetKeyTag());
+        auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertext1->GetKeyTag());
         if (!evalKeyVec.size()) {
             OPENFHE_THROW("Evaluation key has not been generated for EvalMult");
         }
@@ -2337,6 +2548,7 @@ public:
    * @return rescaled ciphertext
    */
     Ciphertext<Element> Rescale(ConstCiphertext<Element> ciphertext) const {
+        OPENFHE_MEMSTATS_SCOPE();
         ValidateCiphertext(ciphertext);
 
         return GetScheme()->ModReduce(ciphertext, BASE_NUM_LEVELS_TO_DROP);
@@ -2360,6 +2572,7 @@ public:
    * @return mod reduced ciphertext
    */
     Ciphertext<Element> ModReduce(ConstCiphertext<Element> ciphertext) const {
+        OPENFHE_MEMSTATS_SCOPE();
         ValidateCiphertext(ciphertext);
 
         return GetScheme()->ModReduce(ciphertext, BASE_NUM_LEVELS_TO_DROP);
@@ -2415,6 +2628,23 @@ public:
         return GetScheme()->Compress(ciphertext, towersLeft);
     }
 
+    /**
+   * CompressForTransport - Reduces the size of a ciphertext before it is sent for decryption: drops all towers that
+   * are not needed to decrypt it and, for CKKS, rounds away the low-order bits of the coefficients that do not
+   * affect the given precision of the decrypted values. The result is meant to be written with
+   * Wire::SerializeCompact, which stores only the remaining bits.
+   * @param ciphertext - input ciphertext
+   * @param precisionBits - number of bits of precision after the binary point to keep in the decrypted values (CKKS
+   * only, 0 keeps all bits)
+   * @return compressed ciphertext
+   */
+    Ciphertext<Element> CompressForTransport(ConstCiphertext<Element> ciphertext, uint32_t precisionBits = 0) const {
+        if (ciphertext == nullptr)
+            OPENFHE_THROW("input ciphertext is invalid (has no data)");
+
+        return GetScheme()->CompressForTransport(ciphertext, precisionBits);
+    }
+
     //------------------------------------------------------------------------------
     // Advanced SHE Wrapper
     //------------------------------------------------------------------------------
@@ -2478,7 +2708,7 @@ public:
             return ciphertextVec[0];
         }
 
-        const auto evalKeyVec = CryptoContextImpl<Element>::GetEvalMultKeyVector(ciphertextVec[0]->GetKeyTag());
+        const auto evalKeyVec = GetKeyStore().GetEvalMultKeyVector(ciphertextVec[0]->GetKeyTag());
         if (evalKeyVec.size() < (ciphertextVec[0]->NumberCiphertextElements() - 2)) {
             OPENFHE_THROW("Insufficient value was used for maxRelinSkDeg to generate keys");
         }
@@ -3298,24 +3528,36 @@ public:
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to internally rescale message by to improve precision of bootstrapping. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64
    * @param precompute - flag specifying whether to precompute the plaintexts for encoding and decoding.
+   * @param deferModDown - flag specifying whether the giant steps of encoding and decoding keep c0 in the extended
+   * basis P*Q, so that only c1 is scaled down per giant step and c0 is scaled down once per level.
+   * @param maxPlaintextBytes - bound on the memory taken by the encoded plaintexts for encoding and decoding. The
+   * levels that do not fit are kept as diagonals, which take a fraction of the memory, and are encoded one giant step
+   * at a time during EvalBootstrap, trading time for memory. If set to 0, all plaintexts are kept encoded. Neither
+   * deferModDown nor maxPlaintextBytes is serialized with the crypto context: after deserializing a context, call
+   * EvalBootstrapSetup() again to restore them, otherwise the defaults apply.
    */
     void EvalBootstrapSetup(std::vector<uint32_t> levelBudget = {5, 4}, std::vector<uint32_t> dim1 = {0, 0},
-                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true) {
-        GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor, precompute);
+                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true,
+                            bool deferModDown = false, uint64_t maxPlaintextBytes = 0) {
+        GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor, precompute, deferModDown,
+                                        maxPlaintextBytes);
     }
     /**
    * Generates all automorphism keys for EvalBootstrap. Supported in CKKS only.
-   * EvalBootstrapKeyGen uses the baby-step/giant-step strategy.
+   * EvalBootstrapKeyGen uses the baby-step/giant-step strategy. For SPARSE_ENCAPSULATED secret keys, it also
+   * generates the keys switching to an ephemeral sparse secret before the modulus raising and back after it.
    *
    * @param privateKey private key.
    * @param slots number of slots to support permutations on
+   * @param batchSlots number of slots of the ciphertexts that EvalBootstrapBatch packs into slots slots. If not 0,
+   * the rotation keys for unpacking them are generated as well.
    */
-    void EvalBootstrapKeyGen(const PrivateKey<Element> privateKey, uint32_t slots) {
+    void EvalBootstrapKeyGen(const PrivateKey<Element> privateKey, uint32_t slots, uint32_t batchSlots = 0) {
         ValidateKey(privateKey);
 
-        auto evalKeys = GetScheme()->EvalBootstrapKeyGen(privateKey, slots);
+        auto evalKeys = GetScheme()->EvalBootstrapKeyGen(privateKey, slots, batchSlots);
 
-        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, privateKey->GetKeyTag());
     }
     /**
    * Computes the plaintexts for encoding and decoding for both linear and FFT-like methods. Supported in CKKS only.
@@ -3326,6 +3568,35 @@ public:
         GetScheme()->EvalBootstrapPrecompute(*this, slots);
     }
     /**
+   * Writes the plaintexts for encoding and decoding computed by EvalBootstrapSetup() or EvalBootstrapPrecompute()
+   * to a cache file in cacheDir, so that later processes can load them with LoadBootstrapPrecomputation() instead
+   * of computing them again. The file is named after a hash of the crypto parameters and the bootstrapping
+   * parameters of the slots, so one directory can hold the caches of many configurations. The file is written
+   * under a temporary name and renamed, so concurrent writers and readers never see a partial file. All plaintexts
+   * must be encoded, i.e., EvalBootstrapSetup() must be called with maxPlaintextBytes = 0.
+   * Supported in CKKS only.
+   *
+   * @param cacheDir - existing directory of the cache files
+   * @param slots - number of slots to be bootstrapped
+   */
+    void WriteBootstrapPrecomputation(const std::string& cacheDir, uint32_t slots = 0) const {
+        GetScheme()->WriteBootstrapPrecomputation(*this, cacheDir, slots);
+    }
+    /**
+   * Loads the plaintexts for encoding and decoding from a cache file written by WriteBootstrapPrecomputation(),
+   * replacing the work of EvalBootstrapPrecompute(). EvalBootstrapSetup() has to be called with the same
+   * parameters beforehand, usually with precompute set to false. The file is mapped into memory copy-on-write and
+   * the plaintexts use the mapped memory in place. Supported in CKKS only.
+   *
+   * @param cacheDir - directory of the cache files
+   * @param slots - number of slots to be bootstrapped
+   * @return false if cacheDir has no cache file for the current parameters; the plaintexts then have to be
+   * computed with EvalBootstrapPrecompute()
+   */
+    bool LoadBootstrapPrecomputation(const std::string& cacheDir, uint32_t slots = 0) {
+        return GetScheme()->LoadBootstrapPrecomputation(GetContextForPointer(this), cacheDir, slots);
+    }
+    /**
    * Defines the bootstrapping evaluation of ciphertext using either the
    * FFT-like method or the linear method
    *
@@ -3337,8 +3608,26 @@ public:
    */
     Ciphertext<Element> EvalBootstrap(ConstCiphertext<Element> ciphertext, uint32_t numIterations = 1,
                                       uint32_t precision = 0) const {
+        OPENFHE_MEMSTATS_SCOPE();
         return GetScheme()->EvalBootstrap(ciphertext, numIterations, precision);
     }
+    /**
+   * Bootstraps several sparsely packed ciphertexts with a single EvalBootstrap. The ciphertexts, which must all have
+   * the same number of slots n, are packed into one ciphertext with count * n slots, where count is their number
+   * rounded up to a power of two. The packed ciphertext is bootstrapped and then unpacked with count - 1 rotations.
+   * Packing consumes no level, unpacking consumes one level more than EvalBootstrap. EvalBootstrapSetup and
+   * EvalBootstrapKeyGen have to be called for count * n slots, the latter with batchSlots = n.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts, in the order of the input ciphertexts.
+   */
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        OPENFHE_MEMSTATS_SCOPE();
+        return GetScheme()->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
 
     //------------------------------------------------------------------------------
     // Scheme switching Methods
@@ -3387,7 +3676,7 @@ public:
             OPENFHE_THROW("FHEW private key passed to EvalCKKStoFHEWKeyGen is null");
         }
         auto evalKeys = GetScheme()->EvalCKKStoFHEWKeyGen(keyPair, lwesk);
-        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, keyPair.secretKey->GetKeyTag());
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, keyPair.secretKey->GetKeyTag());
     }
 
     /**
@@ -3447,7 +3736,7 @@ public:
         ValidateKey(keyPair.secretKey);
 
         auto evalKeys = GetScheme()->EvalFHEWtoCKKSKeyGen(keyPair, lwesk, numSlots, numCtxts, dim1, L);
-        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, keyPair.secretKey->GetKeyTag());
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, keyPair.secretKey->GetKeyTag());
     }
 
     /**
@@ -3511,7 +3800,7 @@ public:
         ValidateKey(keyPair.secretKey);
 
         auto evalKeys = GetScheme()->EvalSchemeSwitchingKeyGen(keyPair, lwesk);
-        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, keyPair.secretKey->GetKeyTag());
+        CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, keyPair.secretKey->GetKeyTag());
     }
 
     /**
@@ -3706,6 +3995,19 @@ template <>
 std::unordered_map<uint32_t, DCRTPoly> CryptoContextImpl<DCRTPoly>::ShareKeys(const PrivateKey<DCRTPoly>& sk, usint N,
                                                                               usint threshold, usint index,
                                                                               const std::string& shareType) const;
+template <>
+void CryptoContextImpl<DCRTPoly>::WriteEvalAutomorphismKeyStore(const std::string& path,
+                                                                const std::string& keyID) const;
+template <>
+void CryptoContextImpl<DCRTPoly>::LoadEvalAutomorphismKeyStore(const std::string& path, uint32_t maxResidentKeys,
+                                                               const std::vector<uint32_t>& indices);
+template <>
+void CryptoContextImpl<DCRTPoly>::ReadEvalAutomorphismKeyStore(const std::string& path,
+                                                               const std::vector<uint32_t>& indices);
+template <>
+void CryptoContextImpl<DCRTPoly>::EvalRotateKeyGen(const PrivateKey<DCRTPoly> privateKey,
+                                                   const std::vector<int32_t>& indexList, EvalKeyStoreWriter& writer,
+                                                   uint32_t batchSize) const;
 }  // namespace lbcrypto
 
 #endif /* SRC_PKE_CRYPTOCONTEXT_H_ */
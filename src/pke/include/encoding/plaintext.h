@@ -188,6 +188,13 @@ public:
         return isEncoded;
     }
 
+    /**
+   * Marks the plaintext as encoded after its element was set directly, e.g., by deserialization
+   */
+    void SetEncoded() {
+        isEncoded = true;
+    }
+
     /**
    * GetEncodingParams
    * @return Encoding params used with this plaintext
@@ -224,6 +224,55 @@ public:
         OPENFHE_THROW("GetAinDCRT operation not supported");
     }
 
+    /**
+   * Setter function to store the seed the Element Vector A is expanded from.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @param &seed is the seed to be copied.
+   */
+    virtual void SetSeed(const std::vector<uint32_t>& seed) {
+        OPENFHE_THROW("SetSeed operation not supported");
+    }
+
+    /**
+   * Getter function to access the seed the Element Vector A is expanded from.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @return the seed.
+   */
+    virtual const std::vector<uint32_t>& GetSeed() const {
+        OPENFHE_THROW("GetSeed operation not supported");
+    }
+
+    /**
+   * Returns true if the key stores a seed instead of Element Vector A.
+   */
+    virtual bool IsSeeded() const {
+        return false;
+    }
+
+    /**
+   * Returns the key that holds the data of a lazily loaded key, loading it if needed. Holding the returned key
+   * keeps its data in memory, also if the key is evicted from its store meanwhile.
+   *
+   * @return the loaded key, or nullptr for a key that holds its own data.
+   */
+    virtual std::shared_ptr<EvalKeyImpl<Element>> LoadResident() const {
+        return nullptr;
+    }
+
+    /**
+   * Hints that a lazily loaded key will be used soon, so that its data can be read in the background.
+   */
+    virtual void Prefetch() const {}
+
+    /**
+   * Returns the number of bytes of key data held in memory.
+   */
+    virtual size_t GetByteSize() const {
+        return 0;
+    }
+
     virtual void ClearKeys() {
         OPENFHE_THROW("ClearKeys operation is not supported");
     }
@@ -254,6 +303,19 @@ public:
     }
 };
 
+/**
+ * Returns the key that holds the data of a key: the loaded key for a lazily loaded key, the key itself otherwise.
+ * The references returned by GetAVector()/GetBVector() of the returned key stay valid while it is held.
+ *
+ * @param key the key to read.
+ * @return the key to read the data from.
+ */
+template <class Element>
+EvalKey<Element> PinEvalKey(const EvalKey<Element>& key) {
+    auto resident = key->LoadResident();
+    return resident ? resident : key;
+}
+
 }  // namespace lbcrypto
 
 #endif
@@ -34,8 +34,11 @@
 
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
+#include "math/seededuniformgenerator.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <utility>
@@ -71,7 +74,7 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey), m_seed(rhs.m_seed) {}
 
     /**
    * Move constructor
@@ -79,7 +82,7 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)), m_seed(std::move(rhs.m_seed)) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_rKey.size() != 0;
@@ -93,6 +96,8 @@ public:
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        this->m_seed  = rhs.m_seed;
+        m_aCache.clear();
         return *this;
     }
 
@@ -105,6 +110,8 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_seed        = std::move(rhs.m_seed);
+        m_aCache.clear();
         return *this;
     }
 
@@ -133,9 +140,21 @@ public:
    * Overrides base class implementation.
    *
    * @return Element vector A.
+   * @note for a seeded key, A is expanded from the seed on the first call and cached; key switching expands it on the
+   * fly instead, so the cache is only populated for other uses of A (e.g. threshold key generation)
    */
     virtual const std::vector<Element>& GetAVector() const {
-        return m_rKey.at(0);
+        if (!IsSeeded())
+            return m_rKey.at(0);
+
+        std::lock_guard<std::mutex> lock(m_aCacheMutex);
+        if (m_aCache.empty()) {
+            const auto& b = m_rKey.at(1);
+            m_aCache.reserve(b.size());
+            for (size_t j = 0; j < b.size(); ++j)
+                m_aCache.push_back(ExpandSeededA(m_seed, j, b[j].GetParams()));
+        }
+        return m_aCache;
     }
 
     /**
@@ -145,6 +164,9 @@ public:
    * @param &b is the Element vector to be copied.
    */
     virtual void SetBVector(const std::vector<Element>& b) {
+        // a seeded key has no vector A: keep an empty placeholder at index 0
+        if (m_rKey.empty())
+            m_rKey.emplace_back();
         m_rKey.insert(m_rKey.begin() + 1, b);
     }
 
@@ -155,6 +177,8 @@ public:
    * @param &&b is the Element vector to be moved.
    */
     virtual void SetBVector(std::vector<Element>&& b) {
+        if (m_rKey.empty())
+            m_rKey.emplace_back();
         m_rKey.insert(m_rKey.begin() + 1, std::move(b));
     }
 
@@ -232,9 +256,94 @@ public:
         return m_dcrtKeys.at(1);
     }
 
+    /**
+   * Setter function to store the seed Element Vector A is expanded from.
+   * Overrides base class implementation.
+   *
+   * @param &seed is the seed to be copied.
+   */
+    virtual void SetSeed(const std::vector<uint32_t>& seed) {
+        if (!seed.empty() && seed.size() != SeededUniformGenerator::SEED_WORDS)
+            OPENFHE_THROW("Seed must have " + std::to_string(SeededUniformGenerator::SEED_WORDS) + " words");
+        m_seed = seed;
+        m_aCache.clear();
+    }
+
+    /**
+   * Getter function to access the seed Element Vector A is expanded from.
+   * Overrides base class implementation.
+   *
+   * @return the seed, empty if the key stores Element Vector A.
+   */
+    virtual const std::vector<uint32_t>& GetSeed() const {
+        return m_seed;
+    }
+
+    /**
+   * Returns true if the key stores a seed instead of Element Vector A.
+   */
+    virtual bool IsSeeded() const {
+        return !m_seed.empty();
+    }
+
+    /**
+   * Identifier of the PRNG stream tower i of digit j of Element Vector A is expanded from.
+   */
+    static uint64_t SeedStreamId(uint32_t digit, uint32_t tower) {
+        return (static_cast<uint64_t>(digit) << 32) | tower;
+    }
+
+    /**
+   * Expands digit j of Element Vector A from the seed. Tower i of the result is the tower i of the full key, so
+   * passing the parameters of a lower level yields the key restricted to that level.
+   *
+   * @param &seed the seed of the key.
+   * @param digit the index j of the digit.
+   * @param &params the parameters of the element to generate.
+   * @return the digit of A in EVALUATION format.
+   */
+    static Element ExpandSeededA(const std::vector<uint32_t>& seed, uint32_t digit,
+                                 const std::shared_ptr<typename Element::Params>& params) {
+        const auto s = ToSeedType(seed);
+        Element a(params, Format::EVALUATION);
+        const auto& towerParams = params->GetParams();
+        const uint32_t n        = params->GetRingDimension();
+        for (uint32_t i = 0; i < towerParams.size(); ++i) {
+            const auto& qi = towerParams[i]->GetModulus();
+            auto values    = SeededUniformGenerator::GenerateVector(s, SeedStreamId(digit, i), n, qi);
+            a.SetElementAtIndex(i, typename Element::PolyType(towerParams[i], Format::EVALUATION, std::move(values)));
+        }
+        return a;
+    }
+
+    /**
+   * Converts a seed as stored in the key to the type used by SeededUniformGenerator.
+   */
+    static SeededUniformGenerator::SeedType ToSeedType(const std::vector<uint32_t>& seed) {
+        if (seed.size() != SeededUniformGenerator::SEED_WORDS)
+            OPENFHE_THROW("Seed must have " + std::to_string(SeededUniformGenerator::SEED_WORDS) + " words");
+        SeededUniformGenerator::SeedType s{};
+        std::copy(seed.begin(), seed.end(), s.begin());
+        return s;
+    }
+
+    /**
+   * Returns the number of bytes of key data held in memory.
+   * Overrides base class implementation.
+   */
+    virtual size_t GetByteSize() const {
+        size_t size = m_seed.size() * sizeof(uint32_t) + ElementsByteSize(m_dcrtKeys);
+        for (const auto& v : m_rKey)
+            size += ElementsByteSize(v);
+        std::lock_guard<std::mutex> lock(m_aCacheMutex);
+        return size + ElementsByteSize(m_aCache);
+    }
+
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_seed.clear();
+        m_aCache.clear();
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -243,6 +352,8 @@ public:
         if (!CryptoObject<Element>::operator==(other))
             return false;
 
+        if (this->m_seed != oth.m_seed)
+            return false;
         if (this->m_rKey.size() != oth.m_rKey.size())
             return false;
         for (size_t i = 0; i < this->m_rKey.size(); i++) {
@@ -260,6 +371,7 @@ public:
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
         ar(::cereal::make_nvp("k", m_rKey));
+        ar(::cereal::make_nvp("sd", m_seed));
     }
 
     template <class Archive>
@@ -270,20 +382,43 @@ public:
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
         ar(::cereal::make_nvp("k", m_rKey));
+        // version 1 keys always store Element Vector A
+        if (version > 1)
+            ar(::cereal::make_nvp("sd", m_seed));
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
+    // the size of the coefficients of all towers of the elements
+    template <typename DCRTElement>
+    static size_t ElementsByteSize(const std::vector<DCRTElement>& elements) {
+        size_t size = 0;
+        for (const auto& element : elements) {
+            for (const auto& tower : element.GetAllElements()) {
+                if (!tower.IsEmpty())
+                    size += tower.GetLength() * sizeof(NativeInteger);
+            }
+        }
+        return size;
+    }
+
     // private member to store vector of vector of Element.
     std::vector<std::vector<Element>> m_rKey;
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
+
+    // seed of Element Vector A for seeded keys; m_rKey[0] is empty then
+    std::vector<uint32_t> m_seed;
+
+    // Element Vector A of a seeded key, expanded on the first call to GetAVector()
+    mutable std::vector<Element> m_aCache;
+    mutable std::mutex m_aCacheMutex;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,275 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Memory-mapped store of automorphism keys that are loaded on first use
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "cryptocontext-fwd.h"
+#include "key/evalkey.h"
+#include "lattice/lat-hal.h"
+#include "utils/mappedfile.h"
+
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+class EvalKeyStore;
+
+/**
+ * @brief Position of one key in a key store file
+ */
+struct EvalKeyStoreEntry {
+    uint32_t index{0};
+    uint64_t offset{0};
+    uint64_t size{0};
+};
+
+/**
+ * @brief Writes automorphism keys to a key store file one key at a time, so that the keys never have to be in
+ * memory all at once. The file consists of
+ *   - a header: the magic "OFHEKST1", the format version and the key tag;
+ *   - one record per key: the key serialized with SerType::BINARY, starting at a multiple of
+ *     EvalKeyStore::ALIGNMENT so that each key can be mapped and released page by page;
+ *   - an index table with the automorphism index, offset and size of each record;
+ *   - a footer with the offset of the index table, the number of keys and the magic.
+ * All integers are stored in the byte order of the machine.
+ */
+class EvalKeyStoreWriter {
+public:
+    /**
+     * Creates the file and writes the header; throws if the file cannot be created.
+     * @param path is the path of the store file.
+     * @param keyTag is the tag of the keys that will be written.
+     */
+    EvalKeyStoreWriter(const std::string& path, const std::string& keyTag);
+
+    /**
+     * Closes the file if Close() was not called; errors are not reported.
+     */
+    ~EvalKeyStoreWriter();
+
+    EvalKeyStoreWriter(const EvalKeyStoreWriter&)            = delete;
+    EvalKeyStoreWriter& operator=(const EvalKeyStoreWriter&) = delete;
+
+    /**
+     * Appends a key to the file.
+     * @param index is the automorphism index of the key.
+     * @param key is the key; a lazily loaded key is loaded first.
+     */
+    void Append(uint32_t index, const EvalKey<DCRTPoly>& key);
+
+    /**
+     * Appends several keys to the file, serializing them in parallel and writing them in the order of the map.
+     * @param keys are the keys by automorphism index; lazily loaded keys are loaded first.
+     */
+    void Append(const std::map<uint32_t, EvalKey<DCRTPoly>>& keys);
+
+    /// @return the keys written so far
+    const std::vector<EvalKeyStoreEntry>& GetEntries() const {
+        return m_entries;
+    }
+
+    /**
+     * Writes the index table and the footer and closes the file.
+     */
+    void Close();
+
+private:
+    // pads the file to the next record boundary and returns the offset of the record
+    uint64_t StartRecord();
+
+    std::string m_path;
+    std::ofstream m_out;
+    std::vector<EvalKeyStoreEntry> m_entries;
+    bool m_closed{false};
+};
+
+/**
+ * @brief Automorphism key that is deserialized from a key store on first use. Only up to a bounded number of
+ * keys of the store are kept in memory; the least recently used one is dropped when another one is loaded.
+ * The references returned by GetAVector()/GetBVector() stay valid only while the key is in memory, so code that
+ * reads the vectors of a key holds the key returned by PinEvalKey() or LoadResident() instead, as the key switching
+ * and multiparty routines do.
+ */
+class EvalKeyStoreProxy : public EvalKeyImpl<DCRTPoly> {
+public:
+    EvalKeyStoreProxy(const CryptoContext<DCRTPoly>& cc, std::shared_ptr<EvalKeyStore> store,
+                      const EvalKeyStoreEntry& entry);
+
+    ~EvalKeyStoreProxy();
+
+    EvalKey<DCRTPoly> LoadResident() const override;
+
+    void Prefetch() const override;
+
+    const std::vector<DCRTPoly>& GetAVector() const override {
+        return LoadResident()->GetAVector();
+    }
+
+    const std::vector<DCRTPoly>& GetBVector() const override {
+        return LoadResident()->GetBVector();
+    }
+
+    const std::vector<uint32_t>& GetSeed() const override {
+        return LoadResident()->GetSeed();
+    }
+
+    bool IsSeeded() const override {
+        return LoadResident()->IsSeeded();
+    }
+
+    /**
+     * Returns the number of bytes of key data held in memory, which is 0 while the key is not loaded.
+     */
+    size_t GetByteSize() const override;
+
+    /**
+     * Drops the data of the key from memory; it is loaded again on next use.
+     */
+    void ClearKeys() override;
+
+    bool key_compare(const EvalKeyImpl<DCRTPoly>& other) const override {
+        return LoadResident()->key_compare(other);
+    }
+
+    /// @return true if the data of the key is in memory
+    bool IsResident() const;
+
+private:
+    friend class EvalKeyStore;
+
+    std::shared_ptr<EvalKeyStore> m_store;
+    EvalKeyStoreEntry m_entry;
+    // allows one thread at a time to load this key, while other keys load concurrently
+    mutable std::mutex m_loadMutex;
+    // the fields below are guarded by the mutex of the store
+    mutable EvalKey<DCRTPoly> m_resident;
+    mutable std::list<const EvalKeyStoreProxy*>::iterator m_lruPos;
+};
+
+/**
+ * @brief Read-only view of a key store file written by EvalKeyStoreWriter. The file is memory-mapped, and each
+ * key is deserialized from the mapping only when it is used for the first time. Keys obtained from the store
+ * cannot be serialized with SerializeEvalAutomorphismKey(); write them to a new store instead.
+ */
+class EvalKeyStore : public std::enable_shared_from_this<EvalKeyStore> {
+public:
+    static constexpr uint32_t VERSION   = 1;
+    static constexpr uint64_t ALIGNMENT = 4096;
+
+    /**
+     * Maps a key store file and reads its index; throws if the file is not a valid key store.
+     * @param path is the path of the store file.
+     * @param maxResidentKeys is the maximum number of keys kept in memory at once; 0 for no limit.
+     */
+    static std::shared_ptr<EvalKeyStore> Open(const std::string& path, uint32_t maxResidentKeys = 0);
+
+    /**
+     * Writes a map of automorphism keys to a key store file.
+     */
+    static void Write(const std::string& path, const std::string& keyTag,
+                      const std::map<uint32_t, EvalKey<DCRTPoly>>& keys);
+
+    const std::string& GetKeyTag() const {
+        return m_keyTag;
+    }
+
+    const std::vector<EvalKeyStoreEntry>& GetEntries() const {
+        return m_entries;
+    }
+
+    uint32_t GetMaxResidentKeys() const {
+        return m_maxResidentKeys;
+    }
+
+    /// @return the number of keys of the store currently in memory
+    uint32_t GetNumResidentKeys() const;
+
+    /**
+     * Creates lazily loaded keys for the keys in the store.
+     * @param cc is the crypto context the keys were generated for.
+     * @param indices are the automorphism indices of the keys; empty for all keys. Throws if the store has no
+     * key for one of them.
+     * @return the keys by automorphism index, as stored in the automorphism key map of the crypto context
+     */
+    std::shared_ptr<std::map<uint32_t, EvalKey<DCRTPoly>>> GetKeyMap(const CryptoContext<DCRTPoly>& cc,
+                                                                     const std::vector<uint32_t>& indices = {});
+
+    /**
+     * Deserializes keys of the store in parallel, independently of the keys kept in memory by the store. Only the
+     * records of the selected keys are read.
+     * @param indices are the automorphism indices of the keys; empty for all keys. Throws if the store has no
+     * key for one of them.
+     * @return the keys by automorphism index
+     */
+    std::shared_ptr<std::map<uint32_t, EvalKey<DCRTPoly>>> ReadKeys(const std::vector<uint32_t>& indices = {}) const;
+
+    /**
+     * Deserializes one key from the mapped file, independently of the keys kept in memory by the store.
+     */
+    EvalKey<DCRTPoly> ReadKey(const EvalKeyStoreEntry& entry) const;
+
+private:
+    friend class EvalKeyStoreProxy;
+
+    EvalKeyStore(const std::string& path, uint32_t maxResidentKeys);
+
+    // the entries of the given indices, or all entries if indices is empty
+    std::vector<EvalKeyStoreEntry> SelectEntries(const std::vector<uint32_t>& indices) const;
+
+    EvalKey<DCRTPoly> Load(const EvalKeyStoreProxy& proxy);
+    void Evict(const EvalKeyStoreProxy& proxy);
+
+    MappedFile m_file;
+    std::string m_keyTag;
+    std::vector<EvalKeyStoreEntry> m_entries;
+    uint32_t m_maxResidentKeys;
+
+    mutable std::mutex m_mutex;
+    // keys in memory, the most recently used first
+    std::list<const EvalKeyStoreProxy*> m_lru;
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
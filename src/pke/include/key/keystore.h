@@ -0,0 +1,323 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Concurrent store of the evaluation keys of a crypto context, optimized for lookups
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_KEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_KEYSTORE_H
+
+#include "key/evalkey.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Relinearization and automorphism keys by secret key tag, safe to use from several threads.
+ *
+ * The keys are kept in an immutable snapshot of both tables that is replaced as a whole (read-copy-update): a lookup
+ * loads the current snapshot with an atomic shared_ptr load and never waits for a writer, while a writer copies the
+ * snapshot, modifies the copy and publishes it with a compare-and-swap, retrying if another writer published first.
+ * Readers thus see an update of both tables, as by Evict(), at once. Keys and key maps obtained from the store stay
+ * valid while they are held, also if they are replaced or evicted meanwhile. The automorphism key maps returned by
+ * the store are shared with it and must not be modified; a map passed to an insert function must not be modified
+ * afterwards. Crypto contexts share one store unless a context is given its own with CryptoContextImpl::SetKeyStore().
+ */
+template <typename Element>
+class KeyStore {
+public:
+    using EvalKeyMap             = std::map<uint32_t, EvalKey<Element>>;
+    using EvalMultKeyMap         = std::map<std::string, std::vector<EvalKey<Element>>>;
+    using EvalAutomorphismKeyMap = std::map<std::string, std::shared_ptr<EvalKeyMap>>;
+
+    KeyStore() : m_tables(std::make_shared<Tables>()) {}
+
+    KeyStore(const KeyStore&)            = delete;
+    KeyStore& operator=(const KeyStore&) = delete;
+
+    /// @return the current relinearization keys of all tags
+    std::shared_ptr<const EvalMultKeyMap> GetEvalMultKeys() const {
+        const auto tables = std::atomic_load(&m_tables);
+        return std::shared_ptr<const EvalMultKeyMap>(tables, &tables->evalMultKeys);
+    }
+
+    /// @return the current automorphism keys of all tags
+    std::shared_ptr<const EvalAutomorphismKeyMap> GetEvalAutomorphismKeys() const {
+        const auto tables = std::atomic_load(&m_tables);
+        return std::shared_ptr<const EvalAutomorphismKeyMap>(tables, &tables->evalAutomorphismKeys);
+    }
+
+    /**
+     * Looks up the relinearization keys of a tag.
+     * @param keyTag is the tag of the secret key.
+     * @param keys receives the keys if they are found.
+     * @return true if the store has relinearization keys for the tag
+     */
+    bool FindEvalMultKeys(const std::string& keyTag, std::vector<EvalKey<Element>>& keys) const {
+        const auto table = GetEvalMultKeys();
+        const auto it    = table->find(keyTag);
+        if (it == table->end())
+            return false;
+        keys = it->second;
+        return true;
+    }
+
+    /**
+     * Looks up the automorphism keys of a tag.
+     * @param keyTag is the tag of the secret key.
+     * @return the keys by automorphism index, or nullptr if the store has no automorphism keys for the tag
+     */
+    std::shared_ptr<EvalKeyMap> FindEvalAutomorphismKeys(const std::string& keyTag) const {
+        const auto table = GetEvalAutomorphismKeys();
+        const auto it    = table->find(keyTag);
+        return (it == table->end()) ? nullptr : it->second;
+    }
+
+    /**
+     * Gets the relinearization keys of a tag; throws if the store has none.
+     * @param keyTag is the tag of the secret key.
+     * @return the keys
+     */
+    std::vector<EvalKey<Element>> GetEvalMultKeyVector(const std::string& keyTag) const {
+        std::vector<EvalKey<Element>> keys;
+        if (!FindEvalMultKeys(keyTag, keys))
+            OPENFHE_THROW("Call EvalMultKeyGen() to have EvalMultKey available for ID [" + keyTag + "].");
+        return keys;
+    }
+
+    /**
+     * Gets the automorphism keys of a tag; throws if the store has none.
+     * @param keyTag is the tag of the secret key.
+     * @return the keys by automorphism index
+     */
+    std::shared_ptr<EvalKeyMap> GetEvalAutomorphismKeyMapPtr(const std::string& keyTag) const {
+        auto keys = FindEvalAutomorphismKeys(keyTag);
+        if (!keys)
+            OPENFHE_THROW("EvalAutomorphismKeys are not generated for ID [" + keyTag + "].");
+        return keys;
+    }
+
+    /**
+     * Returns the number of bytes of key data the store holds in memory. A key that is in the store several times
+     * is counted once, and lazily loaded keys count only while their data is loaded.
+     */
+    size_t GetByteSize() const {
+        const auto tables = std::atomic_load(&m_tables);
+        std::set<const EvalKeyImpl<Element>*> counted;
+        size_t size = 0;
+        for (const auto& [tag, keys] : tables->evalMultKeys)
+            size += GetByteSize(keys, counted);
+        for (const auto& [tag, keys] : tables->evalAutomorphismKeys)
+            size += GetByteSize(*keys, counted);
+        return size;
+    }
+
+    /**
+     * Returns the number of bytes of key data the store holds in memory for a tag.
+     * @param keyTag is the tag of the secret key.
+     */
+    size_t GetByteSize(const std::string& keyTag) const {
+        const auto tables = std::atomic_load(&m_tables);
+        std::set<const EvalKeyImpl<Element>*> counted;
+        size_t size = 0;
+        const auto multKeys = tables->evalMultKeys.find(keyTag);
+        if (multKeys != tables->evalMultKeys.end())
+            size += GetByteSize(multKeys->second, counted);
+        const auto automorphismKeys = tables->evalAutomorphismKeys.find(keyTag);
+        if (automorphismKeys != tables->evalAutomorphismKeys.end())
+            size += GetByteSize(*automorphismKeys->second, counted);
+        return size;
+    }
+
+    /**
+     * Inserts the relinearization keys of a tag.
+     * @param keyTag is the tag of the secret key.
+     * @param keys are the keys.
+     * @param replace selects whether existing keys of the tag are replaced or kept.
+     * @return true if the keys were inserted, false if the tag already had keys that were kept
+     */
+    bool InsertEvalMultKeys(const std::string& keyTag, const std::vector<EvalKey<Element>>& keys, bool replace) {
+        return Update([&](Tables& tables) {
+            if (!replace && tables.evalMultKeys.count(keyTag))
+                return false;
+            tables.evalMultKeys[keyTag] = keys;
+            return true;
+        });
+    }
+
+    /**
+     * Inserts automorphism keys of a tag. With replace, the keys of the tag are replaced by the given map; otherwise
+     * the keys for indices the tag has no key for yet are added to its keys, and the existing keys are kept.
+     * @param keyTag is the tag of the secret key.
+     * @param keys are the keys by automorphism index.
+     * @param replace selects whether the existing keys of the tag are replaced.
+     */
+    void InsertEvalAutomorphismKeys(const std::string& keyTag, std::shared_ptr<EvalKeyMap> keys, bool replace) {
+        Update([&](Tables& tables) {
+            const auto it = tables.evalAutomorphismKeys.find(keyTag);
+            if (!replace && it != tables.evalAutomorphismKeys.end()) {
+                // a new map for the tag, as readers may hold the current one
+                auto merged = std::make_shared<EvalKeyMap>(*it->second);
+                for (const auto& [index, key] : *keys)
+                    merged->emplace(index, key);
+                if (merged->size() == it->second->size())
+                    return false;
+                it->second = std::move(merged);
+                return true;
+            }
+            tables.evalAutomorphismKeys[keyTag] = keys;
+            return true;
+        });
+    }
+
+    /**
+     * Removes the relinearization keys of the tags selected by a predicate.
+     * @param pred is called with the tag and the keys of every tag.
+     * @return the number of tags removed
+     */
+    template <typename Pred>
+    size_t EraseEvalMultKeysIf(Pred pred) {
+        size_t erased = 0;
+        Update([&](Tables& tables) {
+            erased = EraseIf(tables.evalMultKeys, pred);
+            return erased > 0;
+        });
+        return erased;
+    }
+
+    /**
+     * Removes the automorphism keys of the tags selected by a predicate.
+     * @param pred is called with the tag and the key map of every tag.
+     * @return the number of tags removed
+     */
+    template <typename Pred>
+    size_t EraseEvalAutomorphismKeysIf(Pred pred) {
+        size_t erased = 0;
+        Update([&](Tables& tables) {
+            erased = EraseIf(tables.evalAutomorphismKeys, pred);
+            return erased > 0;
+        });
+        return erased;
+    }
+
+    /**
+     * Removes all keys of a tag at once: readers see either all or none of the keys of the tag.
+     * @param keyTag is the tag of the secret key.
+     * @return true if the tag had keys
+     */
+    bool Evict(const std::string& keyTag) {
+        return Update([&keyTag](Tables& tables) {
+            const size_t erased = tables.evalMultKeys.erase(keyTag) + tables.evalAutomorphismKeys.erase(keyTag);
+            return erased > 0;
+        });
+    }
+
+    /**
+     * Removes all keys.
+     */
+    void Clear() {
+        std::atomic_store(&m_tables, std::shared_ptr<const Tables>(std::make_shared<Tables>()));
+    }
+
+private:
+    // the tables of the store, published together
+    struct Tables {
+        EvalMultKeyMap evalMultKeys;
+        EvalAutomorphismKeyMap evalAutomorphismKeys;
+    };
+
+    // applies an update to a copy of the current tables and publishes the copy if the tables were not replaced
+    // meanwhile, retrying with the new tables otherwise; update returns false to leave the tables unchanged
+    template <typename Fn>
+    bool Update(Fn update) {
+        std::shared_ptr<const Tables> current = std::atomic_load(&m_tables);
+        while (true) {
+            auto tables = std::make_shared<Tables>(*current);
+            if (!update(*tables))
+                return false;
+            std::shared_ptr<const Tables> next(std::move(tables));
+            if (std::atomic_compare_exchange_weak(&m_tables, &current, next))
+                return true;
+        }
+    }
+
+    // sums the sizes of the keys of a vector or map that are not counted yet
+    template <typename Keys>
+    static size_t GetByteSize(const Keys& keys, std::set<const EvalKeyImpl<Element>*>& counted) {
+        size_t size = 0;
+        for (const auto& entry : keys) {
+            const EvalKeyImpl<Element>* key = GetKey(entry).get();
+            if (key != nullptr && counted.insert(key).second)
+                size += key->GetByteSize();
+        }
+        return size;
+    }
+
+    static const EvalKey<Element>& GetKey(const EvalKey<Element>& key) {
+        return key;
+    }
+
+    static const EvalKey<Element>& GetKey(const typename EvalKeyMap::value_type& entry) {
+        return entry.second;
+    }
+
+    // removes the selected entries of a table
+    template <typename Table, typename Pred>
+    static size_t EraseIf(Table& table, Pred& pred) {
+        size_t erased = 0;
+        for (auto it = table.begin(); it != table.end();) {
+            if (pred(it->first, it->second)) {
+                it = table.erase(it);
+                ++erased;
+            }
+            else {
+                ++it;
+            }
+        }
+        return erased;
+    }
+
+    // the current tables; only accessed with atomic loads, stores and compare-and-swaps
+    std::shared_ptr<const Tables> m_tables;
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_CRYPTO_KEY_KEYSTORE_H
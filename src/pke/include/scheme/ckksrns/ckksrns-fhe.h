@@ -39,6 +39,7 @@
 #include "utils/caller_info.h"
 #include "math/hal/basicint.h"
 
+#include <complex>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,6 +52,19 @@
  */
 namespace lbcrypto {
 
+// Compact form of the plaintexts of one linear transform level: the rotated and scaled diagonals are kept as
+// complex values and encoded on demand, which takes a fraction of the memory of the encoded plaintexts
+struct CKKSBootstrapDiagonals {
+    // the extended basis P*Q the diagonals are encoded in, without the towers of Q dropped at m_level
+    std::shared_ptr<ILDCRTParams<BigInteger>> m_params;
+
+    // the number of towers dropped from the extended basis when encoding
+    uint32_t m_level = 0;
+
+    // the diagonals in the order of the plaintexts; empty where no plaintext is needed
+    std::vector<std::vector<std::complex<double>>> m_values;
+};
+
 class CKKSBootstrapPrecom {
 public:
     CKKSBootstrapPrecom() {}
@@ -64,6 +78,13 @@ public:
         m_U0hatTPre    = rhs.m_U0hatTPre;
         m_U0PreFFT     = rhs.m_U0PreFFT;
         m_U0hatTPreFFT = rhs.m_U0hatTPreFFT;
+        m_deferModDown = rhs.m_deferModDown;
+
+        m_U0PreDiag         = rhs.m_U0PreDiag;
+        m_U0hatTPreDiag     = rhs.m_U0hatTPreDiag;
+        m_U0PreFFTDiag      = rhs.m_U0PreFFTDiag;
+        m_U0hatTPreFFTDiag  = rhs.m_U0hatTPreFFTDiag;
+        m_maxPlaintextBytes = rhs.m_maxPlaintextBytes;
     }
 
     CKKSBootstrapPrecom(CKKSBootstrapPrecom&& rhs) {
@@ -75,6 +96,13 @@ public:
         m_U0hatTPre    = std::move(rhs.m_U0hatTPre);
         m_U0PreFFT     = std::move(rhs.m_U0PreFFT);
         m_U0hatTPreFFT = std::move(rhs.m_U0hatTPreFFT);
+        m_deferModDown = rhs.m_deferModDown;
+
+        m_U0PreDiag         = std::move(rhs.m_U0PreDiag);
+        m_U0hatTPreDiag     = std::move(rhs.m_U0hatTPreDiag);
+        m_U0PreFFTDiag      = std::move(rhs.m_U0PreFFTDiag);
+        m_U0hatTPreFFTDiag  = std::move(rhs.m_U0hatTPreFFTDiag);
+        m_maxPlaintextBytes = rhs.m_maxPlaintextBytes;
     }
 
     virtual ~CKKSBootstrapPrecom() {}
@@ -112,6 +140,21 @@ public:
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ConstPlaintext>> m_U0hatTPreFFT;
 
+    // if true, the giant steps of encoding and decoding keep c0 in the extended basis P*Q
+    // and scale it down once per level instead of once per giant step
+    bool m_deferModDown = false;
+
+    // diagonals of the levels of m_U0Pre, m_U0hatTPre, m_U0PreFFT and m_U0hatTPreFFT that are not kept encoded;
+    // the plaintexts of such a level are empty and are encoded one giant step at a time during bootstrapping
+    CKKSBootstrapDiagonals m_U0PreDiag;
+    CKKSBootstrapDiagonals m_U0hatTPreDiag;
+    std::vector<CKKSBootstrapDiagonals> m_U0PreFFTDiag;
+    std::vector<CKKSBootstrapDiagonals> m_U0hatTPreFFTDiag;
+
+    // bound on the memory taken by the encoded plaintexts; 0 keeps all levels encoded. Like m_deferModDown, it is
+    // not serialized, so a deserialized context keeps all levels encoded until EvalBootstrapSetup() is called again
+    uint64_t m_maxPlaintextBytes = 0;
+
     template <class Archive>
     void save(Archive& ar) const {
         ar(cereal::make_nvp("dim1_Enc", m_dim1));
@@ -143,21 +186,32 @@ public:
 
     void EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
                             std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
-                            bool precompute) override;
+                            bool precompute, bool deferModDown, uint64_t maxPlaintextBytes) override;
 
     std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalBootstrapKeyGen(const PrivateKey<DCRTPoly> privateKey,
-                                                                            uint32_t slots) override;
+                                                                            uint32_t slots,
+                                                                            uint32_t batchSlots) override;
 
     void EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc, uint32_t slots) override;
 
+    void WriteBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, const std::string& cacheDir,
+                                      uint32_t slots) const override;
+
+    bool LoadBootstrapPrecomputation(const CryptoContext<DCRTPoly>& cc, const std::string& cacheDir,
+                                     uint32_t slots) override;
+
     Ciphertext<DCRTPoly> EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                        uint32_t precision) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                         uint32_t numIterations, uint32_t precision) const override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
 
-    std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots, uint32_t M);
+    // batchSlots adds the rotations that unpack ciphertexts with batchSlots slots after EvalBootstrapBatch
+    std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots, uint32_t M, uint32_t batchSlots = 0);
 
     std::vector<int32_t> FindLinearTransformRotationIndices(uint32_t slots, uint32_t M);
 
@@ -195,13 +249,17 @@ public:
     // EVALUATION: CoeffsToSlots and SlotsToCoeffs
     //------------------------------------------------------------------------------
 
-    Ciphertext<DCRTPoly> EvalLinearTransform(const std::vector<ConstPlaintext>& A, ConstCiphertext<DCRTPoly> ct) const;
+    // the optional diagonals supply the plaintexts that are not present in A, see CKKSBootstrapPrecom
+    Ciphertext<DCRTPoly> EvalLinearTransform(const std::vector<ConstPlaintext>& A, ConstCiphertext<DCRTPoly> ct,
+                                             const CKKSBootstrapDiagonals* diagonals = nullptr) const;
 
     Ciphertext<DCRTPoly> EvalCoeffsToSlots(const std::vector<std::vector<ConstPlaintext>>& A,
-                                           ConstCiphertext<DCRTPoly> ctxt) const;
+                                           ConstCiphertext<DCRTPoly> ctxt,
+                                           const std::vector<CKKSBootstrapDiagonals>* diagonals = nullptr) const;
 
     Ciphertext<DCRTPoly> EvalSlotsToCoeffs(const std::vector<std::vector<ConstPlaintext>>& A,
-                                           ConstCiphertext<DCRTPoly> ctxt) const;
+                                           ConstCiphertext<DCRTPoly> ctxt,
+                                           const std::vector<CKKSBootstrapDiagonals>* diagonals = nullptr) const;
 
     //------------------------------------------------------------------------------
     // SERIALIZATION
@@ -247,12 +305,59 @@ private:
                                const std::vector<std::complex<double>>& value, size_t noiseScaleDeg, uint32_t level,
                                usint slots) const;
 
+    CKKSBootstrapDiagonals EvalLinearTransformDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                        const std::vector<std::vector<std::complex<double>>>& A,
+                                                        double scale, uint32_t L) const;
+
+    CKKSBootstrapDiagonals EvalLinearTransformDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                        const std::vector<std::vector<std::complex<double>>>& A,
+                                                        const std::vector<std::vector<std::complex<double>>>& B,
+                                                        uint32_t orientation, double scale, uint32_t L) const;
+
+    std::vector<CKKSBootstrapDiagonals> EvalCoeffsToSlotsDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                                   const std::vector<std::complex<double>>& A,
+                                                                   const std::vector<uint32_t>& rotGroup, bool flag_i,
+                                                                   double scale, uint32_t L) const;
+
+    std::vector<CKKSBootstrapDiagonals> EvalSlotsToCoeffsDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                                   const std::vector<std::complex<double>>& A,
+                                                                   const std::vector<uint32_t>& rotGroup, bool flag_i,
+                                                                   double scale, uint32_t L) const;
+
+    // encodes count plaintexts of the diagonals starting from first
+    std::vector<ConstPlaintext> EncodeDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                const CKKSBootstrapDiagonals& diagonals, uint32_t first,
+                                                uint32_t count) const;
+
+    // returns count plaintexts of a level starting from first, encoding them if the level is kept as diagonals
+    std::vector<ConstPlaintext> GetGiantStepPlaintexts(const CryptoContextImpl<DCRTPoly>& cc,
+                                                       const std::vector<ConstPlaintext>& A,
+                                                       const CKKSBootstrapDiagonals* diagonals, uint32_t first,
+                                                       uint32_t count) const;
+
+    // encodes the levels of the precomputation that fit in its plaintext memory bound and keeps the other levels
+    // as diagonals
+    void SetBootstrapPlaintexts(const CryptoContextImpl<DCRTPoly>& cc, CKKSBootstrapPrecom& precom,
+                                std::vector<CKKSBootstrapDiagonals>&& enc, std::vector<CKKSBootstrapDiagonals>&& dec,
+                                bool fft) const;
+
     Ciphertext<DCRTPoly> EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const;
 
     void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
     Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    /**
+   * Giant step of the baby-step giant-step linear transforms with deferred ModDown: rotates inner, a sum of baby
+   * steps in the extended basis P*Q, by index and accumulates it into outer, also in P*Q. Only c1 of inner is
+   * scaled down to Q to compute its digits; c0 is rotated in P*Q and scaled down later together with outer.
+   *
+   * @param outer accumulator in the extended basis
+   * @param inner sum of baby steps in the extended basis; its elements are consumed
+   * @param index giant-step rotation index
+   */
+    void EvalGiantStepExtInPlace(Ciphertext<DCRTPoly>& outer, Ciphertext<DCRTPoly>& inner, int32_t index) const;
+
     EvalKey<DCRTPoly> ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const;
 
     Ciphertext<DCRTPoly> Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
@@ -151,6 +151,20 @@ public:
     // Compress
     /////////////////////////////////////
 
+    /**
+   * Rescales the ciphertext to a noise scale degree of 1 and drops all towers that the message does not need: the
+   * kept towers leave the message the same headroom above the scaling factor as a single tower leaves it at the last
+   * level. If a single tower is left and precisionBits is not 0, the coefficients are also rounded to multiples of a
+   * power of two, so that the compact wire format (Wire::SerializeCompact) omits their low-order bits. The rounding
+   * adds an error of less than 2^-precisionBits to the decrypted values.
+   *
+   * @param ciphertext the ciphertext to compress.
+   * @param precisionBits the number of fractional bits of the decrypted values to preserve, 0 for all.
+   * @return the compressed ciphertext.
+   */
+    Ciphertext<DCRTPoly> CompressForTransport(ConstCiphertext<DCRTPoly> ciphertext,
+                                              uint32_t precisionBits) const override;
+
     /////////////////////////////////////
     // CKKS Core
     /////////////////////////////////////
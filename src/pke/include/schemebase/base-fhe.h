@@ -45,6 +45,7 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <string>
 #include <utility>
 
 /**
@@ -81,10 +82,12 @@ public:
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to rescale message by to improve precision. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64
    * @param precompute - flag specifying whether to precompute the plaintexts for encoding and decoding.
+   * @param deferModDown - flag specifying whether the giant steps of encoding and decoding defer the ModDown of c0.
+   * @param maxPlaintextBytes - bound on the memory of the encoded plaintexts; 0 keeps all plaintexts encoded.
    */
     virtual void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, std::vector<uint32_t> levelBudget,
                                     std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
-                                    bool precompute) {
+                                    bool precompute, bool deferModDown, uint64_t maxPlaintextBytes) {
         OPENFHE_THROW("Not supported");
     }
 
@@ -94,10 +97,12 @@ public:
    *
    * @param privateKey private key.
    * @param slots - number of slots to be bootstrapped
+   * @param batchSlots - number of slots of the ciphertexts packed by EvalBootstrapBatch, 0 if not used
    * @return the dictionary of evaluation key indices.
    */
     virtual std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalBootstrapKeyGen(const PrivateKey<Element> privateKey,
-                                                                                   uint32_t slots) {
+                                                                                   uint32_t slots,
+                                                                                   uint32_t batchSlots) {
         OPENFHE_THROW("Not supported");
     }
 
@@ -110,6 +115,31 @@ public:
         OPENFHE_THROW("Not supported");
     }
 
+    /**
+   * Writes the plaintexts for encoding and decoding to a cache file in the given directory. The file is named
+   * after a hash of the crypto parameters and the bootstrapping parameters of the slots.
+   *
+   * @param cacheDir - directory of the cache files
+   * @param slots - number of slots to be bootstrapped
+   */
+    virtual void WriteBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& cacheDir,
+                                              uint32_t slots) const {
+        OPENFHE_THROW("Not supported");
+    }
+
+    /**
+   * Loads the plaintexts for encoding and decoding from the cache file written by WriteBootstrapPrecomputation()
+   * for the same parameters.
+   *
+   * @param cacheDir - directory of the cache files
+   * @param slots - number of slots to be bootstrapped
+   * @return false if the directory has no cache file for the parameters
+   */
+    virtual bool LoadBootstrapPrecomputation(const CryptoContext<Element>& cc, const std::string& cacheDir,
+                                             uint32_t slots) {
+        OPENFHE_THROW("Not supported");
+    }
+
     /**
    * Defines the bootstrapping evaluation of ciphertext
    *
@@ -130,6 +160,19 @@ public:
         OPENFHE_THROW("EvalBootstrap is not implemented for this scheme");
     }
 
+    /**
+   * Virtual function to bootstrap several sparsely packed ciphertexts at the cost of one bootstrapping.
+   *
+   * @param ciphertexts the input ciphertexts, all with the same number of slots.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts.
+   */
+    virtual std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                                uint32_t numIterations, uint32_t precision) const {
+        OPENFHE_THROW("EvalBootstrapBatch is not implemented for this scheme");
+    }
+
     /**
    * Sets all parameters for switching from CKKS to FHEW
    *
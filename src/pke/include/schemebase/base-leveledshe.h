@@ -708,6 +708,20 @@ public:
         OPENFHE_THROW("Compress is not supported for this scheme");
     }
 
+    /**
+   * Reduces a ciphertext to the fewest towers it can be decrypted from with the given precision, to send it to the
+   * holder of the secret key.
+   *
+   * @param ciphertext the ciphertext to compress.
+   * @param precisionBits the number of bits of precision of the decrypted values to preserve for approximate
+   * schemes; 0 preserves the full precision.
+   * @return the compressed ciphertext.
+   */
+    virtual Ciphertext<Element> CompressForTransport(ConstCiphertext<Element> ciphertext,
+                                                     uint32_t precisionBits) const {
+        OPENFHE_THROW("CompressForTransport is not supported for this scheme");
+    }
+
     /**
    * Method for rescaling.
    *
@@ -1046,6 +1046,14 @@ public:
         return m_LeveledSHE->Compress(ciphertext, towersLeft);
     }
 
+    virtual Ciphertext<Element> CompressForTransport(ConstCiphertext<Element> ciphertext,
+                                                     uint32_t precisionBits) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_LeveledSHE->CompressForTransport(ciphertext, precisionBits);
+    }
+
     virtual void AdjustLevelsInPlace(Ciphertext<DCRTPoly>& ciphertext1, Ciphertext<DCRTPoly>& ciphertext2) const {
         VerifyLeveledSHEEnabled(__func__);
         if (!ciphertext1)
@@ -1384,16 +1392,18 @@ public:
 
     void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, const std::vector<uint32_t>& levelBudget = {5, 4},
                             const std::vector<uint32_t>& dim1 = {0, 0}, uint32_t slots = 0,
-                            uint32_t correctionFactor = 0, bool precompute = true) {
+                            uint32_t correctionFactor = 0, bool precompute = true, bool deferModDown = false,
+                            uint64_t maxPlaintextBytes = 0) {
         VerifyFHEEnabled(__func__);
-        m_FHE->EvalBootstrapSetup(cc, levelBudget, dim1, slots, correctionFactor, precompute);
+        m_FHE->EvalBootstrapSetup(cc, levelBudget, dim1, slots, correctionFactor, precompute, deferModDown,
+                                  maxPlaintextBytes);
         return;
     }
 
     std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> EvalBootstrapKeyGen(const PrivateKey<Element> privateKey,
-                                                                              uint32_t slots) {
+                                                                              uint32_t slots, uint32_t batchSlots = 0) {
         VerifyFHEEnabled(__func__);
-        return m_FHE->EvalBootstrapKeyGen(privateKey, slots);
+        return m_FHE->EvalBootstrapKeyGen(privateKey, slots, batchSlots);
     }
 
     void EvalBootstrapPrecompute(const CryptoContextImpl<Element>& cc, uint32_t slots = 0) {
@@ -1402,12 +1412,30 @@ public:
         return;
     }
 
+    void WriteBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& cacheDir,
+                                      uint32_t slots = 0) const {
+        VerifyFHEEnabled(__func__);
+        m_FHE->WriteBootstrapPrecomputation(cc, cacheDir, slots);
+    }
+
+    bool LoadBootstrapPrecomputation(const CryptoContext<Element>& cc, const std::string& cacheDir,
+                                     uint32_t slots = 0) {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->LoadBootstrapPrecomputation(cc, cacheDir, slots);
+    }
+
     Ciphertext<Element> EvalBootstrap(ConstCiphertext<Element> ciphertext, uint32_t numIterations = 1,
                                       uint32_t precision = 0) const {
         VerifyFHEEnabled(__func__);
         return m_FHE->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
+
     // SCHEMESWITCHING methods
 
     LWEPrivateKey EvalCKKStoFHEWSetup(const SchSwchParams& params) {
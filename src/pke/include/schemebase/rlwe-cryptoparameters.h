@@ -82,6 +82,8 @@ public:
         m_statisticalSecurity   = rhs.m_statisticalSecurity;
         m_numAdversarialQueries = rhs.m_numAdversarialQueries;
         m_thresholdNumOfParties = rhs.m_thresholdNumOfParties;
+        m_seededEvalKeys        = rhs.m_seededEvalKeys;
+        m_seededEncryption      = rhs.m_seededEncryption;
     }
 
     /**
@@ -413,6 +415,40 @@ public:
         m_thresholdNumOfParties = thresholdNumOfParties;
     }
 
+    /**
+   * Returns true if evaluation keys are generated in the seeded form
+   */
+    bool GetSeededEvalKeys() const {
+        return m_seededEvalKeys;
+    }
+
+    /**
+   * Configures key generation to produce seeded evaluation keys, which store a seed instead of the uniformly random
+   * half a of every digit. This halves the memory and the serialized size of the keys; a is regenerated from the
+   * seed during key switching.
+   * @param seededEvalKeys true to generate seeded evaluation keys.
+   */
+    void SetSeededEvalKeys(bool seededEvalKeys) {
+        m_seededEvalKeys = seededEvalKeys;
+    }
+
+    /**
+   * Returns true if encryption with the secret key produces seeded ciphertexts
+   */
+    bool GetSeededEncryption() const {
+        return m_seededEncryption;
+    }
+
+    /**
+   * Configures encryption with the secret key to produce seeded ciphertexts, which store a seed instead of the
+   * uniformly random element c1. This halves the memory and the serialized size of fresh ciphertexts; c1 is
+   * regenerated from the seed on first use.
+   * @param seededEncryption true to produce seeded ciphertexts.
+   */
+    void SetSeededEncryption(bool seededEncryption) {
+        m_seededEncryption = seededEncryption;
+    }
+
     /**
    * == operator to compare to this instance of CryptoParametersRLWE object.
    *
@@ -540,6 +576,12 @@ protected:
     double m_numAdversarialQueries = 1;
 
     usint m_thresholdNumOfParties = 1;
+
+    // generate evaluation keys in the seeded form; only affects key generation, so it is not serialized
+    bool m_seededEvalKeys = false;
+
+    // produce seeded ciphertexts in secret-key encryption; only affects encryption, so it is not serialized
+    bool m_seededEncryption = false;
 };
 
 }  // namespace lbcrypto
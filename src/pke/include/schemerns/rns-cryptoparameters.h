@@ -476,6 +476,19 @@ public:
             "index out of bounds.");
     }
 
+    /**
+   * Gets the table [PartQHat]_{p_j} of GetPartQlHatModp() transposed for the basis conversion (see
+   * DCRTPoly::TransposeCRTTable).
+   *
+   * @return the precomputed table
+   */
+    const std::vector<uint64_t>& GetPartQlHatModpTransposed(uint32_t lvl, uint32_t part) const {
+        if (lvl < m_PartQlHatModpT.size() && part < m_PartQlHatModpT[lvl].size())
+            return m_PartQlHatModpT[lvl][part];
+
+        OPENFHE_THROW("GetPartQlHatModpTransposed - index out of bounds.");
+    }
+
     /**
    * Barrett multiplication precomputations getter.
    *
@@ -549,6 +562,16 @@ public:
         return m_PHatModq;
     }
 
+    /**
+   * Gets the table [P/p_j]_{q_i} of GetPHatModq() transposed for the basis conversion (see
+   * DCRTPoly::TransposeCRTTable).
+   *
+   * @return the precomputed table
+   */
+    const std::vector<uint64_t>& GetPHatModqTransposed() const {
+        return m_PHatModqT;
+    }
+
     /**
    * Gets the Barrett modulo reduction precomputation for q_i
    *
@@ -1439,6 +1462,9 @@ protected:
     // Stores [QHat_i]_{p_j}
     std::vector<std::vector<std::vector<std::vector<NativeInteger>>>> m_PartQlHatModp;
 
+    // Stores m_PartQlHatModp transposed for the basis conversion
+    std::vector<std::vector<std::vector<uint64_t>>> m_PartQlHatModpT;
+
     // Stores the Barrett mu for CompQBar_i
     std::vector<std::vector<std::vector<DoubleNativeInt>>> m_modComplPartqBarrettMu;
 
@@ -1457,6 +1483,9 @@ protected:
     // Stores [P/p_j]_{q_i}, required for GHS key switching
     std::vector<std::vector<NativeInteger>> m_PHatModq;
 
+    // Stores m_PHatModq transposed for the basis conversion
+    std::vector<uint64_t> m_PHatModqT;
+
     // Stores the BarrettUint128ModUint64 precomputations for q_j
     std::vector<DoubleNativeInt> m_modqBarrettMu;
 
@@ -291,6 +291,13 @@ public:
 
     Ciphertext<DCRTPoly> Compress(ConstCiphertext<DCRTPoly> ciphertext, size_t towersLeft) const override;
 
+    /**
+   * Compresses the ciphertext to the towers decryption needs: one, or two for FLEXIBLEAUTOEXT. The exact schemes
+   * cannot drop low-order bits, so precisionBits is ignored.
+   */
+    Ciphertext<DCRTPoly> CompressForTransport(ConstCiphertext<DCRTPoly> ciphertext,
+                                              uint32_t precisionBits) const override;
+
 protected:
     /////////////////////////////////////
     // RNS Core
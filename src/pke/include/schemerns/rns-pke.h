@@ -113,6 +113,18 @@ public:
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
+    /**
+   * Secret-key encryption of zero whose element c1 is expanded from a seed, for seeded ciphertexts
+   *
+   * @param &privateKey private key used for encryption.
+   * @param params the parameters of the elements, or nullptr for the full modulus.
+   * @param &seed the seed c1 is expanded from, see CiphertextImpl::ExpandSeededElement().
+   * @return the elements c0 and c1.
+   */
+    std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                           const std::shared_ptr<ParmType> params,
+                                                           const std::vector<uint32_t>& seed) const;
+
     std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCore(const PublicKey<DCRTPoly> publicKey,
                                                            const std::shared_ptr<ParmType> params) const override;
 
@@ -135,6 +147,11 @@ public:
     std::string SerializedObjectName() const {
         return "PKERNS";
     }
+
+protected:
+    // secret-key encryption of zero for the given uniformly random element a: c0 = a*s + e, c1 = -a
+    std::shared_ptr<std::vector<DCRTPoly>> EncryptZeroCoreWithA(const PrivateKey<DCRTPoly> privateKey,
+                                                                const DCRTPoly& a) const;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,184 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Native binary wire format of ciphertexts, plaintexts and keys that can be deserialized without copying
+ */
+
+#ifndef LBCRYPTO_CRYPTO_WIRE_SER_H
+#define LBCRYPTO_CRYPTO_WIRE_SER_H
+
+#include "ciphertext-fwd.h"
+#include "cryptocontext-fwd.h"
+#include "encoding/plaintext-fwd.h"
+#include "key/evalkey-fwd.h"
+#include "key/privatekey-fwd.h"
+#include "key/publickey-fwd.h"
+#include "lattice/lat-hal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace lbcrypto {
+
+/**
+ * @namespace Wire
+ * @brief Native binary serialization of DCRTPoly ciphertexts, plaintexts and keys.
+ *
+ * An object starts with a header of WIRE_ALIGNMENT bytes holding a magic value, the format version, a byte-order
+ * mark, the type of the object, the size of a native word and the total size. It is followed by the metadata of
+ * the object and its polynomials. Every polynomial stores its format, ring dimension and tower moduli, followed by
+ * the raw native words of its towers; each tower starts at a multiple of WIRE_ALIGNMENT bytes from the start of the
+ * object, so the towers of an aligned buffer can be used in place. The words are written in the byte order of the
+ * machine, and reading a buffer written with another byte order or word size throws.
+ *
+ * Unlike the cereal-based Serial functions, the crypto context is not serialized: the objects are deserialized
+ * into the crypto context passed by the caller, and tower parameters matching the crypto context are shared with
+ * it. A seeded ciphertext is written without expanding its seed. Ciphertext metadata is not supported, and a
+ * deserialized plaintext holds only its encoded element, so it can be used in homomorphic operations but not decoded.
+ *
+ * The compact ciphertext format is meant for sending results back to the party holding the secret key, usually after
+ * CryptoContext::CompressForTransport. It stores the coefficients of every tower with just as many bits as they need:
+ * the low-order bits that are zero in all coefficients of a tower, such as the ones cleared by CompressForTransport,
+ * are dropped, and the remaining bits are packed without padding. The towers are converted back to the evaluation
+ * format when reading, so compact ciphertexts cannot be used in place. A compact ciphertext has at most
+ * maxRelinSkDeg + 1 elements (at least 2), the size up to which the crypto context can relinearize it.
+ */
+namespace Wire {
+
+/// Current version of the format
+constexpr uint32_t VERSION = 2;
+
+/// Alignment of the header and of every tower, relative to the start of an object
+constexpr size_t WIRE_ALIGNMENT = intnat::TOWER_BUFFER_ALIGNMENT;
+
+/// Type of the object stored in a buffer
+enum class ObjectType : uint32_t {
+    CIPHERTEXT = 1,
+    PLAINTEXT,
+    PUBLIC_KEY,
+    PRIVATE_KEY,
+    EVAL_KEY,
+    COMPACT_CIPHERTEXT,
+};
+
+/**
+ * @brief A view of a serialized object in memory
+ */
+struct ByteSpan {
+    char* data{nullptr};
+    size_t size{0};
+};
+
+/**
+ * Computes the number of bytes an object takes in the wire format.
+ * @param obj is a Ciphertext, Plaintext, PublicKey, PrivateKey or EvalKey of DCRTPoly.
+ * @return the size in bytes
+ */
+template <typename T>
+size_t GetSerializedSize(const T& obj);
+
+/**
+ * Writes an object to a stream.
+ * @param obj is a Ciphertext, Plaintext, PublicKey, PrivateKey or EvalKey of DCRTPoly.
+ * @param out is the stream to write to.
+ */
+template <typename T>
+void Serialize(const T& obj, std::ostream& out);
+
+/**
+ * Writes an object to memory; throws if the buffer is too small.
+ * @param obj is a Ciphertext, Plaintext, PublicKey, PrivateKey or EvalKey of DCRTPoly.
+ * @param buffer is the memory to write to, which should start at a multiple of WIRE_ALIGNMENT bytes so that the
+ * object can be deserialized in place.
+ * @return the number of bytes written
+ */
+template <typename T>
+size_t SerializeToBuffer(const T& obj, ByteSpan buffer);
+
+/**
+ * Reads an object from memory.
+ *
+ * If owner is given and the buffer starts at a multiple of WIRE_ALIGNMENT bytes, the towers of the object are
+ * placed in the buffer instead of being copied: the object keeps owner alive, and operations modifying the object
+ * in place write to the buffer. Otherwise the towers are copied and the buffer can be released after the call.
+ *
+ * @param obj is the Ciphertext, Plaintext, PublicKey, PrivateKey or EvalKey of DCRTPoly to read into.
+ * @param buffer is the serialized object.
+ * @param cc is the crypto context the object belongs to.
+ * @param owner is the object owning the memory of the buffer.
+ */
+template <typename T>
+void DeserializeFromBuffer(T& obj, ByteSpan buffer, const CryptoContext<DCRTPoly>& cc,
+                           std::shared_ptr<void> owner = nullptr);
+
+/**
+ * Reads an object from a file, mapping the file copy-on-write and placing the towers of the object in the mapped
+ * memory where possible.
+ * @param obj is the Ciphertext, Plaintext, PublicKey, PrivateKey or EvalKey of DCRTPoly to read into.
+ * @param path is the path of the file.
+ * @param cc is the crypto context the object belongs to.
+ */
+template <typename T>
+void DeserializeFromFile(T& obj, const std::string& path, const CryptoContext<DCRTPoly>& cc);
+
+/**
+ * Computes the number of bytes a ciphertext takes in the compact format.
+ * @param ct is the ciphertext.
+ * @return the size in bytes
+ */
+size_t GetCompactSize(const Ciphertext<DCRTPoly>& ct);
+
+/**
+ * Writes a ciphertext to a stream in the compact format. The encoding is lossless: the size is only reduced by
+ * dropping towers and low-order bits beforehand, e.g. with CryptoContext::CompressForTransport.
+ * @param ct is the ciphertext.
+ * @param out is the stream to write to.
+ * @return the number of bytes written
+ */
+size_t SerializeCompact(const Ciphertext<DCRTPoly>& ct, std::ostream& out);
+
+/**
+ * Reads a ciphertext written in the compact format from memory. The buffer can be released after the call.
+ * @param ct is the ciphertext to read into.
+ * @param buffer is the serialized ciphertext.
+ * @param cc is the crypto context the ciphertext belongs to.
+ */
+void DeserializeCompact(Ciphertext<DCRTPoly>& ct, ByteSpan buffer, const CryptoContext<DCRTPoly>& cc);
+
+}  // namespace Wire
+
+}  // namespace lbcrypto
+
+#endif
@@ -31,8 +31,42 @@
 
 #include "ciphertext.h"
 
+#include "math/seededuniformgenerator.h"
+
+#include <algorithm>
+
 namespace lbcrypto {
 
+template <>
+DCRTPoly CiphertextImpl<DCRTPoly>::ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                                       const std::shared_ptr<DCRTPoly::Params>& params) {
+    if (seed.size() != SeededUniformGenerator::SEED_WORDS)
+        OPENFHE_THROW("Seed must have " + std::to_string(SeededUniformGenerator::SEED_WORDS) + " words");
+    SeededUniformGenerator::SeedType s{};
+    std::copy(seed.begin(), seed.end(), s.begin());
+
+    DCRTPoly result(params, Format::EVALUATION);
+    const auto& towerParams = params->GetParams();
+    const uint32_t n        = params->GetRingDimension();
+    for (uint32_t i = 0; i < towerParams.size(); ++i) {
+        auto values = SeededUniformGenerator::GenerateVector(s, i, n, towerParams[i]->GetModulus());
+        result.SetElementAtIndex(i, NativePoly(towerParams[i], Format::EVALUATION, std::move(values)));
+    }
+    return result;
+}
+
+template <>
+NativePoly CiphertextImpl<NativePoly>::ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                                           const std::shared_ptr<NativePoly::Params>& params) {
+    OPENFHE_THROW("Seeded ciphertexts are supported for DCRTPoly only");
+}
+
+template <>
+Poly CiphertextImpl<Poly>::ExpandSeededElement(const std::vector<uint32_t>& seed,
+                                               const std::shared_ptr<Poly::Params>& params) {
+    OPENFHE_THROW("Seeded ciphertexts are supported for DCRTPoly only");
+}
+
 template class CiphertextImpl<Poly>;
 template class CiphertextImpl<NativePoly>;
 template class CiphertextImpl<DCRTPoly>;
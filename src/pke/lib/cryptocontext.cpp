@@ -35,19 +35,37 @@
 
 #include "cryptocontext.h"
 
+#include "key/evalkeyrelin.h"
+#include "key/evalkeystore.h"
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "math/chebyshev.h"
 #include "schemerns/rns-scheme.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "utils/numa.h"
 
 namespace lbcrypto {
 
+namespace {
+
+// spreads the pages of a relinearization key over the NUMA nodes (see ParallelControls::SetNumaMode)
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
+void NumaInterleaveEvalKey(const EvalKey<Element>& key) {
+    if (!std::dynamic_pointer_cast<EvalKeyRelinImpl<Element>>(key))
+        return;
+    // a seeded key has no vector A in memory, and reading it would expand it
+    if (!key->IsSeeded()) {
+        for (const auto& a : key->GetAVector())
+            NumaInterleaveTowers(a);
+    }
+    for (const auto& b : key->GetBVector())
+        NumaInterleaveTowers(b);
+}
+
+}  // namespace
+
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap{};
+KeyStore<Element> CryptoContextImpl<Element>::s_keyStore{};
 
 template <typename Element>
 void CryptoContextImpl<Element>::SetKSTechniqueInScheme() {
@@ -71,11 +89,12 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeyGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
-        // the key is not found in the map, so the key has to be generated
-        EvalKey<Element> k                                           = GetScheme()->EvalMultKeyGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[k->GetKeyTag()] = {k};
+    std::vector<EvalKey<Element>> existing;
+    if (!GetKeyStore().FindEvalMultKeys(key->GetKeyTag(), existing)) {
+        // the key is not found in the map, so the key has to be generated. If another thread inserts a key for the
+        // same tag meanwhile, its key is kept
+        EvalKey<Element> k = GetScheme()->EvalMultKeyGen(key);
+        GetKeyStore().InsertEvalMultKeys(k->GetKeyTag(), {k}, false);
     }
 }
 
@@ -83,49 +102,46 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeysGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    std::vector<EvalKey<Element>> existing;
+    if (!GetKeyStore().FindEvalMultKeys(key->GetKeyTag(), existing)) {
         // the key is not found in the map, so the key has to be generated
-        const std::vector<EvalKey<Element>>& evalKeys                  = GetScheme()->EvalMultKeysGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[key->GetKeyTag()] = evalKeys;
+        GetKeyStore().InsertEvalMultKeys(key->GetKeyTag(), GetScheme()->EvalMultKeysGen(key), false);
     }
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys() {
-    CryptoContextImpl<Element>::s_evalMultKeyMap.clear();
+    s_keyStore.EraseEvalMultKeysIf([](const std::string&, const auto&) {
+        return true;
+    });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalMultKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalMultKeyMap.end())
-        CryptoContextImpl<Element>::s_evalMultKeyMap.erase(kd);
+    s_keyStore.EraseEvalMultKeysIf([&id](const std::string& tag, const auto&) {
+        return tag == id;
+    });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalMultKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalMultKeyMap.end();) {
-        if (it->second[0]->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalMultKeyMap.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    GetKeyStoreOf(cc).EraseEvalMultKeysIf([&cc](const std::string&, const auto& keys) {
+        return keys[0]->GetCryptoContext() == cc;
+    });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::InsertEvalMultKey(const std::vector<EvalKey<Element>>& vectorToInsert,
                                                    const std::string& keyTag) {
     const std::string tag = (keyTag.empty()) ? vectorToInsert[0]->GetKeyTag() : keyTag;
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(tag) != CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (OpenFHEParallelControls.GetNumaMode()) {
+        for (const auto& key : vectorToInsert)
+            NumaInterleaveEvalKey(key);
+    }
+    if (!GetKeyStoreOf(vectorToInsert[0]->GetCryptoContext()).InsertEvalMultKeys(tag, vectorToInsert, false)) {
         // we do not allow to override the existing key vector if its keyTag is identical to the keyTag of the new keys
         OPENFHE_THROW("Can not save a EvalMultKeys vector as there is a key vector for the given keyTag");
     }
-
-    CryptoContextImpl<Element>::s_evalMultKeyMap[tag] = vectorToInsert;
 }
 
 /////////////////////////////////////////
@@ -141,7 +157,7 @@ void CryptoContextImpl<Element>::EvalSumKeyGen(const PrivateKey<Element> private
     }
 
     auto evalKeys = GetScheme()->EvalSumKeyGen(privateKey, publicKey);
-    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, privateKey->GetKeyTag());
 }
 
 template <typename Element>
@@ -154,9 +170,10 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::E
 
     std::vector<usint> indices;
     auto evalKeys = GetScheme()->EvalSumRowsKeyGen(privateKey, rowSize, subringDim, indices);
-    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, privateKey->GetKeyTag());
 
-    return CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(privateKey->GetKeyTag(), indices);
+    return CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(GetKeyStore(), privateKey->GetKeyTag(),
+                                                                           indices);
 }
 
 template <typename Element>
@@ -169,55 +186,46 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::E
 
     std::vector<usint> indices;
     auto evalKeys = GetScheme()->EvalSumColsKeyGen(privateKey, indices);
-    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, privateKey->GetKeyTag());
 
-    return CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(privateKey->GetKeyTag(), indices);
+    return CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(GetKeyStore(), privateKey->GetKeyTag(),
+                                                                           indices);
 }
 
 template <typename Element>
-const std::map<usint, EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalSumKeyMap(const std::string& keyID) {
+std::map<usint, EvalKey<Element>> CryptoContextImpl<Element>::GetEvalSumKeyMap(const std::string& keyID) {
     return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(keyID);
 }
 
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>>& CryptoContextImpl<Element>::GetAllEvalMultKeys() {
-    return CryptoContextImpl<Element>::s_evalMultKeyMap;
+std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetAllEvalMultKeys() {
+    return *s_keyStore.GetEvalMultKeys();
 }
 
 template <typename Element>
-const std::vector<EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalMultKeyVector(const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalMultKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
-        std::string errMsg(std::string("Call EvalMultKeyGen() to have EvalMultKey available for ID [") + keyID + "].");
-        OPENFHE_THROW(errMsg);
-    }
-    return ekv->second;
+std::vector<EvalKey<Element>> CryptoContextImpl<Element>::GetEvalMultKeyVector(const std::string& keyID) {
+    return s_keyStore.GetEvalMultKeyVector(keyID);
 }
 
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
+std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys() {
-    return CryptoContextImpl<Element>::s_evalAutomorphismKeyMap;
+    return *s_keyStore.GetEvalAutomorphismKeys();
 }
 
 template <typename Element>
 std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
     const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end()) {
-        OPENFHE_THROW("EvalAutomorphismKeys are not generated for ID [" + keyID + "].");
-    }
-    return ekv->second;
+    return s_keyStore.GetEvalAutomorphismKeyMapPtr(keyID);
 }
 
 template <typename Element>
 std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetPartialEvalAutomorphismKeyMapPtr(
-    const std::string& keyID, const std::vector<uint32_t>& indexList) {
+    const KeyStore<Element>& store, const std::string& keyID, const std::vector<uint32_t>& indexList) {
     if (!indexList.size())
         OPENFHE_THROW("indexList is empty");
 
-    std::shared_ptr<std::map<usint, EvalKey<Element>>> keyMap =
-        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
+    std::shared_ptr<std::map<usint, EvalKey<Element>>> keyMap = store.GetEvalAutomorphismKeyMapPtr(keyID);
 
     // create a return map if specific indices are provided
     std::map<usint, EvalKey<Element>> retMap;
@@ -232,7 +240,7 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::G
 }
 
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
+std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalSumKeys() {
     return CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
 }
@@ -274,12 +282,14 @@ void CryptoContextImpl<Element>::EvalAtIndexKeyGen(const PrivateKey<Element> pri
     }
 
     auto evalKeys = GetScheme()->EvalAtIndexKeyGen(publicKey, privateKey, indexList);
-    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(GetKeyStore(), evalKeys, privateKey->GetKeyTag());
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.clear();
+    s_keyStore.EraseEvalAutomorphismKeysIf([](const std::string&, const auto&) {
+        return true;
+    });
 }
 
 /**
@@ -288,9 +298,9 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(kd);
+    s_keyStore.EraseEvalAutomorphismKeysIf([&id](const std::string& tag, const auto&) {
+        return tag == id;
+    });
 }
 
 /**
@@ -300,28 +310,21 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end();) {
-        if (it->second->begin()->second->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    GetKeyStoreOf(cc).EraseEvalAutomorphismKeysIf([&cc](const std::string&, const auto& keys) {
+        return keys->begin()->second->GetCryptoContext() == cc;
+    });
 }
 
 template <typename Element>
 std::set<uint32_t> CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(const std::string& keyTag) {
-    auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyTag);
-    if (keyMapIt == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
+    const auto keyMap = s_keyStore.FindEvalAutomorphismKeys(keyTag);
+    if (!keyMap)
         // there is no keys for the given id, return empty vector
         return std::set<uint32_t>();
 
     // get all inidices from the existing automorphism key map
-    auto& keyMap = *(keyMapIt->second);
     std::set<uint32_t> indices;
-    for (const auto& [key, _] : keyMap) {
+    for (const auto& [key, _] : *keyMap) {
         indices.insert(key);
     }
 
@@ -345,38 +348,36 @@ void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
     if (mapToInsert->empty()) {
         return;
     }
+    // the keys go to the store of the context they were generated with
+    auto& store = GetKeyStoreOf(mapToInsert->begin()->second->GetCryptoContext());
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(store, mapToInsert, keyTag);
+}
 
-    auto mapToInsertIt   = mapToInsert->begin();
-    const std::string id = (keyTag.empty()) ? mapToInsertIt->second->GetKeyTag() : keyTag;
-    std::set<uint32_t> existingIndices{CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(id)};
-    if (existingIndices.empty()) {
-        // there is no keys for the given id, so we insert full mapToInsert
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap[id] = mapToInsert;
+template <typename Element>
+void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
+    KeyStore<Element>& store, const std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> mapToInsert,
+    const std::string& keyTag) {
+    // check if the map is empty
+    if (mapToInsert->empty()) {
+        return;
     }
-    else {
-        // get all indices from mapToInsert
-        std::set<uint32_t> newIndices;
-        for (const auto& [key, _] : *mapToInsert) {
-            newIndices.insert(key);
-        }
 
-        // find all indices in mapToInsert that are not in the exising map and
-        // insert those new indices and their corresponding keys to the existing map
-        std::set<uint32_t> indicesToInsert{CryptoContextImpl<Element>::GetUniqueValues(existingIndices, newIndices)};
-        auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-        auto& keyMap  = *(keyMapIt->second);
-        for (uint32_t indx : indicesToInsert) {
-            keyMap[indx] = (*mapToInsert)[indx];
-        }
+    if (OpenFHEParallelControls.GetNumaMode()) {
+        for (const auto& [_, key] : *mapToInsert)
+            NumaInterleaveEvalKey(key);
     }
+
+    // keys for indices that already have a key are not inserted
+    const std::string id = (keyTag.empty()) ? mapToInsert->begin()->second->GetKeyTag() : keyTag;
+    store.InsertEvalAutomorphismKeys(id, mapToInsert, false);
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(ConstCiphertext<Element> ciphertext, usint batchSize) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    return GetScheme()->EvalSum(ciphertext, batchSize, evalSumKeys);
+    const auto evalSumKeys = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    return GetScheme()->EvalSum(ciphertext, batchSize, *evalSumKeys);
 }
 
 template <typename Element>
@@ -394,12 +395,13 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumCols(
     const std::map<usint, EvalKey<Element>>& evalSumKeysRight) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    return GetScheme()->EvalSumCols(ciphertext, numCols, evalSumKeys, evalSumKeysRight);
+    const auto evalSumKeys = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    return GetScheme()->EvalSumCols(ciphertext, numCols, *evalSumKeys, evalSumKeysRight);
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(ConstCiphertext<Element> ciphertext, int32_t index) const {
+    OPENFHE_MEMSTATS_SCOPE();
     ValidateCiphertext(ciphertext);
 
     // If the index is zero, no rotation is needed, copy the ciphertext and return
@@ -408,8 +410,55 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(ConstCiphertext<Elem
         return ciphertext->Clone();
     }
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    return GetScheme()->EvalAtIndex(ciphertext, index, evalAutomorphismKeys);
+    const auto evalAutomorphismKeys = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    return GetScheme()->EvalAtIndex(ciphertext, index, *evalAutomorphismKeys);
+}
+
+template <typename Element>
+std::vector<Ciphertext<Element>> CryptoContextImpl<Element>::EvalRotateMany(ConstCiphertext<Element> ciphertext,
+                                                                            const std::vector<int32_t>& indices) const {
+    OPENFHE_MEMSTATS_SCOPE();
+    ValidateCiphertext(ciphertext);
+
+    std::vector<Ciphertext<Element>> result;
+    result.reserve(indices.size());
+    if (indices.empty())
+        return result;
+
+    auto algo   = GetScheme();
+    auto digits = algo->EvalFastRotationPrecompute(ciphertext);
+    uint32_t m  = GetCryptoParameters()->GetElementParams()->GetCyclotomicOrder();
+    for (const int32_t index : indices) {
+        result.emplace_back(algo->EvalFastRotation(ciphertext, static_cast<usint>(index), m, digits));
+    }
+    return result;
+}
+
+template <typename Element>
+std::vector<Ciphertext<Element>> CryptoContextImpl<Element>::EvalRotateManyExt(ConstCiphertext<Element> ciphertext,
+                                                                               const std::vector<int32_t>& indices,
+                                                                               bool addFirst) const {
+    OPENFHE_MEMSTATS_SCOPE();
+    ValidateCiphertext(ciphertext);
+
+    std::vector<Ciphertext<Element>> result;
+    result.reserve(indices.size());
+    if (indices.empty())
+        return result;
+
+    auto algo = GetScheme();
+    // the key map is looked up once and shared by all rotations instead of being copied per index
+    const auto evalKeyMap = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    auto digits           = algo->EvalFastRotationPrecompute(ciphertext);
+    for (const int32_t index : indices) {
+        // a zero rotation has no key; it only needs to be lifted to the extended basis
+        if (index == 0)
+            result.emplace_back(algo->KeySwitchExt(ciphertext, addFirst));
+        else
+            result.emplace_back(
+                algo->EvalFastRotationExt(ciphertext, static_cast<usint>(index), digits, addFirst, *evalKeyMap));
+    }
+    return result;
 }
 
 template <typename Element>
@@ -417,8 +466,8 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
     const std::vector<Ciphertext<Element>>& ciphertextVector) const {
     ValidateCiphertext(ciphertextVector[0]);
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertextVector[0]->GetKeyTag());
-    return GetScheme()->EvalMerge(ciphertextVector, evalAutomorphismKeys);
+    const auto evalAutomorphismKeys = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertextVector[0]->GetKeyTag());
+    return GetScheme()->EvalMerge(ciphertextVector, *evalAutomorphismKeys);
 }
 
 template <typename Element>
@@ -428,9 +477,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
     if (ct2 == nullptr || ct1->GetKeyTag() != ct2->GetKeyTag())
         OPENFHE_THROW("Information was not generated with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
-    auto ek          = CryptoContextImpl<Element>::GetEvalMultKeyVector(ct1->GetKeyTag());
-    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys, ek[0]);
+    const auto evalSumKeys = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ct1->GetKeyTag());
+    auto ek                = GetKeyStore().GetEvalMultKeyVector(ct1->GetKeyTag());
+    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys, ek[0]);
 }
 
 template <typename Element>
@@ -440,8 +489,8 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
     if (ct2 == nullptr)
         OPENFHE_THROW("Information was not generated with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
-    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys);
+    const auto evalSumKeys = GetKeyStore().GetEvalAutomorphismKeyMapPtr(ct1->GetKeyTag());
+    return GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys);
 }
 
 template <typename Element>
@@ -458,6 +507,7 @@ Plaintext CryptoContextImpl<Element>::GetPlaintextForDecrypt(PlaintextEncodings
 template <typename Element>
 DecryptResult CryptoContextImpl<Element>::Decrypt(ConstCiphertext<Element> ciphertext,
                                                   const PrivateKey<Element> privateKey, Plaintext* plaintext) {
+    OPENFHE_MEMSTATS_SCOPE();
     if (ciphertext == nullptr)
         OPENFHE_THROW("ciphertext is empty");
     if (plaintext == nullptr)
@@ -563,6 +613,7 @@ Plaintext CryptoContextImpl<DCRTPoly>::GetPlaintextForDecrypt(PlaintextEncodings
 template <>
 DecryptResult CryptoContextImpl<DCRTPoly>::Decrypt(ConstCiphertext<DCRTPoly> ciphertext,
                                                    const PrivateKey<DCRTPoly> privateKey, Plaintext* plaintext) {
+    OPENFHE_MEMSTATS_SCOPE();
     if (ciphertext == nullptr)
         OPENFHE_THROW("ciphertext is empty");
     if (plaintext == nullptr)
@@ -874,6 +925,54 @@ void CryptoContextImpl<DCRTPoly>::RecoverSharedKey(PrivateKey<DCRTPoly>& sk,
     }
 }
 
+template <>
+void CryptoContextImpl<DCRTPoly>::WriteEvalAutomorphismKeyStore(const std::string& path,
+                                                                const std::string& keyID) const {
+    EvalKeyStore::Write(path, keyID, *GetKeyStore().GetEvalAutomorphismKeyMapPtr(keyID));
+}
+
+template <>
+void CryptoContextImpl<DCRTPoly>::LoadEvalAutomorphismKeyStore(const std::string& path, uint32_t maxResidentKeys,
+                                                               const std::vector<uint32_t>& indices) {
+    auto store = EvalKeyStore::Open(path, maxResidentKeys);
+    auto keys  = store->GetKeyMap(GetContextForPointer(this), indices);
+    // the keys of the store replace the keys held in memory, which would otherwise be kept by a merge
+    GetKeyStore().InsertEvalAutomorphismKeys(store->GetKeyTag(), keys, true);
+}
+
+template <>
+void CryptoContextImpl<DCRTPoly>::ReadEvalAutomorphismKeyStore(const std::string& path,
+                                                               const std::vector<uint32_t>& indices) {
+    auto store = EvalKeyStore::Open(path);
+    CryptoContextImpl<DCRTPoly>::InsertEvalAutomorphismKey(GetKeyStore(), store->ReadKeys(indices), store->GetKeyTag());
+}
+
+template <>
+void CryptoContextImpl<DCRTPoly>::EvalRotateKeyGen(const PrivateKey<DCRTPoly> privateKey,
+                                                   const std::vector<int32_t>& indexList, EvalKeyStoreWriter& writer,
+                                                   uint32_t batchSize) const {
+    ValidateKey(privateKey);
+    if (batchSize == 0)
+        batchSize = std::max(OpenFHEParallelControls.GetThreadLimit(static_cast<int>(indexList.size())), 1);
+
+    // several rotation indices can map to the same automorphism index, whose key is written only once
+    std::set<uint32_t> written;
+    for (const auto& entry : writer.GetEntries())
+        written.insert(entry.index);
+    std::vector<uint32_t> pending;
+    for (int32_t index : indexList) {
+        const uint32_t autoIndex = FindAutomorphismIndex(index);
+        if (written.insert(autoIndex).second)
+            pending.push_back(autoIndex);
+    }
+
+    for (size_t begin = 0; begin < pending.size(); begin += batchSize) {
+        const size_t end = std::min(pending.size(), begin + batchSize);
+        std::vector<uint32_t> batch(pending.begin() + begin, pending.begin() + end);
+        writer.Append(*GetScheme()->EvalAutomorphismKeyGen(privateKey, batch));
+    }
+}
+
 template class CryptoContextImpl<DCRTPoly>;
 
 }  // namespace lbcrypto
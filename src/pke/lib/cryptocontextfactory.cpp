@@ -33,6 +33,8 @@
 #include "schemebase/base-scheme.h"
 #include "scheme/scheme-id.h"
 
+#include <mutex>
+
 namespace lbcrypto {
 
 template <>
@@ -66,6 +68,10 @@ template <typename Element>
 CryptoContext<Element> CryptoContextFactory<Element>::GetContext(std::shared_ptr<CryptoParametersBase<Element>> params,
                                                                  std::shared_ptr<SchemeBase<Element>> scheme,
                                                                  SCHEME schemeId) {
+    // contexts are also looked up by objects deserialized in parallel, e.g. the keys of a key store
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> lock(mtx);
+
     CryptoContext<Element> cc = FindContext(params, scheme);
     // if the context is not found we should create one
     if (nullptr == cc) {
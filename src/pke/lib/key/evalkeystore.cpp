@@ -0,0 +1,375 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Memory-mapped store of automorphism keys that are loaded on first use
+ */
+
+#include "key/evalkeystore.h"
+
+#include "cryptocontext-ser.h"
+#include "key/key-ser.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <sstream>
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char STORE_MAGIC[8] = {'O', 'F', 'H', 'E', 'K', 'S', 'T', '1'};
+// size of an index table entry: index, offset and size
+constexpr size_t ENTRY_BYTES = sizeof(uint32_t) + 2 * sizeof(uint64_t);
+// size of the footer: index table offset, number of keys and magic
+constexpr size_t FOOTER_BYTES = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(STORE_MAGIC);
+
+template <typename T>
+void WriteValue(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T ReadValue(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+EvalKeyStoreWriter::EvalKeyStoreWriter(const std::string& path, const std::string& keyTag)
+    : m_path(path), m_out(path, std::ios::out | std::ios::binary | std::ios::trunc) {
+    if (!m_out.is_open())
+        OPENFHE_THROW("Cannot create key store file " + path);
+    m_out.write(STORE_MAGIC, sizeof(STORE_MAGIC));
+    WriteValue<uint32_t>(m_out, EvalKeyStore::VERSION);
+    WriteValue<uint32_t>(m_out, static_cast<uint32_t>(keyTag.size()));
+    m_out.write(keyTag.data(), keyTag.size());
+}
+
+EvalKeyStoreWriter::~EvalKeyStoreWriter() {
+    if (!m_closed) {
+        try {
+            Close();
+        }
+        catch (...) {
+        }
+    }
+}
+
+void EvalKeyStoreWriter::Append(uint32_t index, const EvalKey<DCRTPoly>& key) {
+    if (m_closed)
+        OPENFHE_THROW("Key store file " + m_path + " is already closed");
+    if (!key)
+        OPENFHE_THROW("Key for index [" + std::to_string(index) + "] is nullptr");
+
+    const uint64_t offset = StartRecord();
+    // a lazily loaded key is written from its loaded data, the proxy itself is not serializable
+    EvalKey<DCRTPoly> resident = key->LoadResident();
+    Serial::Serialize(resident ? resident : key, m_out, SerType::BINARY);
+    if (!m_out.good())
+        OPENFHE_THROW("Error writing key store file " + m_path);
+
+    m_entries.push_back({index, offset, static_cast<uint64_t>(m_out.tellp()) - offset});
+}
+
+void EvalKeyStoreWriter::Append(const std::map<uint32_t, EvalKey<DCRTPoly>>& keys) {
+    if (m_closed)
+        OPENFHE_THROW("Key store file " + m_path + " is already closed");
+
+    std::vector<std::pair<uint32_t, EvalKey<DCRTPoly>>> items(keys.begin(), keys.end());
+    for (const auto& [index, key] : items) {
+        if (!key)
+            OPENFHE_THROW("Key for index [" + std::to_string(index) + "] is nullptr");
+    }
+
+    // the keys are serialized to memory in parallel and written to the file in order, in batches of about one key
+    // per thread so that only a batch of serialized keys is held in memory at a time
+    const size_t batchSize = std::max<size_t>(1, OpenFHEParallelControls.GetNumThreads());
+    std::vector<std::string> records(std::min(batchSize, items.size()));
+    std::vector<std::exception_ptr> errors(records.size());
+    for (size_t first = 0; first < items.size(); first += batchSize) {
+        const size_t count = std::min(batchSize, items.size() - first);
+        OpenFHEParallelControls.ParallelFor(0, count, [&](size_t i) {
+            try {
+                const auto& key            = items[first + i].second;
+                EvalKey<DCRTPoly> resident = key->LoadResident();
+                std::ostringstream record;
+                Serial::Serialize(resident ? resident : key, record, SerType::BINARY);
+                records[i] = record.str();
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+        for (size_t i = 0; i < count; ++i) {
+            if (errors[i])
+                std::rethrow_exception(errors[i]);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t offset = StartRecord();
+            m_out.write(records[i].data(), records[i].size());
+            if (!m_out.good())
+                OPENFHE_THROW("Error writing key store file " + m_path);
+            m_entries.push_back({items[first + i].first, offset, records[i].size()});
+            // release the serialized key as soon as it is written
+            std::string().swap(records[i]);
+        }
+    }
+}
+
+uint64_t EvalKeyStoreWriter::StartRecord() {
+    // every record starts on a page boundary so that it can be released from memory on its own
+    uint64_t offset = static_cast<uint64_t>(m_out.tellp());
+    if (offset % EvalKeyStore::ALIGNMENT != 0) {
+        const uint64_t padding = EvalKeyStore::ALIGNMENT - offset % EvalKeyStore::ALIGNMENT;
+        const std::vector<char> zeros(padding, 0);
+        m_out.write(zeros.data(), zeros.size());
+        offset += padding;
+    }
+    return offset;
+}
+
+void EvalKeyStoreWriter::Close() {
+    if (m_closed)
+        return;
+    m_closed = true;
+
+    const uint64_t indexOffset = static_cast<uint64_t>(m_out.tellp());
+    for (const auto& entry : m_entries) {
+        WriteValue<uint32_t>(m_out, entry.index);
+        WriteValue<uint64_t>(m_out, entry.offset);
+        WriteValue<uint64_t>(m_out, entry.size);
+    }
+    WriteValue<uint64_t>(m_out, indexOffset);
+    WriteValue<uint32_t>(m_out, static_cast<uint32_t>(m_entries.size()));
+    m_out.write(STORE_MAGIC, sizeof(STORE_MAGIC));
+    m_out.close();
+    if (m_out.fail())
+        OPENFHE_THROW("Error writing key store file " + m_path);
+}
+
+EvalKeyStoreProxy::EvalKeyStoreProxy(const CryptoContext<DCRTPoly>& cc, std::shared_ptr<EvalKeyStore> store,
+                                     const EvalKeyStoreEntry& entry)
+    : EvalKeyImpl<DCRTPoly>(cc), m_store(std::move(store)), m_entry(entry) {
+    SetKeyTag(m_store->GetKeyTag());
+}
+
+EvalKeyStoreProxy::~EvalKeyStoreProxy() {
+    m_store->Evict(*this);
+}
+
+EvalKey<DCRTPoly> EvalKeyStoreProxy::LoadResident() const {
+    return m_store->Load(*this);
+}
+
+void EvalKeyStoreProxy::Prefetch() const {
+    if (!IsResident())
+        m_store->m_file.WillNeed(m_entry.offset, m_entry.size);
+}
+
+void EvalKeyStoreProxy::ClearKeys() {
+    m_store->Evict(*this);
+}
+
+size_t EvalKeyStoreProxy::GetByteSize() const {
+    std::lock_guard<std::mutex> lock(m_store->m_mutex);
+    return m_resident ? m_resident->GetByteSize() : 0;
+}
+
+bool EvalKeyStoreProxy::IsResident() const {
+    std::lock_guard<std::mutex> lock(m_store->m_mutex);
+    return m_resident != nullptr;
+}
+
+EvalKeyStore::EvalKeyStore(const std::string& path, uint32_t maxResidentKeys)
+    : m_file(path), m_maxResidentKeys(maxResidentKeys) {
+    const char* data  = m_file.GetData();
+    const size_t size = m_file.GetSize();
+    const size_t headerBytes{sizeof(STORE_MAGIC) + 2 * sizeof(uint32_t)};
+    if (size < headerBytes + FOOTER_BYTES || std::memcmp(data, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 ||
+        std::memcmp(data + size - sizeof(STORE_MAGIC), STORE_MAGIC, sizeof(STORE_MAGIC)) != 0)
+        OPENFHE_THROW(path + " is not a key store file");
+
+    const uint32_t version = ReadValue<uint32_t>(data + sizeof(STORE_MAGIC));
+    if (version > VERSION)
+        OPENFHE_THROW("Key store file " + path + " is from a later version of the library");
+    const uint32_t tagSize = ReadValue<uint32_t>(data + sizeof(STORE_MAGIC) + sizeof(uint32_t));
+    if (headerBytes + tagSize > size - FOOTER_BYTES)
+        OPENFHE_THROW("Key store file " + path + " is corrupted");
+    m_keyTag.assign(data + headerBytes, tagSize);
+
+    const char* footer         = data + size - FOOTER_BYTES;
+    const uint64_t indexOffset = ReadValue<uint64_t>(footer);
+    const uint32_t numKeys     = ReadValue<uint32_t>(footer + sizeof(uint64_t));
+    if (indexOffset > size - FOOTER_BYTES || (size - FOOTER_BYTES - indexOffset) / ENTRY_BYTES != numKeys)
+        OPENFHE_THROW("Key store file " + path + " is corrupted");
+
+    m_entries.resize(numKeys);
+    for (uint32_t i = 0; i < numKeys; ++i) {
+        const char* p       = data + indexOffset + i * ENTRY_BYTES;
+        m_entries[i].index  = ReadValue<uint32_t>(p);
+        m_entries[i].offset = ReadValue<uint64_t>(p + sizeof(uint32_t));
+        m_entries[i].size   = ReadValue<uint64_t>(p + sizeof(uint32_t) + sizeof(uint64_t));
+        if (m_entries[i].offset > indexOffset || m_entries[i].size > indexOffset - m_entries[i].offset)
+            OPENFHE_THROW("Key store file " + path + " is corrupted");
+    }
+}
+
+std::shared_ptr<EvalKeyStore> EvalKeyStore::Open(const std::string& path, uint32_t maxResidentKeys) {
+    return std::shared_ptr<EvalKeyStore>(new EvalKeyStore(path, maxResidentKeys));
+}
+
+void EvalKeyStore::Write(const std::string& path, const std::string& keyTag,
+                         const std::map<uint32_t, EvalKey<DCRTPoly>>& keys) {
+    EvalKeyStoreWriter writer(path, keyTag);
+    writer.Append(keys);
+    writer.Close();
+}
+
+uint32_t EvalKeyStore::GetNumResidentKeys() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_lru.size());
+}
+
+std::shared_ptr<std::map<uint32_t, EvalKey<DCRTPoly>>> EvalKeyStore::GetKeyMap(const CryptoContext<DCRTPoly>& cc,
+                                                                               const std::vector<uint32_t>& indices) {
+    auto keys = std::make_shared<std::map<uint32_t, EvalKey<DCRTPoly>>>();
+    for (const auto& entry : SelectEntries(indices))
+        (*keys)[entry.index] = std::make_shared<EvalKeyStoreProxy>(cc, shared_from_this(), entry);
+    return keys;
+}
+
+std::shared_ptr<std::map<uint32_t, EvalKey<DCRTPoly>>> EvalKeyStore::ReadKeys(
+    const std::vector<uint32_t>& indices) const {
+    const std::vector<EvalKeyStoreEntry> entries = SelectEntries(indices);
+    std::vector<EvalKey<DCRTPoly>> loaded(entries.size());
+    std::vector<std::exception_ptr> errors(entries.size());
+    OpenFHEParallelControls.ParallelFor(0, entries.size(), [&](size_t i) {
+        try {
+            loaded[i] = ReadKey(entries[i]);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for (const auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    auto keys = std::make_shared<std::map<uint32_t, EvalKey<DCRTPoly>>>();
+    for (size_t i = 0; i < entries.size(); ++i)
+        (*keys)[entries[i].index] = std::move(loaded[i]);
+    return keys;
+}
+
+std::vector<EvalKeyStoreEntry> EvalKeyStore::SelectEntries(const std::vector<uint32_t>& indices) const {
+    if (indices.empty())
+        return m_entries;
+
+    std::map<uint32_t, const EvalKeyStoreEntry*> byIndex;
+    for (const auto& entry : m_entries)
+        byIndex[entry.index] = &entry;
+
+    std::vector<EvalKeyStoreEntry> selected;
+    selected.reserve(indices.size());
+    for (uint32_t index : indices) {
+        auto it = byIndex.find(index);
+        if (it == byIndex.end())
+            OPENFHE_THROW("Key store file " + m_file.GetPath() + " has no key for index [" + std::to_string(index) +
+                          "]");
+        selected.push_back(*it->second);
+    }
+    return selected;
+}
+
+EvalKey<DCRTPoly> EvalKeyStore::ReadKey(const EvalKeyStoreEntry& entry) const {
+    MemoryStreamBuf buf(m_file.GetData() + entry.offset, entry.size);
+    std::istream stream(&buf);
+    EvalKey<DCRTPoly> key;
+    Serial::Deserialize(key, stream, SerType::BINARY);
+    if (!key)
+        OPENFHE_THROW("Cannot deserialize the key for index [" + std::to_string(entry.index) + "] from " +
+                      m_file.GetPath());
+    return key;
+}
+
+EvalKey<DCRTPoly> EvalKeyStore::Load(const EvalKeyStoreProxy& proxy) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (proxy.m_resident) {
+            m_lru.splice(m_lru.begin(), m_lru, proxy.m_lruPos);
+            return proxy.m_resident;
+        }
+    }
+
+    // the key is deserialized without holding the store mutex, so that different keys load in parallel
+    std::lock_guard<std::mutex> loadLock(proxy.m_loadMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (proxy.m_resident) {
+            m_lru.splice(m_lru.begin(), m_lru, proxy.m_lruPos);
+            return proxy.m_resident;
+        }
+    }
+    EvalKey<DCRTPoly> key = ReadKey(proxy.m_entry);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    proxy.m_resident = key;
+    m_lru.push_front(&proxy);
+    proxy.m_lruPos = m_lru.begin();
+    while (m_maxResidentKeys > 0 && m_lru.size() > m_maxResidentKeys) {
+        const EvalKeyStoreProxy* victim = m_lru.back();
+        m_lru.pop_back();
+        // callers that still use the victim hold their own reference to it
+        victim->m_resident.reset();
+        m_file.DontNeed(victim->m_entry.offset, victim->m_entry.size);
+    }
+    return key;
+}
+
+void EvalKeyStore::Evict(const EvalKeyStoreProxy& proxy) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (proxy.m_resident) {
+        m_lru.erase(proxy.m_lruPos);
+        proxy.m_resident.reset();
+        m_file.DontNeed(proxy.m_entry.offset, proxy.m_entry.size);
+    }
+}
+
+}  // namespace lbcrypto
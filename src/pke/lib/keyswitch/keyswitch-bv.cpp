@@ -86,6 +86,17 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
     std::vector<DCRTPoly> av(nWindows);
     std::vector<DCRTPoly> bv(nWindows);
 
+    // a seeded key stores only the seed the a's are expanded from
+    std::vector<uint32_t> seed;
+    if (cryptoParams->GetSeededEvalKeys()) {
+        const auto s = SeededUniformGenerator::GenerateSeed();
+        seed.assign(s.begin(), s.end());
+    }
+    auto sampleA = [&](usint digit) {
+        return seed.empty() ? DCRTPoly(dug, elementParams, Format::EVALUATION) :
+                              EvalKeyRelinImpl<DCRTPoly>::ExpandSeededA(seed, digit, elementParams);
+    };
+
     if (digitSize > 0) {
         for (usint i = 0; i < sOld.GetNumOfElements(); i++) {
             std::vector<DCRTPoly::PolyType> sOldDecomposed = sOld.GetElementAtIndex(i).PowersOfBase(digitSize);
@@ -94,7 +105,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
                 DCRTPoly filtered(elementParams, Format::EVALUATION, true);
                 filtered.SetElementAtIndex(i, sOldDecomposed[k]);
 
-                DCRTPoly a(dug, elementParams, Format::EVALUATION);
+                DCRTPoly a(sampleA(k + arrWindows[i]));
                 DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
                 av[k + arrWindows[i]] = std::move(a);
@@ -107,7 +118,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
             DCRTPoly filtered(elementParams, Format::EVALUATION, true);
             filtered.SetElementAtIndex(i, sOld.GetElementAtIndex(i));
 
-            DCRTPoly a(dug, elementParams, Format::EVALUATION);
+            DCRTPoly a(sampleA(i));
             DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
             av[i] = std::move(a);
@@ -115,7 +126,10 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
         }
     }
 
-    ek->SetAVector(std::move(av));
+    if (seed.empty())
+        ek->SetAVector(std::move(av));
+    else
+        ek->SetSeed(seed);
     ek->SetBVector(std::move(bv));
     ek->SetKeyTag(newKey->GetKeyTag());
 
@@ -313,16 +327,30 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalKeySwitchPrecomputeCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    // a key loaded from a key store is pinned in memory while it is used
+    if (auto resident = evalKey->LoadResident())
+        return EvalFastKeySwitchCore(digits, resident, paramsQl);
+
     std::vector<DCRTPoly> bv(evalKey->GetBVector());
-    std::vector<DCRTPoly> av(evalKey->GetAVector());
 
     auto sizeQ    = bv[0].GetParams()->GetParams().size();
     auto sizeQl   = paramsQl->GetParams().size();
     size_t diffQl = sizeQ - sizeQl;
 
-    for (size_t k = 0; k < bv.size(); k++) {
-        av[k].DropLastElements(diffQl);
+    for (size_t k = 0; k < bv.size(); k++)
         bv[k].DropLastElements(diffQl);
+
+    // the a's of a seeded key are expanded from the seed directly at the current level, only for the digits used
+    std::vector<DCRTPoly> av;
+    if (evalKey->IsSeeded()) {
+        av.reserve(digits->size());
+        for (size_t k = 0; k < digits->size(); k++)
+            av.push_back(EvalKeyRelinImpl<DCRTPoly>::ExpandSeededA(evalKey->GetSeed(), k, bv[k].GetParams()));
+    }
+    else {
+        av = evalKey->GetAVector();
+        for (size_t k = 0; k < av.size(); k++)
+            av[k].DropLastElements(diffQl);
     }
 
     DCRTPoly ct1 = (av[0] *= (*digits)[0]);
@@ -43,8 +43,51 @@
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
 
+#include "utils/utilities-int.h"
+
+#include <algorithm>
+#include <vector>
+
 namespace lbcrypto {
 
+namespace {  // this namespace should stay unnamed
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+/**
+ * Computes one tower of both key-switching inner products, out0 = sum_j c[j] * b[j] and out1 = sum_j c[j] * a[j]
+ * mod q, where c, b and a hold one coefficient array per digit. The products of all digits are summed in 128-bit
+ * accumulators and reduced once per coefficient, so the loop allocates nothing and does no modular reduction
+ * per product.
+ */
+void KeySwitchInnerProductTower(const uint64_t* const* c, const uint64_t* const* b, const uint64_t* const* a,
+                                size_t dnum, size_t n, uint64_t q, uint64_t* out0, uint64_t* out1) {
+    // q < 2^msb, so 2^(128 - 2 msb) - 1 products can be added to a value below q without overflow
+    const uint32_t msb{GetMSB(q)};
+    const size_t maxLazy{(2 * msb >= 128) ? 1 : (size_t(1) << std::min<uint32_t>(128 - 2 * msb, 31)) - 1};
+    const DoubleNativeInt mu{~DoubleNativeInt(0) / q};
+
+    for (size_t k = 0; k < n; ++k) {
+        DoubleNativeInt acc0{0}, acc1{0};
+        for (size_t j0 = 0, j1; j0 < dnum; j0 = j1) {
+            j1 = std::min(dnum, j0 + maxLazy);
+            if (j0 != 0) {
+                acc0 = BarrettUint128ModUint64(acc0, q, mu);
+                acc1 = BarrettUint128ModUint64(acc1, q, mu);
+            }
+            for (size_t j = j0; j < j1; ++j) {
+                const uint64_t cj{c[j][k]};
+                acc0 += Mul128(cj, b[j][k]);
+                acc1 += Mul128(cj, a[j][k]);
+            }
+        }
+        out0[k] = BarrettUint128ModUint64(acc0, q, mu);
+        out1[k] = BarrettUint128ModUint64(acc1, q, mu);
+    }
+}
+#endif
+
+}  // namespace
+
 EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldKey,
                                                         const PrivateKey<DCRTPoly> newKey) const {
     return KeySwitchHYBRID::KeySwitchGenInternal(oldKey, newKey, nullptr);
@@ -99,9 +142,21 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
+    // a seeded key stores only the seed of the a's (not supported in threshold HE, where a comes from ekPrev)
+    std::vector<uint32_t> seed;
+    if (ekPrev == nullptr && cryptoParams->GetSeededEvalKeys()) {
+        const auto s = SeededUniformGenerator::GenerateSeed();
+        seed.assign(s.begin(), s.end());
+    }
+
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+        DCRTPoly a;
+        if (ekPrev != nullptr)
+            a = ekPrev->GetAVector()[part];  // threshold HE
+        else if (seed.empty())
+            a = DCRTPoly(dug, paramsQP, Format::EVALUATION);  // single-key HE
+        else
+            a = EvalKeyRelinImpl<DCRTPoly>::ExpandSeededA(seed, part, paramsQP);  // single-key HE, seeded key
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -124,11 +179,15 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
             }
         }
 
-        av[part] = a;
-        bv[part] = b;
+        if (seed.empty())
+            av[part] = std::move(a);
+        bv[part] = std::move(b);
     }
 
-    ek->SetAVector(std::move(av));
+    if (seed.empty())
+        ek->SetAVector(std::move(av));
+    else
+        ek->SetSeed(seed);
     ek->SetBVector(std::move(bv));
     ek->SetKeyTag(newKey->GetKeyTag());
     return ek;
@@ -277,14 +336,16 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ci
     DCRTPoly ct0 = cTilda[0].ApproxModDown(paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
                                            cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
                                            cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
-                                           cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
-                                           cryptoParams->GettInvModpPrecon(), t, cryptoParams->GettModqPrecon());
+                                           cryptoParams->GetPHatModqTransposed(), cryptoParams->GetModqBarrettMu(),
+                                           cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+                                           cryptoParams->GettModqPrecon());
 
     DCRTPoly ct1 = cTilda[1].ApproxModDown(paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
                                            cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
                                            cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
-                                           cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
-                                           cryptoParams->GettInvModpPrecon(), t, cryptoParams->GettModqPrecon());
+                                           cryptoParams->GetPHatModqTransposed(), cryptoParams->GetModqBarrettMu(),
+                                           cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+                                           cryptoParams->GettModqPrecon());
 
     Ciphertext<DCRTPoly> result = ciphertext->CloneZero();
     result->SetElements(std::vector<DCRTPoly>{std::move(ct0), std::move(ct1)});
@@ -314,8 +375,9 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
     DCRTPoly cv0 = cTilda[0].ApproxModDown(paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
                                            cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
                                            cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
-                                           cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
-                                           cryptoParams->GettInvModpPrecon(), t, cryptoParams->GettModqPrecon());
+                                           cryptoParams->GetPHatModqTransposed(), cryptoParams->GetModqBarrettMu(),
+                                           cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+                                           cryptoParams->GettModqPrecon());
 
     return cv0;
 }
@@ -344,68 +406,41 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     if (numPartQl > cryptoParams->GetNumberOfQPartitions())
         numPartQl = cryptoParams->GetNumberOfQPartitions();
 
-    std::vector<DCRTPoly> partsCt(numPartQl);
+    std::vector<DCRTPoly> partsCtExt(numPartQl);
 
     // Digit decomposition
-    // Zero-padding and split
+    // The digits are slices of the towers of c: each one is copied once for the basis switch, while its
+    // evaluation representation is read straight from c
     for (uint32_t part = 0; part < numPartQl; part++) {
-        if (part == numPartQl - 1) {
-            auto paramsPartQ = cryptoParams->GetParamsPartQ(part);
-
-            uint32_t sizePartQl = sizeQl - alpha * part;
-
-            std::vector<NativeInteger> moduli(sizePartQl);
-            std::vector<NativeInteger> roots(sizePartQl);
-
-            for (uint32_t i = 0; i < sizePartQl; i++) {
-                moduli[i] = paramsPartQ->GetParams()[i]->GetModulus();
-                roots[i]  = paramsPartQ->GetParams()[i]->GetRootOfUnity();
-            }
-
-            auto params = DCRTPoly::Params(paramsPartQ->GetCyclotomicOrder(), moduli, roots);
-
-            partsCt[part] = DCRTPoly(std::make_shared<ParmType>(params), Format::EVALUATION, true);
-        }
-        else {
-            partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQ(part), Format::EVALUATION, true);
-        }
-
-        usint sizePartQl   = partsCt[part].GetNumOfElements();
         usint startPartIdx = alpha * part;
-        for (uint32_t i = 0, idx = startPartIdx; i < sizePartQl; i++, idx++) {
-            partsCt[part].SetElementAtIndex(i, c.GetElementAtIndex(idx));
-        }
-    }
-
-    std::vector<DCRTPoly> partsCtCompl(numPartQl);
-    std::vector<DCRTPoly> partsCtExt(numPartQl);
+        usint sizePartQl   = (part == numPartQl - 1) ? sizeQl - startPartIdx : alpha;
+        usint endPartIdx   = startPartIdx + sizePartQl;
 
-    for (uint32_t part = 0; part < numPartQl; part++) {
-        auto partCtClone = partsCt[part].Clone();
-        partCtClone.SetFormat(Format::COEFFICIENT);
+        // with contiguous towers, the slice of c is copied in one piece
+        DCRTPoly partCt = c.CloneTowers(startPartIdx, endPartIdx - 1);
+        partCt.SetFormat(Format::COEFFICIENT);
 
-        uint32_t sizePartQl = partsCt[part].GetNumOfElements();
-        partsCtCompl[part]  = partCtClone.ApproxSwitchCRTBasis(
-             cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
-             cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
-             cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
-             cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
+        DCRTPoly partCtCompl = partCt.ApproxSwitchCRTBasis(
+            cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
+            cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
+            cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
+            cryptoParams->GetPartQlHatModpTransposed(sizeQl - 1, part),
+            cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
 
-        partsCtCompl[part].SetFormat(Format::EVALUATION);
+        partCtCompl.SetFormat(Format::EVALUATION);
 
-        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
+        // every tower of the extended digit is assigned below, so there is no need to zero them first
+        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION);
 
-        usint startPartIdx = alpha * part;
-        usint endPartIdx   = startPartIdx + sizePartQl;
         for (usint i = 0; i < startPartIdx; i++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i));
+            partsCtExt[part].SetElementAtIndex(i, std::move(partCtCompl.GetAllElements()[i]));
         }
-        for (usint i = startPartIdx, idx = 0; i < endPartIdx; i++, idx++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCt[part].GetElementAtIndex(idx));
+        for (usint i = startPartIdx; i < endPartIdx; i++) {
+            partsCtExt[part].SetElementAtIndex(i, c.GetElementAtIndex(i));
         }
         for (usint i = endPartIdx; i < sizeQlP; ++i) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i - sizePartQl));
+            partsCtExt[part].SetElementAtIndex(i, std::move(partCtCompl.GetAllElements()[i - sizePartQl]));
         }
     }
 
@@ -424,14 +459,16 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
     DCRTPoly ct0 = (*cTilda)[0].ApproxModDown(paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
                                               cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
                                               cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
-                                              cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
-                                              cryptoParams->GettInvModpPrecon(), t, cryptoParams->GettModqPrecon());
+                                              cryptoParams->GetPHatModqTransposed(), cryptoParams->GetModqBarrettMu(),
+                                              cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+                                              cryptoParams->GettModqPrecon());
 
     DCRTPoly ct1 = (*cTilda)[1].ApproxModDown(paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(),
                                               cryptoParams->GetPInvModqPrecon(), cryptoParams->GetPHatInvModp(),
                                               cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
-                                              cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(),
-                                              cryptoParams->GettInvModpPrecon(), t, cryptoParams->GettModqPrecon());
+                                              cryptoParams->GetPHatModqTransposed(), cryptoParams->GetModqBarrettMu(),
+                                              cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+                                              cryptoParams->GettModqPrecon());
 
     return std::make_shared<std::vector<DCRTPoly>>(std::initializer_list<DCRTPoly>{std::move(ct0), std::move(ct1)});
 }
@@ -439,9 +476,17 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    // a key loaded from a key store is pinned in memory while it is used
+    if (auto resident = evalKey->LoadResident())
+        return EvalFastKeySwitchCoreExt(digits, resident, paramsQl);
+
     const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
     const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
-    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+    // the a's of a seeded key are streamed from the seed one tower at a time instead of being read from the key
+    const bool seeded{evalKey->IsSeeded()};
+    const std::vector<DCRTPoly>* av{seeded ? nullptr : &evalKey->GetAVector()};
+    const SeededUniformGenerator::SeedType seed{seeded ? EvalKeyRelinImpl<DCRTPoly>::ToSeedType(evalKey->GetSeed()) :
+                                                         SeededUniformGenerator::SeedType{}};
 
     const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
     const std::shared_ptr<ParmType> paramsQlP = (*digits)[0].GetParams();
@@ -453,14 +498,65 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // tower i < sizeQl of the digits is multiplied with tower i of the key, tower sizeQl + k with tower sizeQ + k
+    const size_t dnum{digits->size()};
+    const size_t ringDim{paramsQlP->GetRingDimension()};
+    std::vector<const uint64_t*> operands(3 * dnum * sizeQlP);
+    for (size_t i = 0; i < sizeQlP; ++i) {
+        size_t idx{(i < sizeQl) ? i : i - sizeQl + sizeQ};
+        const uint64_t** ops{&operands[3 * dnum * i]};
+        for (size_t j = 0; j < dnum; ++j) {
+            ops[j]        = reinterpret_cast<const uint64_t*>(&(*digits)[j].GetElementAtIndex(i).GetValues()[0]);
+            ops[dnum + j] = reinterpret_cast<const uint64_t*>(&bv[j].GetElementAtIndex(idx).GetValues()[0]);
+            if (!seeded)
+                ops[2 * dnum + j] = reinterpret_cast<const uint64_t*>(&(*av)[j].GetElementAtIndex(idx).GetValues()[0]);
+        }
+    }
+
+    auto& towers0 = cTilda0.GetAllElements();
+    auto& towers1 = cTilda1.GetAllElements();
+    OpenFHEParallelControls.ParallelFor(0, sizeQlP, [&](size_t i) {
+        const uint64_t* const* ops{&operands[3 * dnum * i]};
+        const NativeInteger& qi{towers0[i].GetModulus()};
+
+        // for a seeded key, tower idx of every digit of a is expanded into scratch memory local to this task
+        std::vector<NativeVector> aScratch;
+        std::vector<const uint64_t*> aOps;
+        if (seeded) {
+            size_t idx{(i < sizeQl) ? i : i - sizeQl + sizeQ};
+            aScratch.reserve(dnum);
+            aOps.reserve(dnum);
+            for (size_t j = 0; j < dnum; ++j) {
+                aScratch.push_back(SeededUniformGenerator::GenerateVector(
+                    seed, EvalKeyRelinImpl<DCRTPoly>::SeedStreamId(j, idx), ringDim, qi));
+                aOps.push_back(reinterpret_cast<const uint64_t*>(&aScratch.back()[0]));
+            }
+        }
+
+        KeySwitchInnerProductTower(ops, ops + dnum, seeded ? aOps.data() : ops + 2 * dnum, dnum, ringDim,
+                                   qi.ConvertToInt<uint64_t>(), reinterpret_cast<uint64_t*>(&towers0[i][0]),
+                                   reinterpret_cast<uint64_t*>(&towers1[i][0]));
+    });
+#else
+    // tower idx of digit j of a, expanded from the seed for a seeded key
+    auto getA = [&](uint32_t j, usint idx) -> DCRTPoly::PolyType {
+        if (!seeded)
+            return (*av)[j].GetElementAtIndex(idx);
+        const auto& params = bv[j].GetElementAtIndex(idx).GetParams();
+        return DCRTPoly::PolyType(params, Format::EVALUATION,
+                                  SeededUniformGenerator::GenerateVector(
+                                      seed, EvalKeyRelinImpl<DCRTPoly>::SeedStreamId(j, idx),
+                                      params->GetRingDimension(), params->GetModulus()));
+    };
+
     for (uint32_t j = 0; j < digits->size(); j++) {
         const DCRTPoly& cj = (*digits)[j];
         const DCRTPoly& bj = bv[j];
-        const DCRTPoly& aj = av[j];
 
         for (usint i = 0; i < sizeQl; i++) {
             const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(i);
+            const auto aji  = getA(j, i);
             const auto& bji = bj.GetElementAtIndex(i);
 
             cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
@@ -468,13 +564,14 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
         }
         for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
             const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(idx);
+            const auto aji  = getA(j, idx);
             const auto& bji = bj.GetElementAtIndex(idx);
 
             cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
             cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
         }
     }
+#endif
 
     return std::make_shared<std::vector<DCRTPoly>>(
         std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
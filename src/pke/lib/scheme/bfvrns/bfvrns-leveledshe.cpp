@@ -815,10 +815,10 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
 
     uint32_t autoIndex = FindAutomorphismIndex(index, m);
 
-    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    const auto evalKeyMap = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
     // verify if the key autoIndex exists in the evalKeyMap
-    auto evalKeyIterator = evalKeyMap.find(autoIndex);
-    if (evalKeyIterator == evalKeyMap.end()) {
+    auto evalKeyIterator = evalKeyMap->find(autoIndex);
+    if (evalKeyIterator == evalKeyMap->end()) {
         OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
     }
     auto evalKey = evalKeyIterator->second;
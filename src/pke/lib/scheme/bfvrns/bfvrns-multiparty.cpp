@@ -107,6 +107,7 @@ KeyPair<DCRTPoly> MultipartyBFVRNS::MultipartyKeyGen(CryptoContext<DCRTPoly> cc,
             s = DCRTPoly(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = DCRTPoly(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
@@ -38,6 +38,7 @@ BFV implementation. See https://eprint.iacr.org/2021/204 for details.
 #include "cryptocontext.h"
 #include "key/privatekey.h"
 #include "key/publickey.h"
+#include "math/seededuniformgenerator.h"
 #include "scheme/bfvrns/bfvrns-cryptoparameters.h"
 #include "scheme/bfvrns/bfvrns-pke.h"
 
@@ -68,6 +69,7 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
             s = DCRTPoly(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = DCRTPoly(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
@@ -121,7 +123,14 @@ Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PrivateKey<DCRTPoly
     }
     ptxt.SetFormat(Format::COEFFICIENT);
 
-    std::shared_ptr<std::vector<DCRTPoly>> ba = EncryptZeroCore(privateKey, encParams);
+    // c1 of the EXTENDED technique is scaled down after encryption, so only STANDARD ciphertexts can be seeded
+    std::vector<uint32_t> seed;
+    if (cryptoParams->GetSeededEncryption() && cryptoParams->GetEncryptionTechnique() != EXTENDED) {
+        const auto s = SeededUniformGenerator::GenerateSeed();
+        seed.assign(s.begin(), s.end());
+    }
+    std::shared_ptr<std::vector<DCRTPoly>> ba =
+        seed.empty() ? EncryptZeroCore(privateKey, encParams) : EncryptZeroCore(privateKey, encParams, seed);
 
     NativeInteger NegQModt       = cryptoParams->GetNegQModt(level);
     NativeInteger NegQModtPrecon = cryptoParams->GetNegQModtPrecon(level);
@@ -148,7 +157,13 @@ Ciphertext<DCRTPoly> PKEBFVRNS::Encrypt(DCRTPoly ptxt, const PrivateKey<DCRTPoly
     (*ba)[0].SetFormat(Format::EVALUATION);
     (*ba)[1].SetFormat(Format::EVALUATION);
 
-    ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    if (seed.empty()) {
+        ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    }
+    else {
+        ciphertext->SetElements({std::move((*ba)[0])});
+        ciphertext->SetSeed(seed);
+    }
     ciphertext->SetNoiseScaleDeg(1);
 
     return ciphertext;
@@ -34,6 +34,7 @@
 #include "scheme/ckksrns/ckksrns-fhe.h"
 
 #include "key/privatekey.h"
+#include "key/evalkeyrelin.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "schemebase/base-scheme.h"
 #include "cryptocontext.h"
@@ -45,23 +46,125 @@
 #include "math/dftransform.h"
 
 #include "utils/exception.h"
+#include "utils/hashutil.h"
+#include "utils/mappedfile.h"
+#include "utils/numa.h"
 #include "utils/parallel.h"
 #include "utils/utilities.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
+#include "wire-ser.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
 namespace lbcrypto {
 
+namespace {
+
+constexpr char PRECOM_MAGIC[8] = {'O', 'F', 'H', 'E', 'B', 'P', 'C', '1'};
+// version of the bootstrapping precomputation cache files
+constexpr uint32_t PRECOM_VERSION = 1;
+// size of the footer: table offset, number of plaintexts and magic
+constexpr size_t PRECOM_FOOTER_BYTES = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(PRECOM_MAGIC);
+
+template <typename T>
+void WriteValue(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T ReadValue(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Lists everything the encoded plaintexts of a precomputation depend on. The cache file is named after the hash
+// of the description, and the description itself is stored in the file to rule out hash collisions.
+std::string DescribeBootstrapPrecom(const CryptoContextImpl<DCRTPoly>& cc, const CKKSBootstrapPrecom& precom) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    std::ostringstream s;
+    s << std::hexfloat;
+    s << "version " << PRECOM_VERSION << " native " << NATIVEINT << " order " << cc.GetCyclotomicOrder();
+    s << " scaling " << cryptoParams->GetScalingTechnique() << " secret " << cryptoParams->GetSecretKeyDist();
+    s << " Q";
+    const auto& paramsQ = cryptoParams->GetElementParams()->GetParams();
+    for (const auto& p : paramsQ)
+        s << " " << p->GetModulus() << ":" << p->GetRootOfUnity();
+    s << " P";
+    for (const auto& p : cryptoParams->GetParamsP()->GetParams())
+        s << " " << p->GetModulus() << ":" << p->GetRootOfUnity();
+    s << " factors";
+    for (uint32_t l = 0; l < paramsQ.size(); ++l)
+        s << " " << cryptoParams->GetScalingFactorReal(l);
+    s << " slots " << precom.m_slots << " dim1 " << precom.m_dim1 << " enc";
+    for (auto v : precom.m_paramsEnc)
+        s << " " << v;
+    s << " dec";
+    for (auto v : precom.m_paramsDec)
+        s << " " << v;
+    return s.str();
+}
+
+std::string GetBootstrapPrecomPath(const std::string& cacheDir, const std::string& description) {
+    return cacheDir + "/ckks-bootstrap-" + HashUtil::HashString(description) + ".bin";
+}
+
+// The keys of sparse-secret encapsulation are stored with the automorphism keys, under even indices that are never
+// automorphism indices: one switches from the secret key to the sparse secret and the other one switches back
+uint32_t GetToSparseKeyIndex(uint32_t M) {
+    return M - 4;
+}
+
+uint32_t GetFromSparseKeyIndex(uint32_t M) {
+    return M - 2;
+}
+
+// the approximate modular reduction of a sparse-secret encapsulated bootstrapping runs as for a sparse secret
+SecretKeyDist GetModRaiseDist(SecretKeyDist secretKeyDist) {
+    return (secretKeyDist == SPARSE_ENCAPSULATED) ? SPARSE_TERNARY : secretKeyDist;
+}
+
+// Returns the part of a key switching key that is used for ciphertexts with the single tower q0, so that the
+// sparse secret is encrypted under the modulus q0*P only
+EvalKey<DCRTPoly> RestrictKeyToFirstTower(const EvalKey<DCRTPoly>& evalKey, size_t sizeQ) {
+    auto restrict = [sizeQ](std::vector<DCRTPoly> parts) {
+        parts.resize(1);
+        for (size_t i = 1; i < sizeQ; ++i) {
+            const auto& tower = parts[0].GetElementAtIndex(i);
+            parts[0].SetElementAtIndex(i, DCRTPoly::PolyType(tower.GetParams(), Format::EVALUATION, true));
+        }
+        return parts;
+    };
+    // the setters of a relinearization key insert rather than replace, so the restricted key is a new one. It is
+    // never seeded: a seed would expand A over all towers of Q, so the restricted A is kept explicitly instead
+    EvalKey<DCRTPoly> restricted = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
+    restricted->SetAVector(restrict(evalKey->GetAVector()));
+    restricted->SetBVector(restrict(evalKey->GetBVector()));
+    restricted->SetKeyTag(evalKey->GetKeyTag());
+    return restricted;
+}
+
+}  // namespace
+
 //------------------------------------------------------------------------------
 // Bootstrap Wrapper
 //------------------------------------------------------------------------------
 
 void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
                                     std::vector<uint32_t> dim1, uint32_t numSlots, uint32_t correctionFactor,
-                                    bool precompute) {
+                                    bool precompute, bool deferModDown, uint64_t maxPlaintextBytes) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -100,8 +203,10 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
     m_bootPrecomMap[slots]                      = std::make_shared<CKKSBootstrapPrecom>();
     std::shared_ptr<CKKSBootstrapPrecom> precom = m_bootPrecomMap[slots];
 
-    precom->m_slots = slots;
-    precom->m_dim1  = dim1[0];
+    precom->m_slots             = slots;
+    precom->m_dim1              = dim1[0];
+    precom->m_deferModDown      = deferModDown;
+    precom->m_maxPlaintextBytes = maxPlaintextBytes;
 
     uint32_t logSlots = std::log2(slots);
     // even for the case of a single slot we need one level for rescaling
@@ -161,7 +266,7 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
 
         uint128_t factor = ((uint128_t)1 << ((uint32_t)std::round(std::log2(qDouble))));
         double pre       = qDouble / factor;
-        double k         = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
+        double k         = (GetModRaiseDist(cryptoParams->GetSecretKeyDist()) == SPARSE_TERNARY) ? K_SPARSE : 1.0;
         double scaleEnc  = pre / k;
         double scaleDec  = 1 / pre;
 
@@ -196,24 +301,44 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
                 }
             }
 
+            std::vector<CKKSBootstrapDiagonals> enc(1);
+            std::vector<CKKSBootstrapDiagonals> dec(1);
             if (!isSparse) {
-                precom->m_U0hatTPre = EvalLinearTransformPrecompute(cc, U0hatT, scaleEnc, lEnc);
-                precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, scaleDec, lDec);
+                enc[0] = EvalLinearTransformDiagonals(cc, U0hatT, scaleEnc, lEnc);
+                dec[0] = EvalLinearTransformDiagonals(cc, U0, scaleDec, lDec);
             }
             else {
-                precom->m_U0hatTPre = EvalLinearTransformPrecompute(cc, U0hatT, U1hatT, 0, scaleEnc, lEnc);
-                precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, U1, 1, scaleDec, lDec);
+                enc[0] = EvalLinearTransformDiagonals(cc, U0hatT, U1hatT, 0, scaleEnc, lEnc);
+                dec[0] = EvalLinearTransformDiagonals(cc, U0, U1, 1, scaleDec, lDec);
             }
+            SetBootstrapPlaintexts(cc, *precom, std::move(enc), std::move(dec), false);
         }
         else {
-            precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-            precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+            SetBootstrapPlaintexts(cc, *precom,
+                                   EvalCoeffsToSlotsDiagonals(cc, ksiPows, rotGroup, false, scaleEnc, lEnc),
+                                   EvalSlotsToCoeffsDiagonals(cc, ksiPows, rotGroup, false, scaleDec, lDec), true);
         }
     }
+
+    if (OpenFHEParallelControls.GetNumaMode()) {
+        // the linear transforms read every plaintext from the threads of all nodes
+        auto interleave = [](const std::vector<ConstPlaintext>& pts) {
+            for (const auto& pt : pts) {
+                if (pt)
+                    NumaInterleaveTowers(pt->GetElement<DCRTPoly>());
+            }
+        };
+        interleave(precom->m_U0hatTPre);
+        interleave(precom->m_U0Pre);
+        for (const auto& pts : precom->m_U0hatTPreFFT)
+            interleave(pts);
+        for (const auto& pts : precom->m_U0PreFFT)
+            interleave(pts);
+    }
 }
 
 std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKeyGen(
-    const PrivateKey<DCRTPoly> privateKey, uint32_t slots) {
+    const PrivateKey<DCRTPoly> privateKey, uint32_t slots, uint32_t batchSlots) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(privateKey->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -229,11 +354,23 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKey
         slots = M / 4;
     // computing all indices for baby-step giant-step procedure
     auto algo     = cc->GetScheme();
-    auto evalKeys = algo->EvalAtIndexKeyGen(nullptr, privateKey, FindBootstrapRotationIndices(slots, M));
+    auto evalKeys = algo->EvalAtIndexKeyGen(nullptr, privateKey, FindBootstrapRotationIndices(slots, M, batchSlots));
 
     auto conjKey       = ConjugateKeyGen(privateKey);
     (*evalKeys)[M - 1] = conjKey;
 
+    if (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED) {
+        // ephemeral sparse secret with the Hamming weight of SPARSE_TERNARY secret keys
+        DCRTPoly::TugType tug;
+        auto sparseKey = std::make_shared<PrivateKeyImpl<DCRTPoly>>(cc);
+        sparseKey->SetPrivateElement(DCRTPoly(tug, cryptoParams->GetElementParams(), Format::EVALUATION, 192));
+        sparseKey->SetKeyTag(privateKey->GetKeyTag());
+
+        (*evalKeys)[GetToSparseKeyIndex(M)] = RestrictKeyToFirstTower(
+            algo->KeySwitchGen(privateKey, sparseKey), cryptoParams->GetElementParams()->GetParams().size());
+        (*evalKeys)[GetFromSparseKeyIndex(M)] = algo->KeySwitchGen(sparseKey, privateKey);
+    }
+
     return evalKeys;
 }
 
@@ -287,7 +424,7 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
 
     uint128_t factor = ((uint128_t)1 << ((uint32_t)std::round(std::log2(qDouble))));
     double pre       = qDouble / factor;
-    double k         = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
+    double k         = (GetModRaiseDist(cryptoParams->GetSecretKeyDist()) == SPARSE_TERNARY) ? K_SPARSE : 1.0;
     double scaleEnc  = pre / k;
     double scaleDec  = 1 / pre;
 
@@ -322,21 +459,290 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
             }
         }
 
+        std::vector<CKKSBootstrapDiagonals> enc(1);
+        std::vector<CKKSBootstrapDiagonals> dec(1);
         if (!isSparse) {
-            precom->m_U0hatTPre = EvalLinearTransformPrecompute(cc, U0hatT, scaleEnc, lEnc);
-            precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, scaleDec, lDec);
+            enc[0] = EvalLinearTransformDiagonals(cc, U0hatT, scaleEnc, lEnc);
+            dec[0] = EvalLinearTransformDiagonals(cc, U0, scaleDec, lDec);
         }
         else {
-            precom->m_U0hatTPre = EvalLinearTransformPrecompute(cc, U0hatT, U1hatT, 0, scaleEnc, lEnc);
-            precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, U1, 1, scaleDec, lDec);
+            enc[0] = EvalLinearTransformDiagonals(cc, U0hatT, U1hatT, 0, scaleEnc, lEnc);
+            dec[0] = EvalLinearTransformDiagonals(cc, U0, U1, 1, scaleDec, lDec);
         }
+        SetBootstrapPlaintexts(cc, *precom, std::move(enc), std::move(dec), false);
+    }
+    else {
+        SetBootstrapPlaintexts(cc, *precom, EvalCoeffsToSlotsDiagonals(cc, ksiPows, rotGroup, false, scaleEnc, lEnc),
+                               EvalSlotsToCoeffsDiagonals(cc, ksiPows, rotGroup, false, scaleDec, lDec), true);
+    }
+}
+
+void FHECKKSRNS::SetBootstrapPlaintexts(const CryptoContextImpl<DCRTPoly>& cc, CKKSBootstrapPrecom& precom,
+                                        std::vector<CKKSBootstrapDiagonals>&& enc,
+                                        std::vector<CKKSBootstrapDiagonals>&& dec, bool fft) const {
+    std::vector<CKKSBootstrapDiagonals*> levels;
+    for (auto& level : enc)
+        levels.push_back(&level);
+    for (auto& level : dec)
+        levels.push_back(&level);
+
+    // the levels with the smallest plaintexts are kept encoded first, as they take the least memory
+    // for the time saved per giant step
+    // a plaintext of a level has the towers of Q kept at its level and the towers of P
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+    const uint64_t sizeQ    = cryptoParams->GetElementParams()->GetParams().size();
+    const uint64_t sizeP    = cryptoParams->GetParamsP()->GetParams().size();
+    const uint64_t ringDim  = cc.GetRingDimension();
+    std::vector<uint64_t> bytes(levels.size(), 0);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const uint64_t towers = sizeQ - levels[i]->m_level + sizeP;
+        for (const auto& value : levels[i]->m_values) {
+            if (!value.empty())
+                bytes[i] += towers * ringDim * sizeof(NativeInteger);
+        }
+    }
+    std::vector<size_t> order(levels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return bytes[a] < bytes[b]; });
+
+    std::vector<std::vector<ConstPlaintext>> encoded(levels.size());
+    uint64_t total = 0;
+    for (size_t i : order) {
+        if (precom.m_maxPlaintextBytes != 0 && total + bytes[i] > precom.m_maxPlaintextBytes)
+            break;
+        total += bytes[i];
+        encoded[i] = EncodeDiagonals(cc, *levels[i], 0, levels[i]->m_values.size());
+        levels[i]->m_values.clear();
+        levels[i]->m_values.shrink_to_fit();
+    }
+
+    if (fft) {
+        precom.m_U0hatTPreFFT.assign(encoded.begin(), encoded.begin() + enc.size());
+        precom.m_U0PreFFT.assign(encoded.begin() + enc.size(), encoded.end());
+        precom.m_U0hatTPreFFTDiag = std::move(enc);
+        precom.m_U0PreFFTDiag     = std::move(dec);
     }
     else {
-        precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-        precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+        precom.m_U0hatTPre     = std::move(encoded[0]);
+        precom.m_U0Pre         = std::move(encoded[1]);
+        precom.m_U0hatTPreDiag = std::move(enc[0]);
+        precom.m_U0PreDiag     = std::move(dec[0]);
     }
 }
 
+void FHECKKSRNS::WriteBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, const std::string& cacheDir,
+                                              uint32_t numSlots) const {
+    uint32_t slots = (numSlots == 0) ? cc.GetCyclotomicOrder() / 4 : numSlots;
+
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end()) {
+        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalBootstrapSetup to proceed"));
+        OPENFHE_THROW(errorMsg);
+    }
+    const CKKSBootstrapPrecom& precom = *pair->second;
+
+    // the plaintexts are written in groups: U0hatTPre, U0Pre, the levels of U0hatTPreFFT and the levels of U0PreFFT
+    std::vector<const std::vector<ConstPlaintext>*> groups{&precom.m_U0hatTPre, &precom.m_U0Pre};
+    for (const auto& level : precom.m_U0hatTPreFFT)
+        groups.push_back(&level);
+    for (const auto& level : precom.m_U0PreFFT)
+        groups.push_back(&level);
+
+    size_t numPlaintexts = 0;
+    for (const auto& group : groups)
+        numPlaintexts += group->size();
+    if (numPlaintexts == 0)
+        OPENFHE_THROW("The plaintexts for " + std::to_string(slots) +
+                      " slots were not computed. Call EvalBootstrapPrecompute to proceed");
+
+    auto isCompact = [](const CKKSBootstrapDiagonals& diagonals) {
+        return !diagonals.m_values.empty();
+    };
+    if (isCompact(precom.m_U0hatTPreDiag) || isCompact(precom.m_U0PreDiag) ||
+        std::any_of(precom.m_U0hatTPreFFTDiag.begin(), precom.m_U0hatTPreFFTDiag.end(), isCompact) ||
+        std::any_of(precom.m_U0PreFFTDiag.begin(), precom.m_U0PreFFTDiag.end(), isCompact))
+        OPENFHE_THROW("Only precomputations with all plaintexts encoded can be written. Call EvalBootstrapSetup with "
+                      "maxPlaintextBytes = 0 to proceed");
+
+    const std::string description = DescribeBootstrapPrecom(cc, precom);
+    const std::string path        = GetBootstrapPrecomPath(cacheDir, description);
+
+    // the file is written under a unique name and renamed when complete, so that readers never see a partial file
+    std::ostringstream tmpName;
+    tmpName << path << ".tmp" << std::hex << std::random_device()();
+    const std::string tmpPath = tmpName.str();
+
+    std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        OPENFHE_THROW("Cannot create bootstrapping precomputation file " + tmpPath);
+
+    try {
+        out.write(PRECOM_MAGIC, sizeof(PRECOM_MAGIC));
+        WriteValue<uint32_t>(out, PRECOM_VERSION);
+        WriteValue<uint32_t>(out, static_cast<uint32_t>(description.size()));
+        out.write(description.data(), description.size());
+        WriteValue<uint32_t>(out, static_cast<uint32_t>(precom.m_U0hatTPreFFT.size()));
+        WriteValue<uint32_t>(out, static_cast<uint32_t>(precom.m_U0PreFFT.size()));
+        for (const auto& group : groups)
+            WriteValue<uint32_t>(out, static_cast<uint32_t>(group->size()));
+
+        // every plaintext starts at a multiple of the wire alignment so that it can be used in place when mapped;
+        // a missing plaintext is recorded with size 0
+        std::vector<std::pair<uint64_t, uint64_t>> entries;
+        entries.reserve(numPlaintexts);
+        for (const auto& group : groups) {
+            for (const auto& pt : *group) {
+                if (!pt) {
+                    entries.emplace_back(0, 0);
+                    continue;
+                }
+                uint64_t offset = static_cast<uint64_t>(out.tellp());
+                if (offset % Wire::WIRE_ALIGNMENT != 0) {
+                    const std::vector<char> zeros(Wire::WIRE_ALIGNMENT - offset % Wire::WIRE_ALIGNMENT, 0);
+                    out.write(zeros.data(), zeros.size());
+                    offset += zeros.size();
+                }
+                Wire::Serialize(std::const_pointer_cast<PlaintextImpl>(pt), out);
+                entries.emplace_back(offset, static_cast<uint64_t>(out.tellp()) - offset);
+            }
+        }
+
+        const uint64_t tableOffset = static_cast<uint64_t>(out.tellp());
+        for (const auto& entry : entries) {
+            WriteValue<uint64_t>(out, entry.first);
+            WriteValue<uint64_t>(out, entry.second);
+        }
+        WriteValue<uint64_t>(out, tableOffset);
+        WriteValue<uint32_t>(out, static_cast<uint32_t>(entries.size()));
+        out.write(PRECOM_MAGIC, sizeof(PRECOM_MAGIC));
+    }
+    catch (...) {
+        out.close();
+        std::remove(tmpPath.c_str());
+        throw;
+    }
+    out.close();
+
+    if (out.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        OPENFHE_THROW("Error writing bootstrapping precomputation file " + path);
+    }
+}
+
+bool FHECKKSRNS::LoadBootstrapPrecomputation(const CryptoContext<DCRTPoly>& cc, const std::string& cacheDir,
+                                             uint32_t numSlots) {
+    uint32_t slots = (numSlots == 0) ? cc->GetCyclotomicOrder() / 4 : numSlots;
+
+    auto pair = m_bootPrecomMap.find(slots);
+    if (pair == m_bootPrecomMap.end()) {
+        std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalBootstrapSetup to proceed"));
+        OPENFHE_THROW(errorMsg);
+    }
+    CKKSBootstrapPrecom& precom = *pair->second;
+
+    const std::string description = DescribeBootstrapPrecom(*cc, precom);
+    const std::string path        = GetBootstrapPrecomPath(cacheDir, description);
+    if (!std::ifstream(path).good())
+        return false;
+
+    auto file         = std::make_shared<MappedFile>(path, true);
+    const char* data  = file->GetData();
+    const size_t size = file->GetSize();
+    const size_t headerBytes{sizeof(PRECOM_MAGIC) + 2 * sizeof(uint32_t)};
+    if (size < headerBytes + PRECOM_FOOTER_BYTES || std::memcmp(data, PRECOM_MAGIC, sizeof(PRECOM_MAGIC)) != 0 ||
+        std::memcmp(data + size - sizeof(PRECOM_MAGIC), PRECOM_MAGIC, sizeof(PRECOM_MAGIC)) != 0)
+        OPENFHE_THROW(path + " is not a bootstrapping precomputation file");
+
+    const uint32_t version = ReadValue<uint32_t>(data + sizeof(PRECOM_MAGIC));
+    if (version > PRECOM_VERSION)
+        OPENFHE_THROW("Bootstrapping precomputation file " + path + " is from a later version of the library");
+
+    const char* footer         = data + size - PRECOM_FOOTER_BYTES;
+    const uint64_t tableOffset = ReadValue<uint64_t>(footer);
+    const uint32_t numEntries  = ReadValue<uint32_t>(footer + sizeof(uint64_t));
+    const size_t entryBytes{2 * sizeof(uint64_t)};
+    if (tableOffset < headerBytes || tableOffset > size - PRECOM_FOOTER_BYTES ||
+        (size - PRECOM_FOOTER_BYTES - tableOffset) / entryBytes != numEntries)
+        OPENFHE_THROW("Bootstrapping precomputation file " + path + " is corrupted");
+
+    const uint32_t descSize = ReadValue<uint32_t>(data + sizeof(PRECOM_MAGIC) + sizeof(uint32_t));
+    if (descSize > tableOffset - headerBytes ||
+        description.compare(0, std::string::npos, data + headerBytes, descSize) != 0)
+        OPENFHE_THROW("Bootstrapping precomputation file " + path + " was written for other parameters");
+
+    // group sizes: U0hatTPre, U0Pre, then every level of U0hatTPreFFT and U0PreFFT
+    const char* p = data + headerBytes + descSize;
+    if (2 * sizeof(uint32_t) > static_cast<size_t>(data + tableOffset - p))
+        OPENFHE_THROW("Bootstrapping precomputation file " + path + " is corrupted");
+    const uint32_t levelsEnc = ReadValue<uint32_t>(p);
+    const uint32_t levelsDec = ReadValue<uint32_t>(p + sizeof(uint32_t));
+    p += 2 * sizeof(uint32_t);
+    const uint64_t numGroups = 2 + static_cast<uint64_t>(levelsEnc) + levelsDec;
+    if (numGroups * sizeof(uint32_t) > static_cast<size_t>(data + tableOffset - p))
+        OPENFHE_THROW("Bootstrapping precomputation file " + path + " is corrupted");
+    std::vector<uint32_t> groupSizes(numGroups);
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < numGroups; ++i) {
+        groupSizes[i] = ReadValue<uint32_t>(p + i * sizeof(uint32_t));
+        total += groupSizes[i];
+    }
+    if (total != numEntries)
+        OPENFHE_THROW("Bootstrapping precomputation file " + path + " is corrupted");
+
+    std::vector<std::pair<uint64_t, uint64_t>> entries(numEntries);
+    for (uint32_t i = 0; i < numEntries; ++i) {
+        const char* entry = data + tableOffset + i * entryBytes;
+        entries[i]        = {ReadValue<uint64_t>(entry), ReadValue<uint64_t>(entry + sizeof(uint64_t))};
+        if (entries[i].first > tableOffset || entries[i].second > tableOffset - entries[i].first)
+            OPENFHE_THROW("Bootstrapping precomputation file " + path + " is corrupted");
+    }
+
+    // the plaintexts use the mapped memory in place and keep the file mapped while they are alive
+    std::vector<Plaintext> plaintexts(numEntries);
+    std::vector<std::exception_ptr> errors(numEntries);
+    char* base = file->GetWritableData();
+    OpenFHEParallelControls.ParallelFor(0, numEntries, [&](size_t i) {
+        if (entries[i].second == 0)
+            return;
+        try {
+            Wire::DeserializeFromBuffer(plaintexts[i], Wire::ByteSpan{base + entries[i].first, entries[i].second}, cc,
+                                        file);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for (const auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    auto next = plaintexts.begin();
+    auto take = [&next](uint32_t count) {
+        std::vector<ConstPlaintext> group(next, next + count);
+        next += count;
+        return group;
+    };
+    precom.m_U0hatTPre = take(groupSizes[0]);
+    precom.m_U0Pre     = take(groupSizes[1]);
+    precom.m_U0hatTPreFFT.clear();
+    precom.m_U0PreFFT.clear();
+    for (uint32_t i = 0; i < levelsEnc; ++i)
+        precom.m_U0hatTPreFFT.push_back(take(groupSizes[2 + i]));
+    for (uint32_t i = 0; i < levelsDec; ++i)
+        precom.m_U0PreFFT.push_back(take(groupSizes[2 + levelsEnc + i]));
+    // the loaded plaintexts are mapped from the file, so all levels are kept encoded
+    precom.m_U0hatTPreDiag = CKKSBootstrapDiagonals();
+    precom.m_U0PreDiag     = CKKSBootstrapDiagonals();
+    precom.m_U0hatTPreFFTDiag.clear();
+    precom.m_U0PreFFTDiag.clear();
+    return true;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                                uint32_t precision) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
@@ -475,6 +881,24 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
 
     AdjustCiphertext(raised, correction);
+
+    const SecretKeyDist secretKeyDist = GetModRaiseDist(cryptoParams->GetSecretKeyDist());
+    const bool isEncapsulated         = (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED);
+    std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> sparseKeyMap;
+    if (isEncapsulated) {
+        sparseKeyMap = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(raised->GetKeyTag());
+        if (sparseKeyMap->find(GetToSparseKeyIndex(M)) == sparseKeyMap->end() ||
+            sparseKeyMap->find(GetFromSparseKeyIndex(M)) == sparseKeyMap->end())
+            OPENFHE_THROW("The sparse-secret encapsulation keys were not generated. Need to call EvalBootstrapKeyGen "
+                          "to proceed");
+
+        // the level 0 ciphertext is switched to the sparse secret, so that raising its modulus adds only the
+        // small multiple of q0 of a sparse secret
+        for (auto& element : raised->GetElements())
+            element.DropLastElements(element.GetNumOfElements() - 1);
+        algo->KeySwitchInPlace(raised, sparseKeyMap->at(GetToSparseKeyIndex(M)));
+    }
+
     auto ctxtDCRT = raised->GetElements();
 
     // We only use the level 0 ciphertext here. All other towers are automatically ignored to make
@@ -490,6 +914,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
     raised->SetElements(std::move(ctxtDCRT));
 
+    // back to the secret key, which the rotation keys of the linear transforms are generated for
+    if (isEncapsulated)
+        algo->KeySwitchInPlace(raised, sparseKeyMap->at(GetFromSparseKeyIndex(M)));
+
 #ifdef BOOTSTRAPTIMING
     std::cerr << "\nNumber of levels at the beginning of bootstrapping: "
               << raised->GetElements()[0].GetNumOfElements() - 1 << std::endl;
@@ -503,7 +931,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     std::vector<double> coefficients;
     double k = 0;
 
-    if (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) {
+    if (secretKeyDist == SPARSE_TERNARY) {
         coefficients = g_coefficientsSparse;
         // k = K_SPARSE;
         k = 1.0;  // do not divide by k as we already did it during precomputation
@@ -542,11 +970,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
         // only one linear transform is needed as the other one can be derived
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtEnc = (isLTBootstrap) ?
+                           EvalLinearTransform(precom->m_U0hatTPre, raised, &precom->m_U0hatTPreDiag) :
+                           EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised, &precom->m_U0hatTPreFFTDiag);
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
+        auto evalKeyMap = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(ctxtEnc->GetKeyTag());
+        auto conj       = Conjugate(ctxtEnc, *evalKeyMap);
         auto ctxtEncI   = cc->EvalSub(ctxtEnc, conj);
         cc->EvalAddInPlace(ctxtEnc, conj);
         algo->MultByMonomialInPlace(ctxtEncI, 3 * M / 4);
@@ -573,14 +1002,13 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         ctxtEncI = cc->EvalChebyshevSeries(ctxtEncI, coefficients, coeffLowerBound, coeffUpperBound);
 
         // Double-angle iterations
-        if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
-            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY)) {
+        if ((secretKeyDist == UNIFORM_TERNARY) || (secretKeyDist == SPARSE_TERNARY)) {
             if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
                 algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
                 algo->ModReduceInternalInPlace(ctxtEncI, BASE_NUM_LEVELS_TO_DROP);
             }
             uint32_t numIter;
-            if (cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY)
+            if (secretKeyDist == UNIFORM_TERNARY)
                 numIter = R_UNIFORM;
             else
                 numIter = R_SPARSE;
@@ -615,8 +1043,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // Only one linear transform is needed
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc, &precom->m_U0PreDiag) :
+                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc, &precom->m_U0PreFFTDiag);
     }
     else {
         //------------------------------------------------------------------------------
@@ -642,11 +1070,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtEnc = (isLTBootstrap) ?
+                           EvalLinearTransform(precom->m_U0hatTPre, raised, &precom->m_U0hatTPreDiag) :
+                           EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised, &precom->m_U0hatTPreFFTDiag);
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
+        auto evalKeyMap = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(ctxtEnc->GetKeyTag());
+        auto conj       = Conjugate(ctxtEnc, *evalKeyMap);
         cc->EvalAddInPlace(ctxtEnc, conj);
 
         if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
@@ -678,13 +1107,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         ctxtEnc = cc->EvalChebyshevSeries(ctxtEnc, coefficients, coeffLowerBound, coeffUpperBound);
 
         // Double-angle iterations
-        if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
-            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY)) {
+        if ((secretKeyDist == UNIFORM_TERNARY) || (secretKeyDist == SPARSE_TERNARY)) {
             if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
                 algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
             }
             uint32_t numIter;
-            if (cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY)
+            if (secretKeyDist == UNIFORM_TERNARY)
                 numIter = R_UNIFORM;
             else
                 numIter = R_SPARSE;
@@ -715,8 +1143,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // linear transform for decoding
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc, &precom->m_U0PreDiag) :
+                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc, &precom->m_U0PreFFTDiag);
 
         cc->EvalAddInPlace(ctxtDec, cc->EvalRotate(ctxtDec, slots));
     }
@@ -743,11 +1171,83 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     return ctxtDec;
 }
 
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                                 uint32_t numIterations, uint32_t precision) const {
+    if (ciphertexts.empty())
+        OPENFHE_THROW("No ciphertexts to bootstrap");
+    if (ciphertexts.size() == 1)
+        return {EvalBootstrap(ciphertexts[0], numIterations, precision)};
+
+    auto cc             = ciphertexts[0]->GetCryptoContext();
+    auto algo           = cc->GetScheme();
+    uint32_t M          = cc->GetCyclotomicOrder();
+    uint32_t N          = cc->GetRingDimension();
+    const size_t slots  = ciphertexts[0]->GetSlots();
+    const size_t number = ciphertexts.size();
+    for (const auto& ciphertext : ciphertexts) {
+        if (ciphertext->GetSlots() != slots)
+            OPENFHE_THROW("All ciphertexts of a batch must have the same number of slots");
+    }
+
+    // the number of ciphertexts is padded to a power of two
+    uint32_t count = 1;
+    while (count < number)
+        count <<= 1;
+    const uint32_t batchSlots = count * slots;
+    if (batchSlots > N / 2)
+        OPENFHE_THROW("The batch of " + std::to_string(number) + " ciphertexts with " + std::to_string(slots) +
+                      " slots does not fit into the " + std::to_string(N / 2) + " slots of a ciphertext");
+
+    //------------------------------------------------------------------------------
+    // PACKING
+    //------------------------------------------------------------------------------
+
+    // A ciphertext with n slots encrypts a polynomial in X^(N/2n). For Y = X^step, the packed ciphertext encrypts
+    // sum_j Y^j m_j, whose coefficients interleave those of the m_j. It is a polynomial in X^(N/2*batchSlots), which
+    // bootstrapping for batchSlots slots refreshes. The monomial multiplications do not consume any level.
+    const uint32_t step         = N / (2 * batchSlots);
+    Ciphertext<DCRTPoly> packed = ciphertexts[0]->Clone();
+    for (uint32_t j = 1; j < number; ++j)
+        cc->EvalAddInPlace(packed, algo->MultByMonomial(ciphertexts[j], j * step));
+    packed->SetSlots(batchSlots);
+
+    auto refreshed = EvalBootstrap(packed, numIterations, precision);
+
+    //------------------------------------------------------------------------------
+    // UNPACKING
+    //------------------------------------------------------------------------------
+
+    // Q = A + Y^s B, with A and B polynomials in Y^2s, is split for s = 1, 2, ..., count/2: the rotation by
+    // batchSlots/2s maps Y^s to -Y^s and keeps Y^2s, so Q + rot(Q) = 2A and Y^-s (Q - rot(Q)) = 2B. This takes
+    // count - 1 rotations, and the factor count is divided out beforehand at the cost of one level.
+    cc->EvalMultInPlace(refreshed, 1.0 / count);
+    algo->ModReduceInternalInPlace(refreshed, BASE_NUM_LEVELS_TO_DROP);
+
+    std::vector<Ciphertext<DCRTPoly>> result(count);
+    result[0] = refreshed;
+    for (uint32_t s = 1; s < count; s <<= 1) {
+        for (uint32_t r = 0; r < s && r < number; ++r) {
+            auto rotated = cc->EvalRotate(result[r], batchSlots / (2 * s));
+            // the parts beyond the number of ciphertexts only hold padding
+            if (r + s < number) {
+                result[r + s] = cc->EvalSub(result[r], rotated);
+                algo->MultByMonomialInPlace(result[r + s], M - s * step);
+            }
+            cc->EvalAddInPlace(result[r], rotated);
+        }
+    }
+
+    result.resize(number);
+    for (auto& ciphertext : result)
+        ciphertext->SetSlots(slots);
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // Find Rotation Indices
 //------------------------------------------------------------------------------
 
-std::vector<int32_t> FHECKKSRNS::FindBootstrapRotationIndices(uint32_t slots, uint32_t M) {
+std::vector<int32_t> FHECKKSRNS::FindBootstrapRotationIndices(uint32_t slots, uint32_t M, uint32_t batchSlots) {
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
         std::string errorMsg(std::string("Precomputations for ") + std::to_string(slots) +
@@ -772,6 +1272,16 @@ std::vector<int32_t> FHECKKSRNS::FindBootstrapRotationIndices(uint32_t slots, ui
         fullIndexList.insert(fullIndexList.end(), indexListStC.begin(), indexListStC.end());
     }
 
+    // EvalBootstrapBatch unpacks ciphertexts with batchSlots slots by rotations with slots/2, slots/4, ..., batchSlots
+    if (batchSlots != 0) {
+        if (slots % batchSlots != 0)
+            OPENFHE_THROW("The number of slots [" + std::to_string(slots) +
+                          "] must be a multiple of the number of slots of the batched ciphertexts [" +
+                          std::to_string(batchSlots) + "]");
+        for (uint32_t r = batchSlots; r < slots; r <<= 1)
+            fullIndexList.emplace_back(r);
+    }
+
     // Remove possible duplicates
     sort(fullIndexList.begin(), fullIndexList.end());
     fullIndexList.erase(unique(fullIndexList.begin(), fullIndexList.end()), fullIndexList.end());
@@ -982,6 +1492,68 @@ std::vector<int32_t> FHECKKSRNS::FindSlotsToCoeffsRotationIndices(uint32_t slots
 //------------------------------------------------------------------------------
 
 std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<std::complex<double>>>& A, double scale,
+    uint32_t L) const {
+    const auto diagonals = EvalLinearTransformDiagonals(cc, A, scale, L);
+    return EncodeDiagonals(cc, diagonals, 0, diagonals.m_values.size());
+}
+
+std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<std::complex<double>>>& A,
+    const std::vector<std::vector<std::complex<double>>>& B, uint32_t orientation, double scale, uint32_t L) const {
+    const auto diagonals = EvalLinearTransformDiagonals(cc, A, B, orientation, scale, L);
+    return EncodeDiagonals(cc, diagonals, 0, diagonals.m_values.size());
+}
+
+std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    const auto diagonals = EvalCoeffsToSlotsDiagonals(cc, A, rotGroup, flag_i, scale, L);
+    std::vector<std::vector<ConstPlaintext>> result(diagonals.size());
+    for (size_t s = 0; s < diagonals.size(); ++s)
+        result[s] = EncodeDiagonals(cc, diagonals[s], 0, diagonals[s].m_values.size());
+    return result;
+}
+
+std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    const auto diagonals = EvalSlotsToCoeffsDiagonals(cc, A, rotGroup, flag_i, scale, L);
+    std::vector<std::vector<ConstPlaintext>> result(diagonals.size());
+    for (size_t s = 0; s < diagonals.size(); ++s)
+        result[s] = EncodeDiagonals(cc, diagonals[s], 0, diagonals[s].m_values.size());
+    return result;
+}
+
+std::vector<ConstPlaintext> FHECKKSRNS::EncodeDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                        const CKKSBootstrapDiagonals& diagonals, uint32_t first,
+                                                        uint32_t count) const {
+    const auto& values = diagonals.m_values;
+    first              = std::min<size_t>(first, values.size());
+    count              = std::min<size_t>(count, values.size() - first);
+
+    std::vector<ConstPlaintext> result(count);
+    OpenFHEParallelControls.ParallelFor(0, count, [&](size_t k) {
+        const auto& value = values[first + k];
+        if (!value.empty())
+            result[k] = MakeAuxPlaintext(cc, diagonals.m_params, value, 1, diagonals.m_level, value.size());
+    });
+    return result;
+}
+
+std::vector<ConstPlaintext> FHECKKSRNS::GetGiantStepPlaintexts(const CryptoContextImpl<DCRTPoly>& cc,
+                                                               const std::vector<ConstPlaintext>& A,
+                                                               const CKKSBootstrapDiagonals* diagonals,
+                                                               uint32_t first, uint32_t count) const {
+    if (diagonals != nullptr && !diagonals->m_values.empty())
+        return EncodeDiagonals(cc, *diagonals, first, count);
+
+    first = std::min<size_t>(first, A.size());
+    count = std::min<size_t>(count, A.size() - first);
+    return std::vector<ConstPlaintext>(A.begin() + first, A.begin() + first + count);
+}
+
+CKKSBootstrapDiagonals FHECKKSRNS::EvalLinearTransformDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<std::complex<double>>>& A, double scale,
     uint32_t L) const {
     if (A[0].size() != A.size()) {
@@ -1041,7 +1613,10 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
     auto elementParamsPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
     //  auto elementParamsPtr2 = std::dynamic_pointer_cast<typename DCRTPoly::Params>(elementParamsPtr);
 
-    std::vector<ConstPlaintext> result(slots);
+    CKKSBootstrapDiagonals result;
+    result.m_params = elementParamsPtr;
+    result.m_level  = towersToDrop;
+    result.m_values.resize(slots);
 // parallelizing the loop (below) with OMP causes a segfault on MinGW
 // see https://github.com/openfheorg/openfhe-development/issues/176
 #if !defined(__MINGW32__) && !defined(__MINGW64__)
@@ -1055,15 +1630,14 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
                 for (uint32_t k = 0; k < diag.size(); k++)
                     diag[k] *= scale;
 
-                result[bStep * j + i] =
-                    MakeAuxPlaintext(cc, elementParamsPtr, Rotate(diag, offset), 1, towersToDrop, diag.size());
+                result.m_values[bStep * j + i] = Rotate(diag, offset);
             }
         }
     }
     return result;
 }
 
-std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
+CKKSBootstrapDiagonals FHECKKSRNS::EvalLinearTransformDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<std::complex<double>>>& A,
     const std::vector<std::vector<std::complex<double>>>& B, uint32_t orientation, double scale, uint32_t L) const {
     uint32_t slots = A.size();
@@ -1118,7 +1692,10 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
     auto elementParamsPtr = std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(M, moduli, roots);
     //  auto elementParamsPtr2 = std::dynamic_pointer_cast<typename DCRTPoly::Params>(elementParamsPtr);
 
-    std::vector<ConstPlaintext> result(slots);
+    CKKSBootstrapDiagonals result;
+    result.m_params = elementParamsPtr;
+    result.m_level  = towersToDrop;
+    result.m_values.resize(slots);
 
     if (orientation == 0) {
         // vertical concatenation - used during homomorphic encoding
@@ -1134,8 +1711,7 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
                     for (uint32_t k = 0; k < vecA.size(); k++)
                         vecA[k] *= scale;
 
-                    result[bStep * j + i] =
-                        MakeAuxPlaintext(cc, elementParamsPtr, Rotate(vecA, offset), 1, towersToDrop, vecA.size());
+                    result.m_values[bStep * j + i] = Rotate(vecA, offset);
                 }
             }
         }
@@ -1162,8 +1738,7 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
                     for (uint32_t k = 0; k < vec.size(); k++)
                         vec[k] *= scale;
 
-                    result[bStep * j + i] =
-                        MakeAuxPlaintext(cc, elementParamsPtr, Rotate(vec, offset), 1, towersToDrop, vec.size());
+                    result.m_values[bStep * j + i] = Rotate(vec, offset);
                 }
             }
         }
@@ -1172,7 +1747,7 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
     return result;
 }
 
-std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
+std::vector<CKKSBootstrapDiagonals> FHECKKSRNS::EvalCoeffsToSlotsDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
     const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
     uint32_t slots = rotGroup.size();
@@ -1206,15 +1781,15 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
         flagRem = 1;
     }
 
-    // result is the rotated plaintext version of the coefficients
-    std::vector<std::vector<ConstPlaintext>> result(levelBudget);
+    // result is the rotated diagonal version of the coefficients
+    std::vector<CKKSBootstrapDiagonals> result(levelBudget);
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
         if (flagRem == 1 && i == 0) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ConstPlaintext>(numRotationsRem);
+            result[i].m_values.resize(numRotationsRem);
         }
         else {
-            result[i] = std::vector<ConstPlaintext>(numRotations);
+            result[i].m_values.resize(numRotations);
         }
     }
 
@@ -1261,6 +1836,10 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
         roots.erase(roots.begin() + sizeQ - 1);
         sizeQ--;
     }
+    for (int32_t s = 0; s < levelBudget; s++) {
+        result[s].m_params = paramsVector[s - stop];
+        result[s].m_level  = level0 - s;
+    }
 
     if (slots == M / 4) {
         //------------------------------------------------------------------------------
@@ -1287,8 +1866,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
 
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        result[s].m_values[g * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1305,8 +1883,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[stop][gRem * i + j], rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        result[stop].m_values[gRem * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1341,8 +1918,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        result[s].m_values[g * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1363,8 +1939,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        result[stop].m_values[gRem * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1373,7 +1948,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
     return result;
 }
 
-std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
+std::vector<CKKSBootstrapDiagonals> FHECKKSRNS::EvalSlotsToCoeffsDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
     const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
     uint32_t slots = rotGroup.size();
@@ -1405,15 +1980,15 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
         flagRem = 1;
     }
 
-    // result is the rotated plaintext version of coeff
-    std::vector<std::vector<ConstPlaintext>> result(levelBudget);
+    // result is the rotated diagonal version of coeff
+    std::vector<CKKSBootstrapDiagonals> result(levelBudget);
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
         if (flagRem == 1 && i == uint32_t(levelBudget - 1)) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ConstPlaintext>(numRotationsRem);
+            result[i].m_values.resize(numRotationsRem);
         }
         else {
-            result[i] = std::vector<ConstPlaintext>(numRotations);
+            result[i].m_values.resize(numRotations);
         }
     }
 
@@ -1460,6 +2035,10 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
         roots.erase(roots.begin() + sizeQ - 1);
         sizeQ--;
     }
+    for (int32_t s = 0; s < levelBudget; s++) {
+        result[s].m_params = paramsVector[s];
+        result[s].m_level  = level0 + s;
+    }
 
     if (slots == M / 4) {
         // fully-packed
@@ -1479,8 +2058,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s].m_values[g * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1498,8 +2076,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(coeff[s][gRem * i + j], rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s].m_values[gRem * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1531,8 +2108,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s].m_values[g * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1554,8 +2130,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                         }
 
                         auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        result[s].m_values[gRem * i + j] = std::move(rotateTemp);
                     }
                 }
             }
@@ -1569,8 +2144,9 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
 //------------------------------------------------------------------------------
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlaintext>& A,
-                                                     ConstCiphertext<DCRTPoly> ct) const {
-    uint32_t slots = A.size();
+                                                     ConstCiphertext<DCRTPoly> ct,
+                                                     const CKKSBootstrapDiagonals* diagonals) const {
+    uint32_t slots = (diagonals != nullptr && !diagonals->m_values.empty()) ? diagonals->m_values.size() : A.size();
 
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
@@ -1596,23 +2172,30 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     std::vector<Ciphertext<DCRTPoly>> fastRotation(bStep - 1);
 
     // hoisted automorphisms
-#pragma omp parallel for
-    for (uint32_t j = 1; j < bStep; j++) {
+    OpenFHEParallelControls.ParallelFor(1, bStep, [&](size_t j) {
         fastRotation[j - 1] = cc->EvalFastRotationExt(ct, j, digits, true);
-    }
+    });
 
     Ciphertext<DCRTPoly> result;
     DCRTPoly first;
 
     for (uint32_t j = 0; j < gStep; j++) {
-        Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), A[bStep * j]);
+        auto pts                   = GetGiantStepPlaintexts(*cc, A, diagonals, bStep * j, bStep);
+        Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), pts[0]);
         for (uint32_t i = 1; i < bStep; i++) {
             if (bStep * j + i < slots) {
-                EvalAddExtInPlace(inner, EvalMultExt(fastRotation[i - 1], A[bStep * j + i]));
+                EvalAddExtInPlace(inner, EvalMultExt(fastRotation[i - 1], pts[i]));
             }
         }
 
-        if (j == 0) {
+        if (precom->m_deferModDown) {
+            // c0 stays in the extended basis and is scaled down once with result
+            if (j == 0)
+                result = inner;
+            else
+                EvalGiantStepExtInPlace(result, inner, bStep * j);
+        }
+        else if (j == 0) {
             first         = cc->KeySwitchDownFirstElement(inner);
             auto elements = inner->GetElements();
             elements[0].SetValuesToZero();
@@ -1633,16 +2216,43 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
         }
     }
 
-    result        = cc->KeySwitchDown(result);
-    auto elements = result->GetElements();
-    elements[0] += first;
-    result->SetElements(std::move(elements));
+    result = cc->KeySwitchDown(result);
+    if (!precom->m_deferModDown) {
+        auto elements = result->GetElements();
+        elements[0] += first;
+        result->SetElements(std::move(elements));
+    }
 
     return result;
 }
 
+namespace {
+
+// hints the key store (see CryptoContextImpl::LoadEvalAutomorphismKeyStore) to read the rotation keys of a level of
+// the linear transforms while the previous level is being computed; keys held in memory ignore the hint
+void PrefetchRotationKeys(const std::map<usint, EvalKey<DCRTPoly>>& evalKeys, const std::vector<int32_t>& rotIn,
+                          const std::vector<int32_t>& rotOut, uint32_t M) {
+    for (const auto* rotations : {&rotIn, &rotOut}) {
+        for (int32_t rot : *rotations) {
+            if (rot == 0)
+                continue;
+            auto it = evalKeys.find(FindAutomorphismIndex2nComplex(rot, M));
+            if (it != evalKeys.end())
+                it->second->Prefetch();
+        }
+    }
+}
+
+// returns the diagonals of level s of the linear transforms, if any
+const CKKSBootstrapDiagonals* LevelDiagonals(const std::vector<CKKSBootstrapDiagonals>* diagonals, int32_t s) {
+    return (diagonals != nullptr && size_t(s) < diagonals->size()) ? &(*diagonals)[s] : nullptr;
+}
+
+}  // namespace
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector<ConstPlaintext>>& A,
-                                                   ConstCiphertext<DCRTPoly> ctxt) const {
+                                                   ConstCiphertext<DCRTPoly> ctxt,
+                                                   const std::vector<CKKSBootstrapDiagonals>* diagonals) const {
     uint32_t slots = ctxt->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -1719,40 +2329,57 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     Ciphertext<DCRTPoly> result = ctxt->Clone();
 
+    // held for the whole transform, so that the keys stay valid if they are replaced in the key store meanwhile
+    const auto evalKeysPtr = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(ctxt->GetKeyTag());
+    const auto& evalKeys   = *evalKeysPtr;
+    PrefetchRotationKeys(evalKeys, rot_in[levelBudget - 1], rot_out[levelBudget - 1], M);
+
     // hoisted automorphisms
     for (int32_t s = levelBudget - 1; s > stop; s--) {
         if (s != levelBudget - 1) {
             algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
         }
+        // the next level is the remainder level when s - 1 == stop
+        if (s > 0)
+            PrefetchRotationKeys(evalKeys, rot_in[s - 1], rot_out[s - 1], M);
 
         // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
         auto digits = cc->EvalFastRotationPrecompute(result);
 
         std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
+        OpenFHEParallelControls.ParallelFor(0, g, [&](size_t j) {
             if (rot_in[s][j] != 0) {
                 fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
             }
             else {
                 fastRotation[j] = cc->KeySwitchExt(result, true);
             }
-        }
+        });
 
         Ciphertext<DCRTPoly> outer;
         DCRTPoly first;
         for (int32_t i = 0; i < b; i++) {
             // for the first iteration with j=0:
             int32_t G                  = g * i;
-            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
+            auto pts                   = GetGiantStepPlaintexts(*cc, A[s], LevelDiagonals(diagonals, s), G, g);
+            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], pts[0]);
             // continue the loop
             for (int32_t j = 1; j < g; j++) {
                 if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], pts[j]));
                 }
             }
 
-            if (i == 0) {
+            if (precom->m_deferModDown) {
+                // c0 stays in the extended basis and is scaled down once with outer
+                if (i == 0)
+                    outer = inner;
+                else if (rot_out[s][i] != 0)
+                    EvalGiantStepExtInPlace(outer, inner, rot_out[s][i]);
+                else
+                    EvalAddExtInPlace(outer, inner);
+            }
+            else if (i == 0) {
                 first         = cc->KeySwitchDownFirstElement(inner);
                 auto elements = inner->GetElements();
                 elements[0].SetValuesToZero();
@@ -1779,9 +2406,11 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
                 }
             }
         }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = cc->KeySwitchDown(outer);
+        if (!precom->m_deferModDown) {
+            std::vector<DCRTPoly>& elements = result->GetElements();
+            elements[0] += first;
+        }
     }
 
     if (flagRem) {
@@ -1791,15 +2420,14 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
         auto digits = cc->EvalFastRotationPrecompute(result);
         std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
 
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
+        OpenFHEParallelControls.ParallelFor(0, gRem, [&](size_t j) {
             if (rot_in[stop][j] != 0) {
                 fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[stop][j], digits, true);
             }
             else {
                 fastRotation[j] = cc->KeySwitchExt(result, true);
             }
-        }
+        });
 
         Ciphertext<DCRTPoly> outer;
         DCRTPoly first;
@@ -1807,15 +2435,25 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[stop][GRem]);
+            auto pts     = GetGiantStepPlaintexts(*cc, A[stop], LevelDiagonals(diagonals, stop), GRem, gRem);
+            inner        = EvalMultExt(fastRotation[0], pts[0]);
             // continue the loop
             for (int32_t j = 1; j < gRem; j++) {
                 if ((GRem + j) != int32_t(numRotationsRem)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], pts[j]));
                 }
             }
 
-            if (i == 0) {
+            if (precom->m_deferModDown) {
+                // c0 stays in the extended basis and is scaled down once with outer
+                if (i == 0)
+                    outer = inner;
+                else if (rot_out[stop][i] != 0)
+                    EvalGiantStepExtInPlace(outer, inner, rot_out[stop][i]);
+                else
+                    EvalAddExtInPlace(outer, inner);
+            }
+            else if (i == 0) {
                 first         = cc->KeySwitchDownFirstElement(inner);
                 auto elements = inner->GetElements();
                 elements[0].SetValuesToZero();
@@ -1843,16 +2481,19 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = cc->KeySwitchDown(outer);
+        if (!precom->m_deferModDown) {
+            std::vector<DCRTPoly>& elements = result->GetElements();
+            elements[0] += first;
+        }
     }
 
     return result;
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector<ConstPlaintext>>& A,
-                                                   ConstCiphertext<DCRTPoly> ctxt) const {
+                                                   ConstCiphertext<DCRTPoly> ctxt,
+                                                   const std::vector<CKKSBootstrapDiagonals>* diagonals) const {
     uint32_t slots = ctxt->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -1932,24 +2573,30 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     //  No need for Encrypted Bit Reverse
     Ciphertext<DCRTPoly> result = ctxt->Clone();
 
+    const auto evalKeysPtr = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(ctxt->GetKeyTag());
+    const auto& evalKeys   = *evalKeysPtr;
+    PrefetchRotationKeys(evalKeys, rot_in[0], rot_out[0], M);
+
     // hoisted automorphisms
     for (int32_t s = 0; s < levelBudget - flagRem; s++) {
         if (s != 0) {
             algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
         }
+        // the next level is the remainder level when s + 1 == levelBudget - flagRem
+        if (s + 1 < levelBudget)
+            PrefetchRotationKeys(evalKeys, rot_in[s + 1], rot_out[s + 1], M);
         // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
         auto digits = cc->EvalFastRotationPrecompute(result);
 
         std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
+        OpenFHEParallelControls.ParallelFor(0, g, [&](size_t j) {
             if (rot_in[s][j] != 0) {
                 fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
             }
             else {
                 fastRotation[j] = cc->KeySwitchExt(result, true);
             }
-        }
+        });
 
         Ciphertext<DCRTPoly> outer;
         DCRTPoly first;
@@ -1957,15 +2604,25 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t G = g * i;
-            inner     = EvalMultExt(fastRotation[0], A[s][G]);
+            auto pts  = GetGiantStepPlaintexts(*cc, A[s], LevelDiagonals(diagonals, s), G, g);
+            inner     = EvalMultExt(fastRotation[0], pts[0]);
             // continue the loop
             for (int32_t j = 1; j < g; j++) {
                 if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], pts[j]));
                 }
             }
 
-            if (i == 0) {
+            if (precom->m_deferModDown) {
+                // c0 stays in the extended basis and is scaled down once with outer
+                if (i == 0)
+                    outer = inner;
+                else if (rot_out[s][i] != 0)
+                    EvalGiantStepExtInPlace(outer, inner, rot_out[s][i]);
+                else
+                    EvalAddExtInPlace(outer, inner);
+            }
+            else if (i == 0) {
                 first         = cc->KeySwitchDownFirstElement(inner);
                 auto elements = inner->GetElements();
                 elements[0].SetValuesToZero();
@@ -1993,9 +2650,11 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = cc->KeySwitchDown(outer);
+        if (!precom->m_deferModDown) {
+            std::vector<DCRTPoly>& elements = result->GetElements();
+            elements[0] += first;
+        }
     }
 
     if (flagRem) {
@@ -2005,15 +2664,14 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
         std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
 
         int32_t s = levelBudget - flagRem;
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
+        OpenFHEParallelControls.ParallelFor(0, gRem, [&](size_t j) {
             if (rot_in[s][j] != 0) {
                 fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
             }
             else {
                 fastRotation[j] = cc->KeySwitchExt(result, true);
             }
-        }
+        });
 
         Ciphertext<DCRTPoly> outer;
         DCRTPoly first;
@@ -2021,14 +2679,24 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[s][GRem]);
+            auto pts     = GetGiantStepPlaintexts(*cc, A[s], LevelDiagonals(diagonals, s), GRem, gRem);
+            inner        = EvalMultExt(fastRotation[0], pts[0]);
             // continue the loop
             for (int32_t j = 1; j < gRem; j++) {
                 if ((GRem + j) != int32_t(numRotationsRem))
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], pts[j]));
             }
 
-            if (i == 0) {
+            if (precom->m_deferModDown) {
+                // c0 stays in the extended basis and is scaled down once with outer
+                if (i == 0)
+                    outer = inner;
+                else if (rot_out[s][i] != 0)
+                    EvalGiantStepExtInPlace(outer, inner, rot_out[s][i]);
+                else
+                    EvalAddExtInPlace(outer, inner);
+            }
+            else if (i == 0) {
                 first         = cc->KeySwitchDownFirstElement(inner);
                 auto elements = inner->GetElements();
                 elements[0].SetValuesToZero();
@@ -2056,9 +2724,11 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = cc->KeySwitchDown(outer);
+        if (!precom->m_deferModDown) {
+            std::vector<DCRTPoly>& elements = result->GetElements();
+            elements[0] += first;
+        }
     }
 
     return result;
@@ -2292,6 +2962,7 @@ Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, co
 
     p->SetFormat(Format::EVALUATION);
     p->SetScalingFactor(pow(p->GetScalingFactor(), noiseScaleDeg));
+    p->SetEncoded();
 
     return p;
 }
@@ -2452,6 +3123,7 @@ Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, co
 
     p->SetFormat(Format::EVALUATION);
     p->SetScalingFactor(pow(p->GetScalingFactor(), noiseScaleDeg));
+    p->SetEncoded();
 
     return p;
 }
@@ -2488,6 +3160,42 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext
     return result;
 }
 
+void FHECKKSRNS::EvalGiantStepExtInPlace(Ciphertext<DCRTPoly>& outer, Ciphertext<DCRTPoly>& inner,
+                                         int32_t index) const {
+    const auto cc = inner->GetCryptoContext();
+    uint32_t M    = cc->GetCyclotomicOrder();
+    uint32_t N    = cc->GetRingDimension();
+
+    // Find the automorphism index that corresponds to rotation index index.
+    usint autoIndex       = FindAutomorphismIndex2nComplex(index, M);
+    const auto evalKeyMap = cc->GetKeyStore().GetEvalAutomorphismKeyMapPtr(inner->GetKeyTag());
+    auto evalKeyIterator  = evalKeyMap->find(autoIndex);
+    if (evalKeyIterator == evalKeyMap->end()) {
+        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+    }
+
+    std::vector<DCRTPoly>& cvInner = inner->GetElements();
+
+    // KeySwitchDownFirstElement only scales down the first element, so c1 is passed alone
+    Ciphertext<DCRTPoly> c1Ext = inner->CloneEmpty();
+    c1Ext->SetElements({std::move(cvInner[1])});
+    DCRTPoly c1 = cc->KeySwitchDownFirstElement(c1Ext);
+
+    auto algo   = cc->GetScheme();
+    auto digits = algo->EvalKeySwitchPrecomputeCore(c1, inner->GetCryptoParameters());
+    auto cTilda = algo->EvalFastKeySwitchCoreExt(digits, evalKeyIterator->second, c1.GetParams());
+
+    // c0 is added before the automorphism so that a single automorphism covers both
+    (*cTilda)[0] += cvInner[0];
+
+    std::vector<usint> map(N);
+    PrecomputeAutoMap(N, autoIndex, &map);
+
+    std::vector<DCRTPoly>& cvOuter = outer->GetElements();
+    cvOuter[0] += (*cTilda)[0].AutomorphismTransform(autoIndex, map);
+    cvOuter[1] += (*cTilda)[1].AutomorphismTransform(autoIndex, map);
+}
+
 EvalKey<DCRTPoly> FHECKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const {
     const auto cc = privateKey->GetCryptoContext();
     auto algo     = cc->GetScheme();
@@ -145,6 +145,63 @@ void LeveledSHECKKSRNS::LevelReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphert
 // Compress
 /////////////////////////////////////
 
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::CompressForTransport(ConstCiphertext<DCRTPoly> ciphertext,
+                                                             uint32_t precisionBits) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+
+    // rescale to a noise scale degree of 1 without dropping further towers
+    Ciphertext<DCRTPoly> result = Compress(ciphertext, ciphertext->GetElements()[0].GetNumOfElements());
+
+    // a single tower at the last level leaves the message log2(q0) - log2(scaling factor) bits of headroom
+    const auto& paramsQ     = cryptoParams->GetElementParams()->GetParams();
+    const double headroom   = std::log2(paramsQ[0]->GetModulus().ConvertToDouble()) -
+                            std::log2(cryptoParams->GetScalingFactorReal(paramsQ.size() - 1));
+    const double neededBits = headroom + std::log2(result->GetScalingFactor());
+
+    std::vector<DCRTPoly>& cv = result->GetElements();
+    const size_t sizeQl       = cv[0].GetNumOfElements();
+    size_t towersLeft         = 0;
+    double bits               = 0;
+    // half a bit of slack, so that the slightly different scaling factors of the FLEXIBLEAUTO levels do not cost a
+    // tower
+    while (towersLeft < sizeQl && bits + 0.5 < neededBits)
+        bits += std::log2(cv[0].GetElementAtIndex(towersLeft++).GetModulus().ConvertToDouble());
+    if (towersLeft < sizeQl)
+        LevelReduceInternalInPlace(result, sizeQl - towersLeft);
+
+    // Rounding the coefficients of c0 and c1 by at most 2^d adds an error with a standard deviation of about
+    // 2^d * sqrt(N * h / 12) / (scaling factor) to a decrypted value, where h <= N is the Hamming weight of the secret
+    // key. d = log2(scaling factor) - precisionBits - log2(N) - 1 keeps it below 2^-precisionBits by about 7 standard
+    // deviations. Only a single tower can be rounded, as the residues of several towers cannot be rounded
+    // independently.
+    if (precisionBits == 0 || towersLeft != 1)
+        return result;
+    const int32_t logSF     = static_cast<int32_t>(std::floor(std::log2(result->GetScalingFactor())));
+    const int32_t logN      = static_cast<int32_t>(std::ceil(std::log2(cv[0].GetRingDimension())));
+    const int32_t roundBits = logSF - static_cast<int32_t>(precisionBits) - logN - 1;
+    if (roundBits <= 0)
+        return result;
+
+    const BasicInteger mask = (BasicInteger(1) << roundBits) - 1;
+    const BasicInteger half = BasicInteger(1) << (roundBits - 1);
+    for (auto& c : cv) {
+        c.SetFormat(Format::COEFFICIENT);
+        auto& tower          = c.GetAllElements()[0];
+        const BasicInteger q = tower.GetModulus().ConvertToInt<BasicInteger>();
+        const uint32_t n     = tower.GetLength();
+        for (uint32_t j = 0; j < n; ++j) {
+            const BasicInteger x = tower[j].ConvertToInt<BasicInteger>();
+            // round to the nearest multiple, or down where rounding up would reach q
+            BasicInteger rounded = (x + half) & ~mask;
+            if (rounded >= q)
+                rounded = x & ~mask;
+            tower[j] = NativeInteger(rounded);
+        }
+        c.SetFormat(Format::EVALUATION);
+    }
+    return result;
+}
+
 /////////////////////////////////////
 // CKKS Core
 /////////////////////////////////////
@@ -101,6 +101,7 @@ KeyPair<Element> MultipartyBase<Element>::MultipartyKeyGen(CryptoContext<Element
             s = Element(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = Element(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
@@ -305,9 +306,13 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalKeys(EvalKey<Element> eval
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a  = evalKey1->GetAVector();
-    const std::vector<Element>& b1 = evalKey1->GetBVector();
-    const std::vector<Element>& b2 = evalKey2->GetBVector();
+    // keys loaded from a key store are pinned in memory while they are read
+    const auto key1 = PinEvalKey(evalKey1);
+    const auto key2 = PinEvalKey(evalKey2);
+
+    const std::vector<Element>& a  = key1->GetAVector();
+    const std::vector<Element>& b1 = key1->GetBVector();
+    const std::vector<Element>& b2 = key2->GetBVector();
 
     std::vector<Element> b;
     b.reserve(a.size());
@@ -329,10 +334,14 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalMultKeys(EvalKey<Element>
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a1 = evalKey1->GetAVector();
-    const std::vector<Element>& a2 = evalKey2->GetAVector();
-    const std::vector<Element>& b1 = evalKey1->GetBVector();
-    const std::vector<Element>& b2 = evalKey2->GetBVector();
+    // keys loaded from a key store are pinned in memory while they are read
+    const auto key1 = PinEvalKey(evalKey1);
+    const auto key2 = PinEvalKey(evalKey2);
+
+    const std::vector<Element>& a1 = key1->GetAVector();
+    const std::vector<Element>& a2 = key2->GetAVector();
+    const std::vector<Element>& b1 = key1->GetBVector();
+    const std::vector<Element>& b2 = key2->GetBVector();
 
     std::vector<Element> a;
     a.reserve(a1.size());
@@ -362,8 +371,11 @@ EvalKey<Element> MultipartyBase<Element>::MultiMultEvalKey(PrivateKey<Element> p
 
     EvalKey<Element> evalKeyResult = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
-    const std::vector<Element>& a0 = evalKey->GetAVector();
-    const std::vector<Element>& b0 = evalKey->GetBVector();
+    // a key loaded from a key store is pinned in memory while it is read
+    const auto key = PinEvalKey(evalKey);
+
+    const std::vector<Element>& a0 = key->GetAVector();
+    const std::vector<Element>& b0 = key->GetBVector();
 
     const Element& s = privateKey->GetPrivateElement();
     const auto ns    = cryptoParams->GetNoiseScale();
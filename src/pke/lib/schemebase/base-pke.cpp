@@ -65,6 +65,7 @@ KeyPair<Element> PKEBase<Element>::KeyGenInternal(CryptoContext<Element> cc, boo
             s = Element(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = Element(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
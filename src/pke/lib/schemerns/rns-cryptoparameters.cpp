@@ -208,6 +208,7 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
                 m_PHatModq[j][i]      = PHatModqji.ConvertToInt();
             }
         }
+        m_PHatModqT = DCRTPoly::TransposeCRTTable(m_PHatModq);
 
         BigInteger modulusQ = GetElementParams()->GetModulus();
         // Pre-compute values [Q/q_i]_{p_j}
@@ -301,10 +302,12 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
 
         // Pre-compute QHat mod complementary partition qi's
         m_PartQlHatModp.resize(sizeQ);
+        m_PartQlHatModpT.resize(sizeQ);
         for (uint32_t l = 0; l < sizeQ; l++) {
             uint32_t alpha = static_cast<uint32_t>(std::ceil(static_cast<double>(sizeQ) / m_numPartQ));
             uint32_t beta  = static_cast<uint32_t>(std::ceil(static_cast<double>(l + 1) / alpha));
             m_PartQlHatModp[l].resize(beta);
+            m_PartQlHatModpT[l].resize(beta);
             for (uint32_t k = 0; k < beta; k++) {
                 auto paramsPartQ   = GetParamsPartQ(k)->GetParams();
                 auto partQ         = GetParamsPartQ(k)->GetModulus();
@@ -326,6 +329,7 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
                         m_PartQlHatModp[l][k][i][j] = QHatModpj.ConvertToInt();
                     }
                 }
+                m_PartQlHatModpT[l][k] = DCRTPoly::TransposeCRTTable(m_PartQlHatModp[l][k]);
             }
         }
     }
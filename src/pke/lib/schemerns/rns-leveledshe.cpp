@@ -391,6 +391,13 @@ Ciphertext<DCRTPoly> LeveledSHERNS::Compress(ConstCiphertext<DCRTPoly> ciphertex
     return result;
 }
 
+Ciphertext<DCRTPoly> LeveledSHERNS::CompressForTransport(ConstCiphertext<DCRTPoly> ciphertext,
+                                                         uint32_t precisionBits) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
+    // FLEXIBLEAUTOEXT decrypts from the extra tower together with the first one
+    return Compress(ciphertext, (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT) ? 2 : 1);
+}
+
 /////////////////////////////////////////
 // SHE CORE OPERATION
 /////////////////////////////////////////
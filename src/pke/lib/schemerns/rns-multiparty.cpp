@@ -189,8 +189,11 @@ EvalKey<DCRTPoly> MultipartyRNS::MultiMultEvalKey(PrivateKey<DCRTPoly> privateKe
 
     EvalKey<DCRTPoly> evalKeyResult = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
 
-    const std::vector<DCRTPoly>& a0 = evalKey->GetAVector();
-    const std::vector<DCRTPoly>& b0 = evalKey->GetBVector();
+    // a key loaded from a key store is pinned in memory while it is read
+    const auto key = PinEvalKey(evalKey);
+
+    const std::vector<DCRTPoly>& a0 = key->GetAVector();
+    const std::vector<DCRTPoly>& b0 = key->GetBVector();
 
     const size_t size = a0.size();
 
@@ -33,6 +33,7 @@
 #include "key/privatekey.h"
 #include "key/publickey.h"
 #include "cryptocontext.h"
+#include "math/seededuniformgenerator.h"
 
 namespace lbcrypto {
 
@@ -40,13 +41,28 @@ Ciphertext<DCRTPoly> PKERNS::Encrypt(DCRTPoly plaintext, const PrivateKey<DCRTPo
     Ciphertext<DCRTPoly> ciphertext(std::make_shared<CiphertextImpl<DCRTPoly>>(privateKey));
 
     const std::shared_ptr<ParmType> ptxtParams = plaintext.GetParams();
-    std::shared_ptr<std::vector<DCRTPoly>> ba  = EncryptZeroCore(privateKey, ptxtParams);
+
+    // a seeded ciphertext keeps c0 and the seed of c1 only
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
+    std::vector<uint32_t> seed;
+    if (cryptoParams->GetSeededEncryption()) {
+        const auto s = SeededUniformGenerator::GenerateSeed();
+        seed.assign(s.begin(), s.end());
+    }
+    std::shared_ptr<std::vector<DCRTPoly>> ba =
+        seed.empty() ? EncryptZeroCore(privateKey, ptxtParams) : EncryptZeroCore(privateKey, ptxtParams, seed);
 
     plaintext.SetFormat(EVALUATION);
 
     (*ba)[0] += plaintext;
 
-    ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    if (seed.empty()) {
+        ciphertext->SetElements({std::move((*ba)[0]), std::move((*ba)[1])});
+    }
+    else {
+        ciphertext->SetElements({std::move((*ba)[0])});
+        ciphertext->SetSeed(seed);
+    }
     ciphertext->SetNoiseScaleDeg(1);
 
     return ciphertext;
@@ -110,15 +126,34 @@ DecryptResult PKERNS::Decrypt(ConstCiphertext<DCRTPoly> ciphertext, const Privat
 std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
                                                                const std::shared_ptr<ParmType> params) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
+    DugType dug;
+
+    const std::shared_ptr<ParmType> elementParams = (params == nullptr) ? cryptoParams->GetElementParams() : params;
+
+    return EncryptZeroCoreWithA(privateKey, DCRTPoly(dug, elementParams, Format::EVALUATION));
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCore(const PrivateKey<DCRTPoly> privateKey,
+                                                               const std::shared_ptr<ParmType> params,
+                                                               const std::vector<uint32_t>& seed) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
+
+    const std::shared_ptr<ParmType> elementParams = (params == nullptr) ? cryptoParams->GetElementParams() : params;
+
+    // c1 = -a is the element expanded from the seed
+    return EncryptZeroCoreWithA(privateKey, -CiphertextImpl<DCRTPoly>::ExpandSeededElement(seed, elementParams));
+}
+
+std::shared_ptr<std::vector<DCRTPoly>> PKERNS::EncryptZeroCoreWithA(const PrivateKey<DCRTPoly> privateKey,
+                                                                    const DCRTPoly& a) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(privateKey->GetCryptoParameters());
 
     const DCRTPoly& s  = privateKey->GetPrivateElement();
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
-    const std::shared_ptr<ParmType> elementParams = (params == nullptr) ? cryptoParams->GetElementParams() : params;
+    const std::shared_ptr<ParmType> elementParams = a.GetParams();
 
-    DCRTPoly a(dug, elementParams, Format::EVALUATION);
     DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
     uint32_t sizeQ  = s.GetParams()->GetParams().size();
@@ -0,0 +1,790 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Native binary wire format of ciphertexts, plaintexts and keys that can be deserialized without copying
+ */
+
+#include "wire-ser.h"
+
+#include "ciphertext.h"
+#include "cryptocontext.h"
+#include "encoding/plaintextfactory.h"
+#include "key/evalkeyrelin.h"
+#include "key/privatekey.h"
+#include "key/publickey.h"
+#include "schemerns/rns-cryptoparameters.h"
+#include "utils/mappedfile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace Wire {
+
+namespace {
+
+constexpr char WIRE_MAGIC[8]        = {'O', 'F', 'H', 'E', 'W', 'I', 'R', 'E'};
+constexpr uint32_t BYTE_ORDER_MARK  = 0x01020304;
+constexpr uint32_t WORD_BYTES       = sizeof(NativeInteger);
+constexpr size_t HEADER_FIELD_BYTES = sizeof(WIRE_MAGIC) + 4 * sizeof(uint32_t) + sizeof(uint64_t);
+
+static_assert(HEADER_FIELD_BYTES <= WIRE_ALIGNMENT, "the header must fit in one aligned block");
+static_assert(sizeof(BasicInteger) == WORD_BYTES, "a native integer must be stored as a single word");
+
+size_t AlignUp(size_t bytes) {
+    return (bytes + WIRE_ALIGNMENT - 1) & ~(WIRE_ALIGNMENT - 1);
+}
+
+// Writes the fields of an object to a stream or to memory, or only counts their bytes if there is no destination
+class Writer {
+public:
+    Writer() = default;
+
+    explicit Writer(std::ostream& out) : m_out(&out) {}
+
+    explicit Writer(ByteSpan buffer) : m_buffer(buffer) {}
+
+    void Write(const void* data, size_t bytes) {
+        if (m_out) {
+            m_out->write(static_cast<const char*>(data), bytes);
+        }
+        else if (m_buffer.data) {
+            if (bytes > m_buffer.size - m_pos)
+                OPENFHE_THROW("Buffer of " + std::to_string(m_buffer.size) + " bytes is too small");
+            std::memcpy(m_buffer.data + m_pos, data, bytes);
+        }
+        m_pos += bytes;
+    }
+
+    template <typename T>
+    void Value(T value) {
+        Write(&value, sizeof(value));
+    }
+
+    void Word(const NativeInteger& value) {
+        Value<BasicInteger>(value.ConvertToInt<BasicInteger>());
+    }
+
+    void String(const std::string& value) {
+        Value<uint32_t>(static_cast<uint32_t>(value.size()));
+        Write(value.data(), value.size());
+    }
+
+    void Align() {
+        static const char zeros[WIRE_ALIGNMENT] = {};
+        Write(zeros, AlignUp(m_pos) - m_pos);
+    }
+
+    size_t GetPosition() const {
+        return m_pos;
+    }
+
+private:
+    std::ostream* m_out{nullptr};
+    ByteSpan m_buffer;
+    size_t m_pos{0};
+};
+
+// Reads the fields of an object, checking that they lie in the buffer
+class Reader {
+public:
+    Reader(ByteSpan buffer, const CryptoContext<DCRTPoly>& cc, std::shared_ptr<void> owner)
+        : m_buffer(buffer), m_cc(cc), m_owner(std::move(owner)) {
+        if (m_owner && reinterpret_cast<uintptr_t>(m_buffer.data) % WIRE_ALIGNMENT != 0)
+            m_owner = nullptr;
+    }
+
+    char* Take(size_t bytes) {
+        if (m_pos > m_buffer.size || bytes > m_buffer.size - m_pos)
+            OPENFHE_THROW("Serialized object is truncated");
+        char* p = m_buffer.data + m_pos;
+        m_pos += bytes;
+        return p;
+    }
+
+    template <typename T>
+    T Value() {
+        T value;
+        std::memcpy(&value, Take(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    NativeInteger Word() {
+        return NativeInteger(Value<BasicInteger>());
+    }
+
+    std::string String() {
+        const uint32_t size = Value<uint32_t>();
+        const char* p       = Take(size);
+        return std::string(p, size);
+    }
+
+    void Align() {
+        Take(AlignUp(m_pos) - m_pos);
+    }
+
+    // version of the format the object was written with
+    uint32_t GetVersion() const {
+        return m_version;
+    }
+
+    void SetVersion(uint32_t version) {
+        m_version = version;
+    }
+
+    // number of bytes left to read
+    size_t GetRemaining() const {
+        return m_buffer.size - m_pos;
+    }
+
+    // limits the reader to the first bytes of the buffer, which have to hold at least the fields read so far
+    void Limit(size_t bytes) {
+        if (bytes > m_buffer.size)
+            OPENFHE_THROW("Serialized object is truncated");
+        if (bytes < m_pos || bytes < WIRE_ALIGNMENT)
+            OPENFHE_THROW("Serialized object is corrupted");
+        m_buffer.size = bytes;
+    }
+
+    const CryptoContext<DCRTPoly>& GetCryptoContext() const {
+        return m_cc;
+    }
+
+    // the owner of the buffer if the towers can be placed in it, nullptr if they have to be copied
+    const std::shared_ptr<void>& GetOwner() const {
+        return m_owner;
+    }
+
+private:
+    ByteSpan m_buffer;
+    const CryptoContext<DCRTPoly>& m_cc;
+    std::shared_ptr<void> m_owner;
+    size_t m_pos{0};
+    uint32_t m_version{VERSION};
+};
+
+void WriteHeader(Writer& w, ObjectType type, size_t totalBytes) {
+    w.Write(WIRE_MAGIC, sizeof(WIRE_MAGIC));
+    w.Value<uint32_t>(VERSION);
+    w.Value<uint32_t>(BYTE_ORDER_MARK);
+    w.Value<uint32_t>(static_cast<uint32_t>(type));
+    w.Value<uint32_t>(WORD_BYTES);
+    w.Value<uint64_t>(totalBytes);
+    w.Align();
+}
+
+// checks the header and limits the reader to the size of the object
+void ReadHeader(Reader& r, size_t bufferBytes, ObjectType type) {
+    if (bufferBytes < WIRE_ALIGNMENT || std::memcmp(r.Take(sizeof(WIRE_MAGIC)), WIRE_MAGIC, sizeof(WIRE_MAGIC)) != 0)
+        OPENFHE_THROW("Buffer does not hold an object in the wire format");
+    r.SetVersion(r.Value<uint32_t>());
+    if (r.GetVersion() > VERSION)
+        OPENFHE_THROW("Serialized object is from a later version of the library");
+    if (r.Value<uint32_t>() != BYTE_ORDER_MARK)
+        OPENFHE_THROW("Serialized object was written with a different byte order");
+    if (r.Value<uint32_t>() != static_cast<uint32_t>(type))
+        OPENFHE_THROW("Serialized object has a different type");
+    if (r.Value<uint32_t>() != WORD_BYTES)
+        OPENFHE_THROW("Serialized object was written with a different native word size");
+    r.Limit(r.Value<uint64_t>());
+    r.Align();
+}
+
+void WritePoly(Writer& w, const DCRTPoly& poly) {
+    const auto& towers = poly.GetAllElements();
+    w.Value<uint32_t>(static_cast<uint32_t>(poly.GetFormat()));
+    w.Value<uint32_t>(poly.GetCyclotomicOrder());
+    w.Value<uint32_t>(poly.GetRingDimension());
+    w.Value<uint32_t>(static_cast<uint32_t>(towers.size()));
+    for (const auto& tower : towers) {
+        w.Word(tower.GetModulus());
+        w.Word(tower.GetRootOfUnity());
+    }
+    w.Align();
+    const size_t towerBytes = poly.GetRingDimension() * WORD_BYTES;
+    for (const auto& tower : towers) {
+        w.Write(&tower.GetValues()[0], towerBytes);
+        w.Align();
+    }
+}
+
+// the parameters of the towers, sharing the ones of the crypto context where the moduli match
+std::shared_ptr<DCRTPoly::Params> GetPolyParams(const CryptoContext<DCRTPoly>& cc, uint32_t cyclotomicOrder,
+                                                const std::vector<NativeInteger>& moduli,
+                                                const std::vector<NativeInteger>& roots) {
+    const auto& elementParams = cc->GetElementParams();
+    if (cyclotomicOrder != elementParams->GetCyclotomicOrder())
+        OPENFHE_THROW("Serialized polynomial does not match the ring dimension of the crypto context");
+
+    std::vector<std::shared_ptr<ILNativeParams>> known(elementParams->GetParams());
+    auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+    if (cryptoParams && cryptoParams->GetParamsP())
+        known.insert(known.end(), cryptoParams->GetParamsP()->GetParams().begin(),
+                     cryptoParams->GetParamsP()->GetParams().end());
+
+    std::vector<std::shared_ptr<ILNativeParams>> params;
+    params.reserve(moduli.size());
+    bool allQ = moduli.size() == elementParams->GetParams().size();
+    for (size_t i = 0; i < moduli.size(); ++i) {
+        std::shared_ptr<ILNativeParams> p;
+        for (const auto& k : known) {
+            if (k->GetModulus() == moduli[i] && k->GetRootOfUnity() == roots[i]) {
+                p = k;
+                break;
+            }
+        }
+        if (!p)
+            p = std::make_shared<ILNativeParams>(cyclotomicOrder, moduli[i], roots[i]);
+        allQ = allQ && p == elementParams->GetParams()[i];
+        params.push_back(std::move(p));
+    }
+    if (allQ)
+        return elementParams;
+    return std::make_shared<DCRTPoly::Params>(cyclotomicOrder, params);
+}
+
+// checks the dimensions of a serialized polynomial against the crypto context before anything is allocated for it;
+// a polynomial of an extended basis may also have towers of the key switching modulus P
+void CheckPolyDimensions(const CryptoContext<DCRTPoly>& cc, uint32_t cyclotomicOrder, uint32_t ringDim,
+                         uint32_t numTowers, bool extendedBasis) {
+    const auto& elementParams = cc->GetElementParams();
+    size_t maxTowers          = elementParams->GetParams().size();
+    if (extendedBasis) {
+        auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+        if (cryptoParams && cryptoParams->GetParamsP())
+            maxTowers += cryptoParams->GetParamsP()->GetParams().size();
+    }
+    if (numTowers == 0 || numTowers > maxTowers)
+        OPENFHE_THROW("Serialized polynomial is corrupted");
+    if (cyclotomicOrder != elementParams->GetCyclotomicOrder() || ringDim != elementParams->GetRingDimension())
+        OPENFHE_THROW("Serialized polynomial does not match the ring dimension of the crypto context");
+}
+
+DCRTPoly ReadPoly(Reader& r) {
+    const auto format        = static_cast<Format>(r.Value<uint32_t>());
+    const uint32_t corder    = r.Value<uint32_t>();
+    const uint32_t ringDim   = r.Value<uint32_t>();
+    const uint32_t numTowers = r.Value<uint32_t>();
+    if (format != Format::EVALUATION && format != Format::COEFFICIENT)
+        OPENFHE_THROW("Serialized polynomial has an invalid format");
+    CheckPolyDimensions(r.GetCryptoContext(), corder, ringDim, numTowers, true);
+
+    std::vector<NativeInteger> moduli(numTowers);
+    std::vector<NativeInteger> roots(numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        moduli[i] = r.Word();
+        roots[i]  = r.Word();
+    }
+    r.Align();
+    auto params = GetPolyParams(r.GetCryptoContext(), corder, moduli, roots);
+
+    // the towers are placed in the slots of a single TowerBuffer, wrapping the serialized words where possible and
+    // copying them otherwise
+    const size_t towerBytes = ringDim * WORD_BYTES;
+    char* data              = r.Take(numTowers * AlignUp(towerBytes));
+    const bool inPlace      = r.GetOwner() != nullptr;
+
+    std::shared_ptr<intnat::TowerBuffer> buffer;
+    if (inPlace)
+        buffer = intnat::TowerBuffer::Wrap(reinterpret_cast<uint8_t*>(data), numTowers, towerBytes, r.GetOwner());
+    else
+        buffer = intnat::TowerBuffer::Create(numTowers, towerBytes, false);
+
+    std::vector<NativePoly> towers;
+    towers.reserve(numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        NativeVector values(ringDim, moduli[i], intnat::NativeVectorAllocator<NativeInteger>(buffer, i));
+        if (!inPlace)
+            std::memcpy(static_cast<void*>(&values[0]), data + i * AlignUp(towerBytes), towerBytes);
+        towers.emplace_back(params->GetParams()[i], format, std::move(values));
+    }
+    return DCRTPoly(params, format, std::move(towers));
+}
+
+void WritePolyVector(Writer& w, const std::vector<DCRTPoly>& polys) {
+    w.Value<uint32_t>(static_cast<uint32_t>(polys.size()));
+    for (const auto& poly : polys)
+        WritePoly(w, poly);
+}
+
+std::vector<DCRTPoly> ReadPolyVector(Reader& r) {
+    // a polynomial takes at least its fields and the modulus and root of one tower, which bounds the count that
+    // the rest of the buffer can hold before anything is reserved for it
+    constexpr size_t MIN_POLY_BYTES = 4 * sizeof(uint32_t) + 2 * WORD_BYTES;
+    const uint32_t size             = r.Value<uint32_t>();
+    if (size > r.GetRemaining() / MIN_POLY_BYTES)
+        OPENFHE_THROW("Serialized object is corrupted");
+    std::vector<DCRTPoly> polys;
+    polys.reserve(size);
+    for (uint32_t i = 0; i < size; ++i)
+        polys.push_back(ReadPoly(r));
+    return polys;
+}
+
+// The object-specific parts of the format
+
+constexpr ObjectType TypeOf(const Ciphertext<DCRTPoly>&) {
+    return ObjectType::CIPHERTEXT;
+}
+
+constexpr ObjectType TypeOf(const Plaintext&) {
+    return ObjectType::PLAINTEXT;
+}
+
+constexpr ObjectType TypeOf(const PublicKey<DCRTPoly>&) {
+    return ObjectType::PUBLIC_KEY;
+}
+
+constexpr ObjectType TypeOf(const PrivateKey<DCRTPoly>&) {
+    return ObjectType::PRIVATE_KEY;
+}
+
+constexpr ObjectType TypeOf(const EvalKey<DCRTPoly>&) {
+    return ObjectType::EVAL_KEY;
+}
+
+void WriteSeed(Writer& w, const std::vector<uint32_t>& seed) {
+    w.Value<uint32_t>(static_cast<uint32_t>(seed.size()));
+    w.Write(seed.data(), seed.size() * sizeof(uint32_t));
+}
+
+std::vector<uint32_t> ReadSeed(Reader& r) {
+    // checked before the seed is allocated, as the count comes from the buffer
+    const uint32_t size = r.Value<uint32_t>();
+    if (size != 0 && size != SeededUniformGenerator::SEED_WORDS)
+        OPENFHE_THROW("Serialized object is corrupted");
+    std::vector<uint32_t> seed(size);
+    for (auto& word : seed)
+        word = r.Value<uint32_t>();
+    return seed;
+}
+
+void WriteCiphertextFields(Writer& w, const Ciphertext<DCRTPoly>& ct) {
+    if (ct->GetMetadataMap() && !ct->GetMetadataMap()->empty())
+        OPENFHE_THROW("Ciphertext metadata is not supported by the wire format");
+    w.String(ct->GetKeyTag());
+    w.Value<uint32_t>(static_cast<uint32_t>(ct->GetEncodingType()));
+    w.Value<uint64_t>(ct->GetNoiseScaleDeg());
+    w.Value<uint64_t>(ct->GetLevel());
+    w.Value<uint64_t>(ct->GetHopLevel());
+    w.Value<double>(ct->GetScalingFactor());
+    w.Word(ct->GetScalingFactorInt());
+    w.Value<uint64_t>(ct->GetSlots());
+}
+
+std::shared_ptr<CiphertextImpl<DCRTPoly>> ReadCiphertextFields(Reader& r) {
+    auto result = std::make_shared<CiphertextImpl<DCRTPoly>>(r.GetCryptoContext());
+    result->SetKeyTag(r.String());
+    result->SetEncodingType(static_cast<PlaintextEncodings>(r.Value<uint32_t>()));
+    result->SetNoiseScaleDeg(r.Value<uint64_t>());
+    result->SetLevel(r.Value<uint64_t>());
+    result->SetHopLevel(r.Value<uint64_t>());
+    result->SetScalingFactor(r.Value<double>());
+    result->SetScalingFactorInt(r.Word());
+    result->SetSlots(r.Value<uint64_t>());
+    return result;
+}
+
+// a seeded ciphertext stores the seed of its last element and the other elements (since version 2)
+void WriteBody(Writer& w, const Ciphertext<DCRTPoly>& ct) {
+    WriteCiphertextFields(w, ct);
+    if (ct->IsSeeded()) {
+        std::vector<uint32_t> seed;
+        const auto elements = ct->GetStoredElements(seed);
+        WriteSeed(w, seed);
+        WritePolyVector(w, elements);
+    }
+    else {
+        WriteSeed(w, {});
+        WritePolyVector(w, ct->GetElements());
+    }
+}
+
+void ReadBody(Reader& r, Ciphertext<DCRTPoly>& ct) {
+    auto result     = ReadCiphertextFields(r);
+    const auto seed = (r.GetVersion() > 1) ? ReadSeed(r) : std::vector<uint32_t>();
+    result->SetElements(ReadPolyVector(r));
+    if (!seed.empty())
+        result->SetSeed(seed);
+    ct = std::move(result);
+}
+
+void WriteBody(Writer& w, const Plaintext& pt) {
+    if (!pt->IsEncoded())
+        OPENFHE_THROW("Plaintext is not encoded");
+    const auto& element = pt->GetElement<DCRTPoly>();
+    if (element.GetNumOfElements() == 0)
+        OPENFHE_THROW("Only plaintexts encoded as DCRTPoly are supported by the wire format");
+    w.Value<uint32_t>(static_cast<uint32_t>(pt->GetEncodingType()));
+    w.Value<uint32_t>(static_cast<uint32_t>(pt->GetSchemeID()));
+    w.Value<double>(pt->GetScalingFactor());
+    w.Word(pt->GetScalingFactorInt());
+    w.Value<uint64_t>(pt->GetLevel());
+    w.Value<uint64_t>(pt->GetNoiseScaleDeg());
+    w.Value<uint64_t>(pt->GetSlots());
+    WritePoly(w, element);
+}
+
+void ReadBody(Reader& r, Plaintext& pt) {
+    const auto& cc      = r.GetCryptoContext();
+    const auto encoding = static_cast<PlaintextEncodings>(r.Value<uint32_t>());
+    const auto schemeID = static_cast<SCHEME>(r.Value<uint32_t>());
+
+    auto result = PlaintextFactory::MakePlaintext(encoding, cc->GetElementParams(), cc->GetEncodingParams(), schemeID);
+    result->SetScalingFactor(r.Value<double>());
+    result->SetScalingFactorInt(r.Word());
+    result->SetLevel(r.Value<uint64_t>());
+    result->SetNoiseScaleDeg(r.Value<uint64_t>());
+    result->SetSlots(r.Value<uint64_t>());
+    result->GetElement<DCRTPoly>() = ReadPoly(r);
+    result->SetEncoded();
+    pt = std::move(result);
+}
+
+void WriteBody(Writer& w, const PublicKey<DCRTPoly>& key) {
+    w.String(key->GetKeyTag());
+    WritePolyVector(w, key->GetPublicElements());
+}
+
+void ReadBody(Reader& r, PublicKey<DCRTPoly>& key) {
+    auto result = std::make_shared<PublicKeyImpl<DCRTPoly>>(r.GetCryptoContext());
+    result->SetKeyTag(r.String());
+    result->SetPublicElements(ReadPolyVector(r));
+    key = std::move(result);
+}
+
+void WriteBody(Writer& w, const PrivateKey<DCRTPoly>& key) {
+    w.String(key->GetKeyTag());
+    WritePoly(w, key->GetPrivateElement());
+}
+
+void ReadBody(Reader& r, PrivateKey<DCRTPoly>& key) {
+    auto result = std::make_shared<PrivateKeyImpl<DCRTPoly>>(r.GetCryptoContext());
+    result->SetKeyTag(r.String());
+    result->SetPrivateElement(ReadPoly(r));
+    key = std::move(result);
+}
+
+// a seeded key stores its seed and vector B only
+void WriteBody(Writer& w, const EvalKey<DCRTPoly>& key) {
+    // a lazily loaded key is written from its loaded data
+    EvalKey<DCRTPoly> resident = key->LoadResident();
+    const auto& k              = resident ? resident : key;
+    if (!std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(k))
+        OPENFHE_THROW("Only relinearization keys are supported by the wire format");
+    w.String(k->GetKeyTag());
+    WriteSeed(w, k->GetSeed());
+    if (!k->IsSeeded())
+        WritePolyVector(w, k->GetAVector());
+    WritePolyVector(w, k->GetBVector());
+}
+
+void ReadBody(Reader& r, EvalKey<DCRTPoly>& key) {
+    auto result = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(r.GetCryptoContext());
+    result->SetKeyTag(r.String());
+    const auto seed = ReadSeed(r);
+    if (seed.empty())
+        result->SetAVector(ReadPolyVector(r));
+    result->SetBVector(ReadPolyVector(r));
+    result->SetSeed(seed);
+    key = std::move(result);
+}
+
+// The compact ciphertext format: every tower stores the number of trailing zero bits common to all its
+// coefficients, the number of bits of the remaining values and the values packed into words.
+
+constexpr uint32_t PACK_BITS = 8 * WORD_BYTES;
+
+struct PackedTower {
+    NativeInteger modulus;
+    NativeInteger root;
+    uint32_t shift;
+    uint32_t width;
+    std::vector<BasicInteger> words;
+};
+
+struct PackedPoly {
+    uint32_t cyclotomicOrder;
+    uint32_t ringDimension;
+    std::vector<PackedTower> towers;
+};
+
+uint32_t BitLength(BasicInteger value) {
+    uint32_t bits = 0;
+    for (; value != 0; value >>= 1)
+        ++bits;
+    return bits;
+}
+
+PackedPoly PackPoly(const DCRTPoly& poly) {
+    DCRTPoly coef(poly);
+    coef.SetFormat(Format::COEFFICIENT);
+
+    const uint32_t n = coef.GetRingDimension();
+    PackedPoly packed{coef.GetCyclotomicOrder(), n, {}};
+    for (const auto& tower : coef.GetAllElements()) {
+        const auto& values = tower.GetValues();
+        BasicInteger all   = 0;
+        for (uint32_t j = 0; j < n; ++j)
+            all |= values[j].ConvertToInt<BasicInteger>();
+        uint32_t shift = 0;
+        while (all != 0 && ((all >> shift) & 1) == 0)
+            ++shift;
+
+        PackedTower t{tower.GetModulus(), tower.GetRootOfUnity(), shift, 0, {}};
+        t.width = BitLength((tower.GetModulus().ConvertToInt<BasicInteger>() - 1) >> shift);
+        t.words.assign((static_cast<uint64_t>(n) * t.width + PACK_BITS - 1) / PACK_BITS, 0);
+        uint64_t pos = 0;
+        for (uint32_t j = 0; j < n; ++j, pos += t.width) {
+            const BasicInteger v = values[j].ConvertToInt<BasicInteger>() >> shift;
+            const uint32_t off   = pos % PACK_BITS;
+            t.words[pos / PACK_BITS] |= v << off;
+            if (off + t.width > PACK_BITS)
+                t.words[pos / PACK_BITS + 1] |= v >> (PACK_BITS - off);
+        }
+        packed.towers.push_back(std::move(t));
+    }
+    return packed;
+}
+
+void WritePackedPoly(Writer& w, const PackedPoly& packed) {
+    w.Value<uint32_t>(packed.cyclotomicOrder);
+    w.Value<uint32_t>(packed.ringDimension);
+    w.Value<uint32_t>(static_cast<uint32_t>(packed.towers.size()));
+    for (const auto& t : packed.towers) {
+        w.Word(t.modulus);
+        w.Word(t.root);
+        w.Value<uint32_t>(t.shift);
+        w.Value<uint32_t>(t.width);
+        w.Write(t.words.data(), t.words.size() * WORD_BYTES);
+    }
+}
+
+DCRTPoly ReadPackedPoly(Reader& r) {
+    const uint32_t corder    = r.Value<uint32_t>();
+    const uint32_t n         = r.Value<uint32_t>();
+    const uint32_t numTowers = r.Value<uint32_t>();
+    // a compact ciphertext has towers of the ciphertext modulus Q only
+    CheckPolyDimensions(r.GetCryptoContext(), corder, n, numTowers, false);
+
+    std::vector<NativeInteger> moduli(numTowers);
+    std::vector<NativeInteger> roots(numTowers);
+    std::vector<NativeVector> values;
+    values.reserve(numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i) {
+        moduli[i]            = r.Word();
+        roots[i]             = r.Word();
+        const uint32_t shift = r.Value<uint32_t>();
+        const uint32_t width = r.Value<uint32_t>();
+        if (width > PACK_BITS || shift >= PACK_BITS || moduli[i] == NativeInteger(0))
+            OPENFHE_THROW("Serialized polynomial is corrupted");
+
+        const size_t numWords = (static_cast<uint64_t>(n) * width + PACK_BITS - 1) / PACK_BITS;
+        const char* data      = r.Take(numWords * WORD_BYTES);
+        std::vector<BasicInteger> words(numWords);
+        if (numWords > 0)
+            std::memcpy(words.data(), data, numWords * WORD_BYTES);
+
+        const BasicInteger mask = (width == PACK_BITS) ? ~BasicInteger(0) : (BasicInteger(1) << width) - 1;
+        const BasicInteger q    = moduli[i].ConvertToInt<BasicInteger>();
+        NativeVector tower(n, moduli[i]);
+        uint64_t pos = 0;
+        for (uint32_t j = 0; j < n && width > 0; ++j, pos += width) {
+            const uint32_t off = pos % PACK_BITS;
+            BasicInteger v     = words[pos / PACK_BITS] >> off;
+            if (off + width > PACK_BITS)
+                v |= words[pos / PACK_BITS + 1] << (PACK_BITS - off);
+            v &= mask;
+            if ((shift > 0 && (v >> (PACK_BITS - shift)) != 0) || (v << shift) >= q)
+                OPENFHE_THROW("Serialized polynomial is corrupted");
+            tower[j] = NativeInteger(v << shift);
+        }
+        values.push_back(std::move(tower));
+    }
+
+    auto params = GetPolyParams(r.GetCryptoContext(), corder, moduli, roots);
+    std::vector<NativePoly> towers;
+    towers.reserve(numTowers);
+    for (uint32_t i = 0; i < numTowers; ++i)
+        towers.emplace_back(params->GetParams()[i], Format::COEFFICIENT, std::move(values[i]));
+    DCRTPoly poly(params, Format::COEFFICIENT, std::move(towers));
+    poly.SetFormat(Format::EVALUATION);
+    return poly;
+}
+
+void WriteCompact(Writer& w, const Ciphertext<DCRTPoly>& ct, const std::vector<PackedPoly>& packed,
+                  size_t totalBytes) {
+    WriteHeader(w, ObjectType::COMPACT_CIPHERTEXT, totalBytes);
+    WriteCiphertextFields(w, ct);
+    w.Value<uint32_t>(static_cast<uint32_t>(packed.size()));
+    for (const auto& poly : packed)
+        WritePackedPoly(w, poly);
+    w.Align();
+}
+
+// the largest number of elements of a compact ciphertext: the size up to which the context can relinearize it
+size_t GetMaxCompactElements(const CryptoContext<DCRTPoly>& cc) {
+    return std::max<size_t>(2, cc->GetCryptoParameters()->GetMaxRelinSkDeg() + 1);
+}
+
+std::vector<PackedPoly> PackCiphertext(const Ciphertext<DCRTPoly>& ct) {
+    if (!ct)
+        OPENFHE_THROW("Object to serialize is nullptr");
+    if (ct->GetElements().empty() || ct->GetElements().size() > GetMaxCompactElements(ct->GetCryptoContext()))
+        OPENFHE_THROW("Ciphertext has an unsupported number of elements for the compact format");
+    std::vector<PackedPoly> packed;
+    for (const auto& element : ct->GetElements())
+        packed.push_back(PackPoly(element));
+    return packed;
+}
+
+template <typename T>
+void CheckObject(const T& obj) {
+    if (!obj)
+        OPENFHE_THROW("Object to serialize is nullptr");
+}
+
+template <typename T>
+void WriteObject(Writer& w, const T& obj, size_t totalBytes) {
+    WriteHeader(w, TypeOf(obj), totalBytes);
+    WriteBody(w, obj);
+    w.Align();
+}
+
+}  // namespace
+
+template <typename T>
+size_t GetSerializedSize(const T& obj) {
+    CheckObject(obj);
+    Writer counter;
+    WriteObject(counter, obj, 0);
+    return counter.GetPosition();
+}
+
+template <typename T>
+void Serialize(const T& obj, std::ostream& out) {
+    const size_t totalBytes = GetSerializedSize(obj);
+    Writer w(out);
+    WriteObject(w, obj, totalBytes);
+    if (!out.good())
+        OPENFHE_THROW("Error writing serialized object");
+}
+
+template <typename T>
+size_t SerializeToBuffer(const T& obj, ByteSpan buffer) {
+    const size_t totalBytes = GetSerializedSize(obj);
+    if (totalBytes > buffer.size)
+        OPENFHE_THROW("Buffer of " + std::to_string(buffer.size) + " bytes is too small for " +
+                      std::to_string(totalBytes) + " bytes");
+    Writer w(buffer);
+    WriteObject(w, obj, totalBytes);
+    return totalBytes;
+}
+
+template <typename T>
+void DeserializeFromBuffer(T& obj, ByteSpan buffer, const CryptoContext<DCRTPoly>& cc, std::shared_ptr<void> owner) {
+    if (!cc)
+        OPENFHE_THROW("Crypto context is nullptr");
+    if (!buffer.data)
+        OPENFHE_THROW("Buffer is nullptr");
+    Reader r(buffer, cc, std::move(owner));
+    ReadHeader(r, buffer.size, TypeOf(obj));
+    ReadBody(r, obj);
+}
+
+template <typename T>
+void DeserializeFromFile(T& obj, const std::string& path, const CryptoContext<DCRTPoly>& cc) {
+    auto file = std::make_shared<MappedFile>(path, true);
+    DeserializeFromBuffer(obj, ByteSpan{file->GetWritableData(), file->GetSize()}, cc, file);
+}
+
+size_t GetCompactSize(const Ciphertext<DCRTPoly>& ct) {
+    const auto packed = PackCiphertext(ct);
+    Writer counter;
+    WriteCompact(counter, ct, packed, 0);
+    return counter.GetPosition();
+}
+
+size_t SerializeCompact(const Ciphertext<DCRTPoly>& ct, std::ostream& out) {
+    const auto packed = PackCiphertext(ct);
+    Writer counter;
+    WriteCompact(counter, ct, packed, 0);
+    Writer w(out);
+    WriteCompact(w, ct, packed, counter.GetPosition());
+    if (!out.good())
+        OPENFHE_THROW("Error writing serialized object");
+    return w.GetPosition();
+}
+
+void DeserializeCompact(Ciphertext<DCRTPoly>& ct, ByteSpan buffer, const CryptoContext<DCRTPoly>& cc) {
+    if (!cc)
+        OPENFHE_THROW("Crypto context is nullptr");
+    if (!buffer.data)
+        OPENFHE_THROW("Buffer is nullptr");
+    Reader r(buffer, cc, nullptr);
+    ReadHeader(r, buffer.size, ObjectType::COMPACT_CIPHERTEXT);
+    auto result         = ReadCiphertextFields(r);
+    // checked before the elements are reserved, as the count comes from the buffer
+    const uint32_t size = r.Value<uint32_t>();
+    if (size == 0 || size > GetMaxCompactElements(cc))
+        OPENFHE_THROW("Serialized object is corrupted");
+    std::vector<DCRTPoly> elements;
+    elements.reserve(size);
+    for (uint32_t i = 0; i < size; ++i)
+        elements.push_back(ReadPackedPoly(r));
+    result->SetElements(std::move(elements));
+    ct = std::move(result);
+}
+
+#define WIRE_INSTANTIATE(T)                                                                                        \
+    template size_t GetSerializedSize(const T& obj);                                                               \
+    template void Serialize(const T& obj, std::ostream& out);                                                      \
+    template size_t SerializeToBuffer(const T& obj, ByteSpan buffer);                                              \
+    template void DeserializeFromBuffer(T& obj, ByteSpan buffer, const CryptoContext<DCRTPoly>& cc,                \
+                                        std::shared_ptr<void> owner);                                              \
+    template void DeserializeFromFile(T& obj, const std::string& path, const CryptoContext<DCRTPoly>& cc);
+
+WIRE_INSTANTIATE(Ciphertext<DCRTPoly>)
+WIRE_INSTANTIATE(Plaintext)
+WIRE_INSTANTIATE(PublicKey<DCRTPoly>)
+WIRE_INSTANTIATE(PrivateKey<DCRTPoly>)
+WIRE_INSTANTIATE(EvalKey<DCRTPoly>)
+
+#undef WIRE_INSTANTIATE
+
+}  // namespace Wire
+
+}  // namespace lbcrypto
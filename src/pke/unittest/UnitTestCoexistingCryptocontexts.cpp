@@ -37,6 +37,11 @@
 #include "UnitTestUtils.h"
 #include "include/gtest/gtest.h"
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace lbcrypto;
 
 class UTGENERAL_CRYPTOCONTEXTS : public ::testing::Test {
@@ -115,3 +120,134 @@ TEST_F(UTGENERAL_CRYPTOCONTEXTS, coexisting_ckks_cryptocontexts) {
     EXPECT_TRUE(checkEquality(values, results->GetRealPackedValue(), epsilon))
         << "static data for the first cryptocontext may be overriden";
 }
+
+TEST_F(UTGENERAL_CRYPTOCONTEXTS, concurrent_key_store) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetScalingModSize(50);
+    parameters.SetRingDim(64);
+    parameters.SetBatchSize(8);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto& store = CryptoContextImpl<DCRTPoly>::GetEvalKeyStore();
+    // tenant A evaluates while the keys of tenant B are loaded and evicted
+    KeyPair<DCRTPoly> keyA = cc->KeyGen();
+    KeyPair<DCRTPoly> keyB = cc->KeyGen();
+    cc->EvalMultKeyGen(keyA.secretKey);
+    cc->EvalRotateKeyGen(keyA.secretKey, {1});
+    const std::string tagA = keyA.secretKey->GetKeyTag();
+    const std::string tagB = keyB.secretKey->GetKeyTag();
+
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    std::vector<double> expected(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        expected[i] = values[(i + 1) % values.size()] * values[(i + 1) % values.size()];
+    auto ciphertext = cc->Encrypt(keyA.publicKey, cc->MakeCKKSPackedPlaintext(values));
+
+    // keys held by a reader survive eviction
+    const auto heldKeys = CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMapPtr(tagA);
+    EXPECT_FALSE(store.InsertEvalMultKeys(tagA, CryptoContextImpl<DCRTPoly>::GetEvalMultKeyVector(tagA), false));
+
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> failures{0};
+    std::vector<std::thread> readers;
+    for (uint32_t t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                auto result = cc->EvalMult(cc->EvalRotate(ciphertext, 1), cc->EvalRotate(ciphertext, 1));
+                Plaintext decrypted;
+                cc->Decrypt(keyA.secretKey, result, &decrypted);
+                decrypted->SetLength(values.size());
+                if (!checkEquality(expected, decrypted->GetRealPackedValue(), 0.0001))
+                    ++failures;
+            }
+        });
+    }
+    for (uint32_t round = 0; round < 20; ++round) {
+        cc->EvalMultKeyGen(keyB.secretKey);
+        cc->EvalRotateKeyGen(keyB.secretKey, {1, 2});
+        EXPECT_EQ(cc->GetEvalAutomorphismKeyMapPtr(tagB)->size(), 2u);
+        EXPECT_TRUE(store.Evict(tagB));
+        EXPECT_FALSE(store.Evict(tagB));
+        // the rotation keys of tenant A are replaced as a whole
+        store.InsertEvalAutomorphismKeys(tagA, cc->GetScheme()->EvalAtIndexKeyGen(nullptr, keyA.secretKey, {1}), true);
+    }
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+    EXPECT_EQ(failures, 0u) << "evaluation failed while keys were replaced";
+
+    EXPECT_TRUE(store.Evict(tagA));
+    EXPECT_THROW(cc->EvalRotate(ciphertext, 1), OpenFHEException);
+    EXPECT_EQ(heldKeys->size(), 1u);
+    EXPECT_TRUE(heldKeys->at(cc->FindAutomorphismIndex(1)) != nullptr);
+}
+
+TEST_F(UTGENERAL_CRYPTOCONTEXTS, per_context_key_store) {
+    // two tenants with contexts of their own, each owning its keys
+    std::vector<CryptoContext<DCRTPoly>> contexts;
+    for (uint32_t depth : {2, 3}) {
+        CCParams<CryptoContextCKKSRNS> parameters;
+        parameters.SetMultiplicativeDepth(depth);
+        parameters.SetScalingModSize(50);
+        parameters.SetRingDim(64);
+        parameters.SetBatchSize(8);
+        parameters.SetSecurityLevel(HEStd_NotSet);
+
+        CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+        cc->Enable(PKE);
+        cc->Enable(KEYSWITCH);
+        cc->Enable(LEVELEDSHE);
+        cc->SetKeyStore(std::make_shared<KeyStore<DCRTPoly>>());
+        contexts.push_back(cc);
+    }
+    ASSERT_TRUE(contexts[0] != contexts[1]);
+    auto& shared = CryptoContextImpl<DCRTPoly>::GetEvalKeyStore();
+    auto& storeA = contexts[0]->GetKeyStore();
+    auto& storeB = contexts[1]->GetKeyStore();
+    ASSERT_NE(&storeA, &storeB);
+    ASSERT_NE(&storeA, &shared);
+
+    std::vector<KeyPair<DCRTPoly>> keys;
+    for (const auto& cc : contexts) {
+        keys.push_back(cc->KeyGen());
+        cc->EvalMultKeyGen(keys.back().secretKey);
+    }
+    const std::string tagA   = keys[0].secretKey->GetKeyTag();
+    const size_t multKeySize = storeA.GetByteSize();
+    EXPECT_GT(multKeySize, 0u);
+    contexts[0]->EvalRotateKeyGen(keys[0].secretKey, {1, 2});
+    EXPECT_GT(storeA.GetByteSize(), multKeySize);
+    EXPECT_EQ(storeA.GetByteSize(), storeA.GetByteSize(tagA));
+    EXPECT_EQ(storeB.GetByteSize(tagA), 0u);
+    EXPECT_TRUE(shared.FindEvalAutomorphismKeys(tagA) == nullptr);
+
+    const std::vector<double> values = {1.0, 0.5, 0.25, 2.0};
+    const auto& cc                   = contexts[0];
+    auto ciphertext                  = cc->Encrypt(keys[0].publicKey, cc->MakeCKKSPackedPlaintext(values));
+    Plaintext result;
+    cc->Decrypt(keys[0].secretKey, cc->EvalRotate(cc->EvalMult(ciphertext, ciphertext), 1), &result);
+    result->SetLength(3);
+    EXPECT_TRUE(checkEquality(std::vector<double>{0.25, 0.0625, 4.0}, result->GetRealPackedValue(), 0.0001));
+
+    // keys inserted through the static functions go to the store of their context
+    const auto multKeys = storeA.GetEvalMultKeyVector(tagA);
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys(cc);
+    EXPECT_THROW(cc->EvalMult(ciphertext, ciphertext), OpenFHEException);
+    CryptoContextImpl<DCRTPoly>::InsertEvalMultKey(multKeys);
+    EXPECT_NO_THROW(cc->EvalMult(ciphertext, ciphertext));
+    EXPECT_EQ(shared.GetEvalMultKeys()->count(tagA), 0u);
+
+    // evicting tenant A releases its keys and leaves tenant B alone
+    const size_t sizeB = storeB.GetByteSize();
+    EXPECT_TRUE(storeA.Evict(tagA));
+    EXPECT_EQ(storeA.GetByteSize(), 0u);
+    EXPECT_EQ(storeB.GetByteSize(), sizeB);
+    EXPECT_THROW(cc->EvalRotate(ciphertext, 1), OpenFHEException);
+    storeB.Clear();
+}
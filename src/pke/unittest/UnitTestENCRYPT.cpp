@@ -33,6 +33,7 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "utils/exception.h"
+#include "wire-ser.h"
 
 #include "include/gtest/gtest.h"
 #include <iostream>
@@ -45,6 +46,7 @@ using namespace lbcrypto;
 enum TEST_CASE_TYPE {
     STRING_TEST = 0,
     COEF_PACKED_TEST,
+    SEEDED_ENCRYPT_TEST,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -56,6 +58,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case COEF_PACKED_TEST:
             typeName = "COEF_PACKED_TEST";
             break;
+        case SEEDED_ENCRYPT_TEST:
+            typeName = "SEEDED_ENCRYPT_TEST";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -133,6 +138,14 @@ static std::vector<TEST_CASE_UTGENERAL_ENCRYPT_DECRYPT> testCases = {
     { COEF_PACKED_TEST, "14", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   UNIFORM_TERNARY, DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    512,   DFLT,   DFLT,      DFLT, BEHZ,             EXTENDED, DFLT} },
     { COEF_PACKED_TEST, "15", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   GAUSSIAN,        DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    512,   DFLT,   DFLT,      DFLT, HPSPOVERQ,        EXTENDED, DFLT} },
     { COEF_PACKED_TEST, "16", {BFVRNS_SCHEME, DFLT, DFLT,      DFLT,     20,       BATCH,   GAUSSIAN,        DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    512,   DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, EXTENDED, DFLT} },
+    // ==========================================
+    // TestType,          Descr, Scheme,          RDim, MultDepth, SModSize, DSize,    BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,         EncTech,  PREMode
+    { SEEDED_ENCRYPT_TEST, "01", {CKKSRNS_SCHEME, 256,  2,         50,       BV_DSIZE, BATCH,   UNIFORM_TERNARY, DFLT,          60,       HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,             DFLT,     DFLT} },
+    { SEEDED_ENCRYPT_TEST, "02", {CKKSRNS_SCHEME, 256,  2,         50,       BV_DSIZE, BATCH,   UNIFORM_TERNARY, DFLT,          60,       HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,             DFLT,     DFLT} },
+    { SEEDED_ENCRYPT_TEST, "03", {BGVRNS_SCHEME,  256,  2,         DFLT,     BV_DSIZE, BATCH,   UNIFORM_TERNARY, 1,             DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    65537, DFLT,   DFLT,      DFLT, DFLT,             STANDARD, DFLT} },
+    { SEEDED_ENCRYPT_TEST, "04", {BGVRNS_SCHEME,  256,  2,         DFLT,     BV_DSIZE, BATCH,   GAUSSIAN,        1,             60,       HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    65537, DFLT,   DFLT,      DFLT, DFLT,             STANDARD, DFLT} },
+    { SEEDED_ENCRYPT_TEST, "05", {BFVRNS_SCHEME,  DFLT, DFLT,      DFLT,     20,       BATCH,   UNIFORM_TERNARY, DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    65537, DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, STANDARD, DFLT} },
+    { SEEDED_ENCRYPT_TEST, "06", {BFVRNS_SCHEME,  DFLT, DFLT,      DFLT,     20,       BATCH,   UNIFORM_TERNARY, DFLT,          DFLT,     DFLT,         BV,     FIXEDMANUAL,     DFLT,    65537, DFLT,   DFLT,      DFLT, HPSPOVERQLEVELED, EXTENDED, DFLT} },
 };
 // clang-format on
 //===========================================================================================================
@@ -224,6 +237,89 @@ protected:
             UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
         }
     }
+
+    void EncryptionSeeded(const TEST_CASE_UTGENERAL_ENCRYPT_DECRYPT& testData,
+                          const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            cc->SetSeededEncryption(true);
+            EXPECT_TRUE(cc->GetSeededEncryption()) << failmsg;
+
+            const bool isCKKS = (testData.params.schemeId == CKKSRNS_SCHEME);
+            // c1 of the EXTENDED encryption technique is not uniform, so it cannot be seeded
+            const bool expectSeeded = (testData.params.encryptionTechnique != EXTENDED);
+
+            std::vector<int64_t> intvec = {1, 2, 3, 4, 5, 6, 7, 8};
+            std::vector<double> realvec = {0.25, 0.5, 0.75, 1.0, -1.0, -0.75, -0.5, -0.25};
+
+            Plaintext plaintext = isCKKS ? cc->MakeCKKSPackedPlaintext(realvec) : cc->MakePackedPlaintext(intvec);
+
+            KeyPair<Element> kp = cc->KeyGen();
+            EXPECT_EQ(kp.good(), true) << failmsg << " key generation for seeded encrypt/decrypt failed";
+
+            Ciphertext<Element> ciphertext = cc->Encrypt(kp.secretKey, plaintext);
+            EXPECT_EQ(ciphertext->IsSeeded(), expectSeeded) << failmsg << " wrong seeded state after encryption";
+            EXPECT_EQ(ciphertext->NumberCiphertextElements(), 2u) << failmsg;
+
+            std::vector<uint32_t> seed;
+            EXPECT_EQ(ciphertext->GetStoredElements(seed).size(), expectSeeded ? 1u : 2u) << failmsg;
+            EXPECT_EQ(seed.empty(), !expectSeeded) << failmsg;
+
+            // copies keep the seed, and the wire format writes the seed instead of c1
+            auto copy = std::make_shared<CiphertextImpl<Element>>(*ciphertext);
+            EXPECT_EQ(copy->IsSeeded(), expectSeeded) << failmsg << " copy does not keep the seed";
+
+            std::vector<char> buffer(Wire::GetSerializedSize(ciphertext));
+            Wire::SerializeToBuffer(ciphertext, Wire::ByteSpan{buffer.data(), buffer.size()});
+            Ciphertext<Element> received;
+            Wire::DeserializeFromBuffer(received, Wire::ByteSpan{buffer.data(), buffer.size()}, cc);
+            EXPECT_EQ(received->IsSeeded(), expectSeeded) << failmsg << " wire format does not keep the seed";
+
+            // the first access expands c1; every copy expands the same element
+            const size_t seededBytes = Wire::GetSerializedSize(ciphertext);
+            EXPECT_EQ(ciphertext->GetElements().size(), 2u) << failmsg;
+            EXPECT_FALSE(ciphertext->IsSeeded()) << failmsg << " c1 is not expanded on first use";
+            if (expectSeeded) {
+                EXPECT_LT(seededBytes, 0.6 * Wire::GetSerializedSize(ciphertext))
+                    << failmsg << " seeded ciphertext is not smaller";
+            }
+            EXPECT_TRUE(copy->GetElements() == ciphertext->GetElements()) << failmsg << " expanded c1 differs";
+            EXPECT_TRUE(received->GetElements() == ciphertext->GetElements()) << failmsg << " expanded c1 differs";
+
+            Ciphertext<Element> ciphertextSum = cc->EvalAdd(received, cc->Encrypt(kp.secretKey, plaintext));
+            Plaintext plaintextNew;
+            Plaintext plaintextSum;
+            cc->Decrypt(kp.secretKey, copy, &plaintextNew);
+            cc->Decrypt(kp.secretKey, ciphertextSum, &plaintextSum);
+            plaintextNew->SetLength(intvec.size());
+            plaintextSum->SetLength(intvec.size());
+            if (isCKKS) {
+                std::vector<double> realvecSum;
+                for (auto v : realvec)
+                    realvecSum.push_back(2 * v);
+                checkEquality(realvec, plaintextNew->GetRealPackedValue(), 1e-5,
+                              failmsg + " seeded encrypt/decrypt failed");
+                checkEquality(realvecSum, plaintextSum->GetRealPackedValue(), 1e-5,
+                              failmsg + " addition of seeded ciphertexts failed");
+            }
+            else {
+                std::vector<int64_t> intvecSum;
+                for (auto v : intvec)
+                    intvecSum.push_back(2 * v);
+                EXPECT_EQ(intvec, plaintextNew->GetPackedValue()) << failmsg << " seeded encrypt/decrypt failed";
+                EXPECT_EQ(intvecSum, plaintextSum->GetPackedValue())
+                    << failmsg << " addition of seeded ciphertexts failed";
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTGENERAL_ENCRYPT_DECRYPT, ENCRYPT) {
@@ -233,6 +329,8 @@ TEST_P(UTGENERAL_ENCRYPT_DECRYPT, ENCRYPT) {
         EncryptionString(test, test.buildTestName());
     else if (test.testCaseType == COEF_PACKED_TEST)
         EncryptionCoefPacked(test, test.buildTestName());
+    else if (test.testCaseType == SEEDED_ENCRYPT_TEST)
+        EncryptionSeeded(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTGENERAL_ENCRYPT_DECRYPT, ::testing::ValuesIn(testCases), testName);
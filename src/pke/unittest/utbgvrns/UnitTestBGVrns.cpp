@@ -33,8 +33,11 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "UnitTestMetadataTest.h"
+#include "wire-ser.h"
 
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -898,6 +901,18 @@ protected:
             cc->Decrypt(kp.secretKey, ctCompressed, &resultCompressed);
             checkEquality(result->GetPackedValue(), resultCompressed->GetPackedValue(), eps,
                           failmsg + " compress fails");
+
+            // the compact transport format keeps the decryption exact
+            auto ctTransport = cc->CompressForTransport(ct);
+            EXPECT_EQ(ctTransport->GetElements()[0].GetNumOfElements(), targetTowers) << failmsg;
+            std::stringstream stream;
+            Wire::SerializeCompact(ctTransport, stream);
+            std::string serialized = stream.str();
+            Ciphertext<Element> ctReceived;
+            Wire::DeserializeCompact(ctReceived, Wire::ByteSpan{&serialized[0], serialized.size()}, cc);
+            cc->Decrypt(kp.secretKey, ctReceived, &resultCompressed);
+            checkEquality(result->GetPackedValue(), resultCompressed->GetPackedValue(), eps,
+                          failmsg + " compact transport fails");
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
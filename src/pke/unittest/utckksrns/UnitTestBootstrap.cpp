@@ -40,6 +40,7 @@
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 
+#include <filesystem>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -56,6 +57,12 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
     BOOTSTRAP_SERIALIZE,
+    BOOTSTRAP_DEFER_MODDOWN,
+    BOOTSTRAP_PRECOM_CACHE,
+    BOOTSTRAP_MEMORY_BOUND,
+    BOOTSTRAP_SPARSE_ENCAPSULATED,
+    BOOTSTRAP_SEEDED_KEYS,
+    BOOTSTRAP_BATCH,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -82,6 +89,24 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_SERIALIZE:
             typeName = "BOOTSTRAP_SERIALIZE";
             break;
+        case BOOTSTRAP_DEFER_MODDOWN:
+            typeName = "BOOTSTRAP_DEFER_MODDOWN";
+            break;
+        case BOOTSTRAP_PRECOM_CACHE:
+            typeName = "BOOTSTRAP_PRECOM_CACHE";
+            break;
+        case BOOTSTRAP_MEMORY_BOUND:
+            typeName = "BOOTSTRAP_MEMORY_BOUND";
+            break;
+        case BOOTSTRAP_SPARSE_ENCAPSULATED:
+            typeName = "BOOTSTRAP_SPARSE_ENCAPSULATED";
+            break;
+        case BOOTSTRAP_SEEDED_KEYS:
+            typeName = "BOOTSTRAP_SEEDED_KEYS";
+            break;
+        case BOOTSTRAP_BATCH:
+            typeName = "BOOTSTRAP_BATCH";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -244,6 +269,12 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SPARSE, "46", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, 1 },
 #endif
 
+    // ==========================================
+    // TestType,               Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_DEFER_MODDOWN, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_DEFER_MODDOWN, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 },   8 },
+    { BOOTSTRAP_DEFER_MODDOWN, "03", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 },   RDIM/2 },
+    { BOOTSTRAP_DEFER_MODDOWN, "04", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/4 },
     // ==========================================
     // TestType,            Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1
     { BOOTSTRAP_KEY_SWITCH, "01", {CKKSRNS_SCHEME,  2048, MULT_DEPTH, SMODSIZE,     DFLT,  8,       SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 } },
@@ -311,6 +342,41 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SERIALIZE, "05", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     { BOOTSTRAP_SERIALIZE, "06", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     // ==========================================
+    // TestType,              Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_PRECOM_CACHE, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_PRECOM_CACHE, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 },   8 },
+    { BOOTSTRAP_PRECOM_CACHE, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_PRECOM_CACHE, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/4 },
+#endif
+    // ==========================================
+    // TestType,              Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_MEMORY_BOUND, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_MEMORY_BOUND, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 },   8 },
+    { BOOTSTRAP_MEMORY_BOUND, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+    { BOOTSTRAP_MEMORY_BOUND, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/4 },
+    // ==========================================
+    // TestType,                     Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,          MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_SPARSE_ENCAPSULATED, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_SPARSE_ENCAPSULATED, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 },   8 },
+    { BOOTSTRAP_SPARSE_ENCAPSULATED, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_SPARSE_ENCAPSULATED, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/4 },
+#endif
+    // ==========================================
+    // TestType,             Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,          MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_SEEDED_KEYS, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY,     DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_SEEDED_KEYS, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_SEEDED_KEYS, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+    // ==========================================
+    // TestType,       Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_BATCH, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_BATCH, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/4 },
+    { BOOTSTRAP_BATCH, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 },   RDIM/2 },
+#if NATIVEINT != 128
+    { BOOTSTRAP_BATCH, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/4 },
+#endif
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -349,8 +415,14 @@ protected:
     void UnitTest_Bootstrap(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
         try {
             CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            if (testData.testCaseType == BOOTSTRAP_SEEDED_KEYS)
+                cc->SetSeededEvalKeys(true);
 
-            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            bool deferModDown = (testData.testCaseType == BOOTSTRAP_DEFER_MODDOWN);
+            // a bound of one byte keeps every level as diagonals, so all plaintexts are encoded during bootstrapping
+            uint64_t maxPlaintextBytes = (testData.testCaseType == BOOTSTRAP_MEMORY_BOUND) ? 1 : 0;
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, 0, true, deferModDown,
+                                   maxPlaintextBytes);
 
             auto keyPair = cc->KeyGen();
             cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
@@ -701,6 +773,120 @@ protected:
             UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
         }
     }
+
+    void UnitTest_Bootstrap_PrecomCache(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                        const std::string& failmsg = std::string()) {
+        const std::string cacheDir{"UnitTestBootstrapCache_" + testData.description};
+        try {
+            std::filesystem::create_directories(cacheDir);
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            // the first worker computes the plaintexts and writes them to the cache
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, 0, false);
+            EXPECT_FALSE(cc->LoadBootstrapPrecomputation(cacheDir, testData.slots))
+                << failmsg << " Cache hit in an empty directory";
+            cc->EvalBootstrapPrecompute(testData.slots);
+            cc->WriteBootstrapPrecomputation(cacheDir, testData.slots);
+
+            // another number of slots is a cache miss
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots / 2, 0, false);
+            EXPECT_FALSE(cc->LoadBootstrapPrecomputation(cacheDir, testData.slots / 2))
+                << failmsg << " Cache hit for another number of slots";
+
+            // later workers load the plaintexts instead of computing them
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, 0, false);
+            ASSERT_TRUE(cc->LoadBootstrapPrecomputation(cacheDir, testData.slots)) << failmsg << " Cache miss";
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input(
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots));
+            size_t encodedLength = input.size();
+
+            Plaintext plaintext  = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext      = cc->Encrypt(keyPair.publicKey, plaintext);
+            auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+
+            Plaintext result;
+            cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+            result->SetLength(encodedLength);
+            plaintext->SetLength(encodedLength);
+            checkEquality(result->GetCKKSPackedValue(), plaintext->GetCKKSPackedValue(), eps,
+                          failmsg + " Bootstrapping with cached precomputations fails");
+
+            std::filesystem::remove_all(cacheDir);
+        }
+        catch (std::exception& e) {
+            std::filesystem::remove_all(cacheDir);
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            std::filesystem::remove_all(cacheDir);
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+    void UnitTest_Bootstrap_Batch(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                  const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            // three ciphertexts are padded to four, so each one has a quarter of the bootstrapped slots
+            const uint32_t numCiphertexts = 3;
+            const uint32_t batchSlots     = testData.slots / 4;
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots, batchSlots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::vector<std::complex<double>>> inputs;
+            std::vector<Ciphertext<Element>> ciphertexts;
+            for (uint32_t i = 0; i < numCiphertexts; ++i) {
+                double shift = 0.05 * i;
+                inputs.push_back(Fill({0.111111 + shift, -0.222222, 0.333333 - shift, 0.444444, -0.555555 + shift,
+                                       0.666666, 0.777777 - shift, -0.888888},
+                                      batchSlots));
+                Plaintext plaintext = cc->MakeCKKSPackedPlaintext(inputs[i], 1, MULT_DEPTH - 1, nullptr, batchSlots);
+                ciphertexts.push_back(cc->Encrypt(keyPair.publicKey, plaintext));
+            }
+
+            auto ciphertextsAfter = cc->EvalBootstrapBatch(ciphertexts);
+            ASSERT_EQ(ciphertextsAfter.size(), numCiphertexts) << failmsg;
+
+            for (uint32_t i = 0; i < numCiphertexts; ++i) {
+                EXPECT_EQ(ciphertextsAfter[i]->GetSlots(), batchSlots) << failmsg;
+
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, ciphertextsAfter[i], &result);
+                result->SetLength(batchSlots);
+                checkEquality(result->GetCKKSPackedValue(), inputs[i], eps,
+                              failmsg + " Batch bootstrapping fails for ciphertext " + std::to_string(i));
+
+                // the unpacked ciphertexts are regular ciphertexts with batchSlots slots
+                auto ciphertextSquared = cc->EvalMult(ciphertextsAfter[i], ciphertextsAfter[i]);
+                std::vector<std::complex<double>> squared(inputs[i].size());
+                std::transform(inputs[i].begin(), inputs[i].end(), squared.begin(),
+                               [](const std::complex<double>& x) { return x * x; });
+                cc->Decrypt(keyPair.secretKey, ciphertextSquared, &result);
+                result->SetLength(batchSlots);
+                checkEquality(result->GetCKKSPackedValue(), squared, eps,
+                              failmsg + " EvalMult after batch bootstrapping fails for ciphertext " +
+                                  std::to_string(i));
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 
 //===========================================================================================================
@@ -712,6 +898,10 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_FULL:
         case BOOTSTRAP_EDGE:
         case BOOTSTRAP_SPARSE:
+        case BOOTSTRAP_DEFER_MODDOWN:
+        case BOOTSTRAP_MEMORY_BOUND:
+        case BOOTSTRAP_SPARSE_ENCAPSULATED:
+        case BOOTSTRAP_SEEDED_KEYS:
             UnitTest_Bootstrap(test, test.buildTestName());
             break;
         case BOOTSTRAP_KEY_SWITCH:
@@ -726,6 +916,12 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_SERIALIZE:
             UnitTest_Bootstrap_Serialize(test, test.buildTestName());
             break;
+        case BOOTSTRAP_PRECOM_CACHE:
+            UnitTest_Bootstrap_PrecomCache(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_BATCH:
+            UnitTest_Bootstrap_Batch(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -37,6 +37,7 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "UnitTestMetadataTest.h"
+#include "key/evalkeyrelin.h"
 
 #include <iostream>
 #include <vector>
@@ -63,6 +64,7 @@ enum TEST_CASE_TYPE {
     MULT_PACKED_PRECISION,
     EVALSQUARE,
     SMALL_SCALING_MOD_SIZE,
+    SEEDED_EVAL_KEYS,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -116,6 +118,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case SMALL_SCALING_MOD_SIZE:
             typeName = "SMALL_SCALING_MOD_SIZE";
             break;
+        case SEEDED_EVAL_KEYS:
+            typeName = "SEEDED_EVAL_KEYS";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -518,6 +523,16 @@ static std::vector<TEST_CASE_UTCKKSRNS> testCases = {
     { EVALSQUARE, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVALSQUARE, "07", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
     { EVALSQUARE, "08", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,        Descr, Scheme,         RDim, MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
+    { SEEDED_EVAL_KEYS, "01", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { SEEDED_EVAL_KEYS, "02", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { SEEDED_EVAL_KEYS, "03", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { SEEDED_EVAL_KEYS, "04", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+#if NATIVEINT != 128
+    { SEEDED_EVAL_KEYS, "05", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
+    { SEEDED_EVAL_KEYS, "06", {CKKSRNS_SCHEME, RING_DIM, 7,     DFLT,     DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT}, },
 #endif
     // ==========================================
     // TestType,              Descr, Scheme,        RDim,   MultDepth, SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,    LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode
@@ -1484,6 +1499,39 @@ protected:
             results->SetLength(plaintextRight2->GetLength());
             checkEquality(plaintextRight2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
                           failmsg + " EvalFastRotation(-2) fails");
+
+            /* Testing EvalRotateMany with a shared precomputation
+             */
+            auto cRotations = cc->EvalRotateMany(ciphertext1, {2, -2});
+            cc->Decrypt(kp.secretKey, cRotations[0], &results);
+            results->SetLength(plaintextLeft2->GetLength());
+            checkEquality(plaintextLeft2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(+2) fails");
+            cc->Decrypt(kp.secretKey, cRotations[1], &results);
+            results->SetLength(plaintextRight2->GetLength());
+            checkEquality(plaintextRight2->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotateMany(-2) fails");
+
+            /* Testing EvalRotateManyExt: the rotations are summed in the extended basis
+             * and scaled down once
+             */
+            if (testData.params.ksTech == HYBRID) {
+                auto cRotationsExt = cc->EvalRotateManyExt(ciphertext1, {0, 2, -2});
+                auto cSumExt       = cc->EvalAddExt(cRotationsExt[0], cRotationsExt[1]);
+                cc->EvalAddExtInPlace(cSumExt, cRotationsExt[2]);
+                Ciphertext<Element> cSum = cc->KeySwitchDown(cSumExt);
+
+                std::vector<std::complex<double>> vSum(slots);
+                for (uint32_t i = 0; i < slots; i++) {
+                    vSum[i] = vectorOfInts1[i] + vIntsLeftRotate2[i] + vIntsRightRotate2[i];
+                }
+                Plaintext plaintextSum = cc->MakeCKKSPackedPlaintext(vSum, 1, 0, nullptr, testData.slots);
+
+                cc->Decrypt(kp.secretKey, cSum, &results);
+                results->SetLength(plaintextSum->GetLength());
+                checkEquality(plaintextSum->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                              failmsg + " EvalRotateManyExt sum fails");
+            }
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
@@ -2065,6 +2113,66 @@ protected:
         }
     }
 
+    void UnitTest_SeededEvalKeys(const TEST_CASE_UTCKKSRNS& testData, const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+            cc->SetSeededEvalKeys(true);
+
+            const std::vector<std::complex<double>> vectorOfInts = {1, 0, 3, 1, 0, 1, 2, 1};
+            Plaintext plaintext                                  = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+
+            const std::vector<std::complex<double>> vectorOfIntsSquare = {1, 0, 9, 1, 0, 1, 4, 1};
+            Plaintext intArrayExpectedSquare = cc->MakeCKKSPackedPlaintext(vectorOfIntsSquare);
+
+            // the square rotated left by 2
+            const std::vector<std::complex<double>> vectorOfIntsRotated = {9, 1, 0, 1, 4, 1, 1, 0};
+            Plaintext intArrayExpectedRotated = cc->MakeCKKSPackedPlaintext(vectorOfIntsRotated);
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+            cc->EvalAtIndexKeyGen(kp.secretKey, {2});
+
+            const auto multKey = cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0];
+            EXPECT_TRUE(multKey->IsSeeded()) << failmsg << " relinearization key is not seeded";
+            for (const auto& key : cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag()))
+                EXPECT_TRUE(key.second->IsSeeded()) << failmsg << " rotation key is not seeded";
+
+            Ciphertext<Element> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+
+            Plaintext results;
+            Ciphertext<Element> ciphertextSq = cc->EvalSquare(ciphertext);
+            cc->Decrypt(kp.secretKey, ciphertextSq, &results);
+            results->SetLength(intArrayExpectedSquare->GetLength());
+            checkEquality(intArrayExpectedSquare->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalSquare with a seeded key fails");
+
+            Ciphertext<Element> ciphertextRot = cc->EvalRotate(ciphertextSq, 2);
+            cc->Decrypt(kp.secretKey, ciphertextRot, &results);
+            results->SetLength(intArrayExpectedRotated->GetLength());
+            checkEquality(intArrayExpectedRotated->GetCKKSPackedValue(), results->GetCKKSPackedValue(), eps,
+                          failmsg + " EvalRotate with a seeded key fails");
+
+            // key switching with the seeded key matches key switching with the same key holding the expanded vector A
+            EvalKey<Element> fullKey = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
+            fullKey->SetAVector(multKey->GetAVector());
+            fullKey->SetBVector(multKey->GetBVector());
+            fullKey->SetKeyTag(multKey->GetKeyTag());
+            EXPECT_FALSE(fullKey->IsSeeded()) << failmsg;
+            Ciphertext<Element> ciphertextSeeded = cc->KeySwitch(ciphertext, multKey);
+            Ciphertext<Element> ciphertextFull   = cc->KeySwitch(ciphertext, fullKey);
+            EXPECT_TRUE(ciphertextSeeded->GetElements() == ciphertextFull->GetElements())
+                << failmsg << " key switching with a seeded key differs";
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
     void UnitTest_Small_ScalingModSize(const TEST_CASE_UTCKKSRNS& testData,
                                        const std::string& failmsg = std::string()) {
         try {
@@ -2160,6 +2268,9 @@ TEST_P(UTCKKSRNS, CKKSRNS) {
         case SMALL_SCALING_MOD_SIZE:
             UnitTest_Small_ScalingModSize(test, test.buildTestName());
             break;
+        case SEEDED_EVAL_KEYS:
+            UnitTest_SeededEvalKeys(test, test.buildTestName());
+            break;
         default:
             break;
     }
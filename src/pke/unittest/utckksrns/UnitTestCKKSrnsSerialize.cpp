@@ -34,7 +34,13 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -42,6 +48,9 @@
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 #include "globals.h"  // for SERIALIZE_PRECOMPUTE
+#include "key/evalkeystore.h"
+#include "math/seededuniformgenerator.h"
+#include "wire-ser.h"
 
 using namespace lbcrypto;
 
@@ -50,6 +59,10 @@ enum TEST_CASE_TYPE {
     CONTEXT_WITH_SERTYPE = 0,
     KEYS_AND_CIPHERTEXTS,
     NO_CRT_TABLES,
+    EVAL_KEY_STORE,
+    EVAL_KEY_STORE_STREAM,
+    WIRE_FORMAT,
+    COMPACT_TRANSPORT,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -64,6 +77,18 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case NO_CRT_TABLES:
             typeName = "NO_CRT_TABLES";
             break;
+        case EVAL_KEY_STORE:
+            typeName = "EVAL_KEY_STORE";
+            break;
+        case EVAL_KEY_STORE_STREAM:
+            typeName = "EVAL_KEY_STORE_STREAM";
+            break;
+        case WIRE_FORMAT:
+            typeName = "WIRE_FORMAT";
+            break;
+        case COMPACT_TRANSPORT:
+            typeName = "COMPACT_TRANSPORT";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -114,6 +139,7 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_UTCKKSRNS_SER&
 constexpr usint RING_DIM   = 32;
 constexpr usint SMODSIZE   = 50;
 constexpr usint MULT_DEPTH = 3;
+constexpr usint DEEP_DEPTH = 7;
 constexpr usint DSIZE      = 20;
 constexpr usint BATCH      = 16;
 // clang-format off
@@ -166,6 +192,25 @@ static std::vector<TEST_CASE_UTCKKSRNS_SER> testCases = {
     { NO_CRT_TABLES, "06", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
     { NO_CRT_TABLES, "07", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
     { NO_CRT_TABLES, "08", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#endif
+    // ==========================================
+    // TestType,     Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { EVAL_KEY_STORE, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { EVAL_KEY_STORE, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,            Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { EVAL_KEY_STORE_STREAM, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { EVAL_KEY_STORE_STREAM, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,  Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { WIRE_FORMAT, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { WIRE_FORMAT, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
+    // TestType,        Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { COMPACT_TRANSPORT, "01", {CKKSRNS_SCHEME, RING_DIM, DEEP_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { COMPACT_TRANSPORT, "02", {CKKSRNS_SCHEME, RING_DIM, DEEP_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+#if !defined(EMSCRIPTEN)
+    { COMPACT_TRANSPORT, "03", {CKKSRNS_SCHEME, RING_DIM, DEEP_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
 #endif
     // ==========================================
 };
@@ -455,6 +500,394 @@ protected:
         TestDecryptionSerNoCRTTables(testData, SerType::JSON, "json");
         TestDecryptionSerNoCRTTables(testData, SerType::BINARY, "binary");
     }
+
+    void UnitTestEvalKeyStore(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        const std::string path{"UnitTestEvalKeyStore.bin"};
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            const std::vector<int32_t> indices{1, 2, 3, -1, -2};
+            cc->EvalRotateKeyGen(kp.secretKey, indices);
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vals));
+
+            std::vector<Ciphertext<DCRTPoly>> expected;
+            for (int32_t index : indices)
+                expected.push_back(cc->EvalRotate(ciphertext, index));
+            const auto original = cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+
+            const uint32_t maxResident{2};
+            cc->WriteEvalAutomorphismKeyStore(path, kp.secretKey->GetKeyTag());
+            cc->LoadEvalAutomorphismKeyStore(path, maxResident);
+
+            const auto& keys = cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+            ASSERT_EQ(keys.size(), original.size()) << failmsg << " Key store holds a different number of keys";
+            for (const auto& [index, key] : keys) {
+                auto proxy = std::dynamic_pointer_cast<EvalKeyStoreProxy>(key);
+                ASSERT_TRUE(proxy) << failmsg << " Key " << index << " is not loaded from the key store";
+                EXPECT_FALSE(proxy->IsResident()) << failmsg << " Key " << index << " is loaded before use";
+            }
+
+            // rotations with lazily loaded keys match the rotations with the keys in memory
+            for (size_t i = 0; i < indices.size(); ++i) {
+                auto rotated = cc->EvalRotate(ciphertext, indices[i]);
+                EXPECT_EQ(*rotated, *expected[i]) << failmsg << " Rotation by " << indices[i] << " differs";
+
+                uint32_t resident{0};
+                for (const auto& [_, key] : keys)
+                    resident += std::dynamic_pointer_cast<EvalKeyStoreProxy>(key)->IsResident() ? 1 : 0;
+                EXPECT_LE(resident, maxResident) << failmsg << " More keys in memory than allowed";
+            }
+
+            for (const auto& [index, key] : original)
+                EXPECT_TRUE(*keys.at(index)->LoadResident() == *key) << failmsg << " Key " << index << " mismatch";
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            std::remove(path.c_str());
+        }
+        catch (std::exception& e) {
+            std::remove(path.c_str());
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            std::remove(path.c_str());
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTestEvalKeyStoreStream(const TEST_CASE_UTCKKSRNS_SER& testData,
+                                    const std::string& failmsg = std::string()) {
+        const std::string path{"UnitTestEvalKeyStoreStream.bin"};
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp       = cc->KeyGen();
+            const std::string& keyTag = kp.secretKey->GetKeyTag();
+            // 1 and 1 + BATCH rotate by the same number of slots and share a key
+            const std::vector<int32_t> indices{1, 2, 3, -1, -2, 1 + static_cast<int32_t>(BATCH)};
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+
+            // the keys are written to the store while they are generated, in batches of two
+            {
+                EvalKeyStoreWriter writer(path, keyTag);
+                cc->EvalRotateKeyGen(kp.secretKey, indices, writer, 2);
+                writer.Close();
+            }
+            EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys().count(keyTag), 0u)
+                << failmsg << " Streamed keys are added to the key map";
+
+            auto store = EvalKeyStore::Open(path);
+            ASSERT_EQ(store->GetEntries().size(), indices.size() - 1) << failmsg << " Wrong number of keys";
+
+            // keys read in parallel match the keys read one by one
+            auto keys = store->ReadKeys();
+            ASSERT_EQ(keys->size(), store->GetEntries().size()) << failmsg;
+            for (const auto& entry : store->GetEntries())
+                EXPECT_TRUE(*keys->at(entry.index) == *store->ReadKey(entry)) << failmsg << " Key mismatch";
+
+            // rotations with the streamed keys decrypt to the rotated values
+            const int32_t slots = static_cast<int32_t>(BATCH);
+            auto checkRotation  = [&](int32_t index) {
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, cc->EvalRotate(ciphertext, index), &result);
+                result->SetLength(vals.size());
+                std::vector<std::complex<double>> expected(vals.size());
+                for (int32_t i = 0; i < static_cast<int32_t>(vals.size()); ++i) {
+                    const int32_t j = (i + index % slots + slots) % slots;
+                    expected[i]     = j < static_cast<int32_t>(vals.size()) ? vals[j] : 0.0;
+                }
+                // BV key switching at this ring dimension leaves about 20 bits of precision
+                checkEquality(expected, result->GetCKKSPackedValue(), 1e-5,
+                              failmsg + " Rotation by " + std::to_string(index) + " failed");
+            };
+            cc->ReadEvalAutomorphismKeyStore(path);
+            EXPECT_EQ(cc->GetEvalAutomorphismKeyMap(keyTag).size(), store->GetEntries().size()) << failmsg;
+            for (int32_t index : indices)
+                checkRotation(index);
+
+            // a subset of the keys is read or loaded without the others
+            const std::vector<uint32_t> subset{cc->FindAutomorphismIndex(1), cc->FindAutomorphismIndex(-2)};
+            EXPECT_EQ(store->ReadKeys(subset)->size(), subset.size()) << failmsg;
+            EXPECT_THROW(store->ReadKeys({0}), OpenFHEException) << failmsg;
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            cc->ReadEvalAutomorphismKeyStore(path, subset);
+            EXPECT_EQ(cc->GetEvalAutomorphismKeyMap(keyTag).size(), subset.size()) << failmsg;
+            checkRotation(1);
+            checkRotation(-2);
+            EXPECT_THROW(cc->EvalRotate(ciphertext, 2), OpenFHEException) << failmsg;
+
+            cc->LoadEvalAutomorphismKeyStore(path, 0, subset);
+            const auto& loaded = cc->GetEvalAutomorphismKeyMap(keyTag);
+            EXPECT_EQ(loaded.size(), subset.size()) << failmsg;
+            for (const auto& [index, key] : loaded)
+                EXPECT_TRUE(std::dynamic_pointer_cast<EvalKeyStoreProxy>(key)) << failmsg << " Key " << index;
+            checkRotation(-2);
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            std::remove(path.c_str());
+        }
+        catch (std::exception& e) {
+            std::remove(path.c_str());
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            std::remove(path.c_str());
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTestWireFormat(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        const std::string path{"UnitTestWireFormat.bin"};
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+
+            // buffers starting at a multiple of WIRE_ALIGNMENT, so that objects can be deserialized in place
+            auto makeBuffer = [](size_t size, std::shared_ptr<std::vector<char>>& storage) {
+                storage         = std::make_shared<std::vector<char>>(size + Wire::WIRE_ALIGNMENT);
+                const auto skew = reinterpret_cast<uintptr_t>(storage->data()) % Wire::WIRE_ALIGNMENT;
+                return Wire::ByteSpan{storage->data() + (Wire::WIRE_ALIGNMENT - skew) % Wire::WIRE_ALIGNMENT, size};
+            };
+
+            // ciphertext copied out of the buffer and placed in it
+            std::shared_ptr<std::vector<char>> storage;
+            auto buffer = makeBuffer(Wire::GetSerializedSize(ciphertext), storage);
+            EXPECT_EQ(Wire::SerializeToBuffer(ciphertext, buffer), buffer.size) << failmsg;
+            EXPECT_EQ(buffer.size % Wire::WIRE_ALIGNMENT, 0u) << failmsg;
+
+            Ciphertext<DCRTPoly> copied;
+            Wire::DeserializeFromBuffer(copied, buffer, cc);
+            EXPECT_EQ(*copied, *ciphertext) << failmsg << " Copied ciphertext mismatch";
+
+            Ciphertext<DCRTPoly> wrapped;
+            Wire::DeserializeFromBuffer(wrapped, buffer, cc, storage);
+            EXPECT_EQ(*wrapped, *ciphertext) << failmsg << " Wrapped ciphertext mismatch";
+            const void* tower = &wrapped->GetElements()[0].GetElementAtIndex(0).GetValues()[0];
+            EXPECT_TRUE(tower >= buffer.data && tower < buffer.data + buffer.size)
+                << failmsg << " Wrapped ciphertext is not placed in the buffer";
+            const void* copiedTower = &copied->GetElements()[0].GetElementAtIndex(0).GetValues()[0];
+            EXPECT_FALSE(copiedTower >= buffer.data && copiedTower < buffer.data + buffer.size)
+                << failmsg << " Copied ciphertext is placed in the buffer";
+
+            // the wrapped ciphertext keeps the buffer alive, and operations on it match the original
+            storage.reset();
+            Plaintext decrypted;
+            cc->Decrypt(kp.secretKey, wrapped, &decrypted);
+            decrypted->SetLength(vals.size());
+            checkEquality(plaintext->GetCKKSPackedValue(), decrypted->GetCKKSPackedValue(), eps,
+                          failmsg + " Decryption of the wrapped ciphertext failed");
+            EXPECT_EQ(*cc->EvalMult(wrapped, wrapped), *cc->EvalMult(ciphertext, ciphertext))
+                << failmsg << " Multiplication of the wrapped ciphertext differs";
+            cc->EvalAddInPlace(wrapped, ciphertext);
+            EXPECT_EQ(*wrapped, *cc->EvalAdd(ciphertext, ciphertext))
+                << failmsg << " In-place addition of the wrapped ciphertext differs";
+
+            // stream and file
+            std::stringstream stream;
+            Wire::Serialize(ciphertext, stream);
+            std::string serialized = stream.str();
+            Ciphertext<DCRTPoly> fromStream;
+            Wire::DeserializeFromBuffer(fromStream, Wire::ByteSpan{&serialized[0], serialized.size()}, cc);
+            EXPECT_EQ(*fromStream, *ciphertext) << failmsg << " Ciphertext read from a stream mismatch";
+            {
+                std::ofstream file(path, std::ios::binary);
+                Wire::Serialize(ciphertext, file);
+            }
+            Ciphertext<DCRTPoly> fromFile;
+            Wire::DeserializeFromFile(fromFile, path, cc);
+            std::remove(path.c_str());
+            EXPECT_EQ(*fromFile, *ciphertext) << failmsg << " Ciphertext read from a file mismatch";
+
+            // plaintext
+            buffer = makeBuffer(Wire::GetSerializedSize(plaintext), storage);
+            Wire::SerializeToBuffer(plaintext, buffer);
+            Plaintext plaintextCopy;
+            Wire::DeserializeFromBuffer(plaintextCopy, buffer, cc, storage);
+            EXPECT_EQ(*cc->EvalMult(ciphertext, plaintextCopy), *cc->EvalMult(ciphertext, plaintext))
+                << failmsg << " Multiplication by the deserialized plaintext differs";
+
+            // public and private keys
+            buffer = makeBuffer(Wire::GetSerializedSize(kp.publicKey), storage);
+            Wire::SerializeToBuffer(kp.publicKey, buffer);
+            PublicKey<DCRTPoly> publicKey;
+            Wire::DeserializeFromBuffer(publicKey, buffer, cc, storage);
+            EXPECT_EQ(publicKey->GetKeyTag(), kp.publicKey->GetKeyTag()) << failmsg;
+
+            buffer = makeBuffer(Wire::GetSerializedSize(kp.secretKey), storage);
+            Wire::SerializeToBuffer(kp.secretKey, buffer);
+            PrivateKey<DCRTPoly> secretKey;
+            Wire::DeserializeFromBuffer(secretKey, buffer, cc);
+            EXPECT_EQ(secretKey->GetKeyTag(), kp.secretKey->GetKeyTag()) << failmsg;
+
+            cc->Decrypt(secretKey, cc->Encrypt(publicKey, plaintext), &decrypted);
+            decrypted->SetLength(vals.size());
+            checkEquality(plaintext->GetCKKSPackedValue(), decrypted->GetCKKSPackedValue(), eps,
+                          failmsg + " Decryption with the deserialized keys failed");
+
+            // full and seeded relinearization keys
+            for (bool seeded : {false, true}) {
+                CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+                cc->SetSeededEvalKeys(seeded);
+                cc->EvalMultKeyGen(kp.secretKey);
+                const auto evalKey = cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0];
+
+                buffer = makeBuffer(Wire::GetSerializedSize(evalKey), storage);
+                Wire::SerializeToBuffer(evalKey, buffer);
+                EvalKey<DCRTPoly> evalKeyCopy;
+                Wire::DeserializeFromBuffer(evalKeyCopy, buffer, cc, storage);
+                EXPECT_EQ(evalKeyCopy->IsSeeded(), seeded) << failmsg;
+                EXPECT_TRUE(*evalKeyCopy == *evalKey) << failmsg << " Relinearization key mismatch, seeded " << seeded;
+            }
+            cc->SetSeededEvalKeys(false);
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+
+            // a buffer holding another type of object or a corrupted header is rejected
+            buffer = makeBuffer(Wire::GetSerializedSize(ciphertext), storage);
+            Wire::SerializeToBuffer(ciphertext, buffer);
+            EXPECT_THROW(Wire::DeserializeFromBuffer(publicKey, buffer, cc), OpenFHEException) << failmsg;
+            EXPECT_THROW(Wire::DeserializeFromBuffer(copied, Wire::ByteSpan{buffer.data, buffer.size / 2}, cc),
+                         OpenFHEException)
+                << failmsg;
+            // a total size smaller than the header, which has to be rejected before any field is read past it
+            const size_t totalBytesOffset = sizeof(uint64_t) + 4 * sizeof(uint32_t);
+            for (uint64_t totalBytes : {uint64_t(8), uint64_t(totalBytesOffset)}) {
+                Wire::SerializeToBuffer(ciphertext, buffer);
+                std::memcpy(buffer.data + totalBytesOffset, &totalBytes, sizeof(totalBytes));
+                EXPECT_THROW(Wire::DeserializeFromBuffer(copied, buffer, cc), OpenFHEException)
+                    << failmsg << " Total size " << totalBytes;
+            }
+            // a seed count other than 0 or a full seed, which has to be rejected before the seed is allocated
+            const size_t seedOffset = Wire::WIRE_ALIGNMENT + sizeof(uint32_t) + ciphertext->GetKeyTag().size() +
+                                      sizeof(uint32_t) + 3 * sizeof(uint64_t) + sizeof(double) +
+                                      sizeof(NativeInteger) + sizeof(uint64_t);
+            uint32_t storedSeedWords = 0;
+            Wire::SerializeToBuffer(ciphertext, buffer);
+            std::memcpy(&storedSeedWords, buffer.data + seedOffset, sizeof(storedSeedWords));
+            ASSERT_EQ(storedSeedWords, ciphertext->IsSeeded() ? SeededUniformGenerator::SEED_WORDS : 0U) << failmsg;
+            for (uint32_t seedWords : {uint32_t(1), ~uint32_t(0)}) {
+                Wire::SerializeToBuffer(ciphertext, buffer);
+                std::memcpy(buffer.data + seedOffset, &seedWords, sizeof(seedWords));
+                EXPECT_THROW(Wire::DeserializeFromBuffer(copied, buffer, cc), OpenFHEException)
+                    << failmsg << " Seed words " << seedWords;
+            }
+            // an element count larger than the rest of the buffer can hold, rejected before the elements are reserved
+            if (!ciphertext->IsSeeded()) {
+                const uint32_t numElements = ~uint32_t(0);
+                Wire::SerializeToBuffer(ciphertext, buffer);
+                std::memcpy(buffer.data + seedOffset + sizeof(uint32_t), &numElements, sizeof(numElements));
+                EXPECT_THROW(Wire::DeserializeFromBuffer(copied, buffer, cc), OpenFHEException) << failmsg;
+            }
+            Wire::SerializeToBuffer(ciphertext, buffer);
+            buffer.data[0] = 'X';
+            EXPECT_THROW(Wire::DeserializeFromBuffer(copied, buffer, cc), OpenFHEException) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::remove(path.c_str());
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            std::remove(path.c_str());
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
+
+    void UnitTestCompactTransport(const TEST_CASE_UTCKKSRNS_SER& testData,
+                                  const std::string& failmsg = std::string()) {
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+
+            std::vector<std::complex<double>> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+            Plaintext plaintext                    = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext        = cc->Encrypt(kp.publicKey, plaintext);
+            // a result that has not been rescaled yet
+            ciphertext = cc->EvalMult(ciphertext, ciphertext);
+
+            Plaintext expected;
+            cc->Decrypt(kp.secretKey, ciphertext, &expected);
+            expected->SetLength(vals.size());
+
+            for (uint32_t precisionBits : {0u, 20u}) {
+                std::string msg = failmsg + " precisionBits " + std::to_string(precisionBits);
+
+                Ciphertext<DCRTPoly> compressed = cc->CompressForTransport(ciphertext, precisionBits);
+                EXPECT_LT(compressed->GetElements()[0].GetNumOfElements(),
+                          ciphertext->GetElements()[0].GetNumOfElements())
+                    << msg << " No towers were dropped";
+
+                std::stringstream stream;
+                const size_t compactSize = Wire::SerializeCompact(compressed, stream);
+                std::string serialized   = stream.str();
+                const Wire::ByteSpan span{&serialized[0], serialized.size()};
+                EXPECT_EQ(compactSize, serialized.size()) << msg;
+                EXPECT_EQ(compactSize, Wire::GetCompactSize(compressed)) << msg;
+                if (precisionBits > 0)
+                    EXPECT_GE(Wire::GetSerializedSize(ciphertext), 5 * compactSize)
+                        << msg << " Compact ciphertext is not 5x smaller";
+
+                Ciphertext<DCRTPoly> received;
+                Wire::DeserializeCompact(received, span, cc);
+                EXPECT_EQ(*received, *compressed) << msg << " Compact ciphertext mismatch";
+
+                Plaintext decrypted;
+                cc->Decrypt(kp.secretKey, received, &decrypted);
+                decrypted->SetLength(vals.size());
+                const double tolerance = (precisionBits > 0) ? std::pow(2.0, -static_cast<double>(precisionBits)) : eps;
+                checkEquality(expected->GetCKKSPackedValue(), decrypted->GetCKKSPackedValue(), tolerance,
+                              msg + " Decryption of the compact ciphertext failed");
+
+                // a compact ciphertext cannot be read as another type of object
+                EXPECT_THROW(Wire::DeserializeFromBuffer(received, span, cc), OpenFHEException) << msg;
+
+                // an element count of 0 or above the maximum ciphertext size, rejected before anything is reserved
+                const size_t countOffset = Wire::WIRE_ALIGNMENT + sizeof(uint32_t) + compressed->GetKeyTag().size() +
+                                           sizeof(uint32_t) + 3 * sizeof(uint64_t) + sizeof(double) +
+                                           sizeof(NativeInteger) + sizeof(uint64_t);
+                uint32_t storedCount = 0;
+                std::memcpy(&storedCount, &serialized[countOffset], sizeof(storedCount));
+                ASSERT_EQ(storedCount, compressed->GetElements().size()) << msg;
+                for (uint32_t numElements : {uint32_t(0), ~uint32_t(0)}) {
+                    std::string corrupted = serialized;
+                    std::memcpy(&corrupted[countOffset], &numElements, sizeof(numElements));
+                    const Wire::ByteSpan corruptedSpan{&corrupted[0], corrupted.size()};
+                    EXPECT_THROW(Wire::DeserializeCompact(received, corruptedSpan, cc), OpenFHEException)
+                        << msg << " Element count " << numElements;
+                }
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            UNIT_TEST_HANDLE_ALL_EXCEPTIONS;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_SER, CKKSSer) {
@@ -467,6 +900,14 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
         UnitTestKeysAndCiphertexts(test, test.buildTestName());
     else if (test.testCaseType == NO_CRT_TABLES)
         UnitTestDecryptionSerNoCRTTables(test, test.buildTestName());
+    else if (test.testCaseType == EVAL_KEY_STORE)
+        UnitTestEvalKeyStore(test, test.buildTestName());
+    else if (test.testCaseType == EVAL_KEY_STORE_STREAM)
+        UnitTestEvalKeyStoreStream(test, test.buildTestName());
+    else if (test.testCaseType == WIRE_FORMAT)
+        UnitTestWireFormat(test, test.buildTestName());
+    else if (test.testCaseType == COMPACT_TRANSPORT)
+        UnitTestCompactTransport(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);